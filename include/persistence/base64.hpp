@@ -1,25 +1,18 @@
 #pragma once
 #include "bytes.hpp"
+#include "detail/base64_simd.hpp"
+#include "detail/endianness.hpp"
 #include "detail/unlikely.hpp"
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
 
 namespace persistence
 {
     namespace detail
     {
-        enum class endianness
-        {
-        #ifdef _WIN32
-            little = 0,
-            big    = 1,
-            native = little
-        #else
-            little = __ORDER_LITTLE_ENDIAN__,
-            big    = __ORDER_BIG_ENDIAN__,
-            native = __BYTE_ORDER__
-        #endif
-        };
-
         constexpr std::array<char, 64> encode_table {
             'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
             'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f',
@@ -84,6 +77,66 @@ namespace persistence
         }
     }
 
+    namespace detail
+    {
+        /** The number of characters in the Base64-encoded representation of a sequence of bytes. */
+        constexpr std::size_t base64_encoded_length(std::size_t size)
+        {
+            return (size + 2) / 3 * 4;
+        }
+
+        /**
+         * Writes the Base64-encoded representation of a raw sequence of bytes.
+         *
+         * Vector instructions encode as much of the input as possible, and scalar code encodes the rest.
+         *
+         * @param r A buffer of at least `base64_encoded_length(size)` characters.
+         */
+        inline void base64_encode(const std::byte* p, std::size_t size, char* r)
+        {
+            const std::size_t consumed = base64_encode_simd(p, size, r);
+            p += consumed;
+            r += consumed / 3 * 4;
+            size -= consumed;
+
+            std::size_t fast_sextets = size / 24 * 4;  // round to multiples of 8 bytes to ensure pointer stays in addressable range
+            std::size_t full_triplets = size / 3;
+            std::size_t remaining_triplets = full_triplets - fast_sextets * 2;
+            std::size_t remaining_bytes = size % 3;
+
+            // iterate over data with 64-bit words, processing full sextets
+            for (std::size_t i = 0; i < fast_sextets; ++i) {
+                uint64_t value = *reinterpret_cast<const uint64_t*>(p);
+                if constexpr (endianness::native == endianness::little) {
+                    encode_sextet_little_endian(value, r);
+                } else if constexpr (endianness::native == endianness::big) {
+                    encode_sextet_big_endian(value, r);
+                }
+                p += 6;
+                r += 8;
+            }
+
+            // process remaining full triplets (if any)
+            for (std::size_t i = 0; i < remaining_triplets; ++i) {
+                std::byte a = *p++;
+                std::byte b = *p++;
+                std::byte c = *p++;
+                encode_triplet(a, b, c, r);
+                r += 4;
+            }
+
+            // process remaining bytes (last incomplete triplet)
+            if (remaining_bytes == 2) {
+                encode_triplet(p[0], p[1], std::byte{0x00}, r);
+                r[3] = '=';
+            } else if (remaining_bytes == 1) {
+                encode_triplet(p[0], std::byte{0x00}, std::byte{0x00}, r);
+                r[2] = '=';
+                r[3] = '=';
+            }
+        }
+    }
+
     /**
      * Generates the Base64-encoded representation of a raw sequence of bytes.
      *
@@ -93,59 +146,13 @@ namespace persistence
      */
     inline bool base64_encode(const byte_view& input, std::string& output)
     {
-        using detail::encode_triplet;
-
         output.clear();
         if (input.size() == 0) {
             return true;
         }
 
-        std::size_t fast_sextets = input.size() / 24 * 4;  // round to multiples of 8 bytes to ensure pointer stays in addressable range
-        std::size_t full_triplets = input.size() / 3;
-        std::size_t remaining_triplets = full_triplets - fast_sextets * 2;
-        std::size_t remaining_bytes = input.size() % 3;
-        std::size_t output_size = full_triplets * 4 + (remaining_bytes > 0 ? 4 : 0);
-        output.resize(output_size);
-
-        const std::byte* p = input.data();
-        char* r = output.data();
-
-        // iterate over data with 64-bit words, processing full sextets
-        for (std::size_t i = 0; i < fast_sextets; ++i) {
-            uint64_t value = *reinterpret_cast<const uint64_t*>(p);
-            if constexpr (detail::endianness::native == detail::endianness::little) {
-                detail::encode_sextet_little_endian(value, r);
-            } else if constexpr (detail::endianness::native == detail::endianness::big) {
-                detail::encode_sextet_big_endian(value, r);
-            }
-            p += 6;
-            r += 8;
-        }
-
-        // process remaining full triplets (if any)
-        for (std::size_t i = 0; i < remaining_triplets; ++i) {
-            std::byte a = *p++;
-            std::byte b = *p++;
-            std::byte c = *p++;
-            encode_triplet(a, b, c, r);
-            r += 4;
-        }
-
-        // process remaining bytes (last incomplete triplet)
-        if (remaining_bytes == 2) {
-            std::byte a = input[input.size() - 2];
-            std::byte b = input[input.size() - 1];
-            encode_triplet(a, b, std::byte{0x00}, r);
-            r += 3;
-            *r++ = '=';
-        } else if (remaining_bytes == 1) {
-            std::byte a = input.back();
-            encode_triplet(a, std::byte{0x00}, std::byte{0x00}, r);
-            r += 2;
-            *r++ = '=';
-            *r++ = '=';
-        }
-
+        output.resize(detail::base64_encoded_length(input.size()));
+        detail::base64_encode(input.data(), input.size(), output.data());
         return true;
     }
 
@@ -259,7 +266,12 @@ namespace persistence
         const char* p = input.data();
         std::byte* r = output.data();
 
-        for (std::size_t i = 1; i < quadruplets; ++i) {
+        // decode with vector instructions as much as possible
+        const std::size_t consumed = detail::base64_decode_simd(p, input.size(), r);
+        p += consumed;
+        r += consumed / 4 * 3;
+
+        for (std::size_t i = consumed / 4 + 1; i < quadruplets; ++i) {
             char a = *p++;
             char b = *p++;
             char c = *p++;
@@ -319,4 +331,135 @@ namespace persistence
 
         return true;
     }
+
+    namespace detail
+    {
+        /**
+         * Decodes a Base64-encoded string that arrives in pieces, passing the bytes on to a sink in chunks.
+         *
+         * The last group of 4 characters received is held back until the string ends, because only the last group
+         * may contain padding.
+         */
+        class Base64Decoder
+        {
+        public:
+            explicit Base64Decoder(ByteSink& sink)
+                : sink(sink)
+            {}
+
+            /** Decodes the next piece of the string. */
+            bool update(const char* data, std::size_t size)
+            {
+                PERSISTENCE_IF_UNLIKELY(!ok) {
+                    return false;
+                }
+
+                if (pending_size + size <= 4) {
+                    std::memcpy(pending + pending_size, data, size);
+                    pending_size += size;
+                    return true;
+                }
+
+                // complete the group held back, which is now known not to be the last
+                if (pending_size > 0) {
+                    const std::size_t count = 4 - pending_size;
+                    std::memcpy(pending + pending_size, data, count);
+                    data += count;
+                    size -= count;
+                    pending_size = 0;
+                    if (!decode(pending, 4)) {
+                        return false;
+                    }
+                }
+
+                const std::size_t tail = size % 4 == 0 ? 4 : size % 4;
+                if (!decode(data, size - tail)) {
+                    return false;
+                }
+                std::memcpy(pending, data + size - tail, tail);
+                pending_size = tail;
+                return true;
+            }
+
+            /** Decodes the last group of characters once the string has ended, ready for the next string. */
+            bool finish()
+            {
+                PERSISTENCE_IF_UNLIKELY(!ok) {
+                    return false;
+                }
+                if (pending_size == 0) {
+                    return true;
+                }
+                PERSISTENCE_IF_UNLIKELY(pending_size != 4) {
+                    return ok = false;
+                }
+                pending_size = 0;
+
+                std::byte bytes[3];
+                std::size_t count = 3;
+                if (pending[2] == '=') {
+                    if (pending[3] != '=') {
+                        return ok = false;
+                    }
+                    pending[2] = 'A';
+                    pending[3] = 'A';
+                    count = 1;
+                } else if (pending[3] == '=') {
+                    pending[3] = 'A';
+                    count = 2;
+                }
+                PERSISTENCE_IF_UNLIKELY(!decode_quadruplet(pending[0], pending[1], pending[2], pending[3], bytes)) {
+                    return ok = false;
+                }
+                return write(bytes, count);
+            }
+
+            /** True if decoding has stopped because the sink has failed to store bytes. */
+            bool sink_failed() const
+            {
+                return write_failed;
+            }
+
+        private:
+            /** Decodes groups of characters without padding. */
+            bool decode(const char* p, std::size_t size)
+            {
+                constexpr std::size_t chunk_size = 4096;
+                std::byte buffer[chunk_size / 4 * 3];
+
+                while (size > 0) {
+                    const std::size_t count = std::min(size, chunk_size);
+                    const std::size_t consumed = base64_decode_simd(p, count, buffer);
+                    std::byte* r = buffer + consumed / 4 * 3;
+                    for (std::size_t i = consumed; i < count; i += 4) {
+                        PERSISTENCE_IF_UNLIKELY(!decode_quadruplet(p[i], p[i + 1], p[i + 2], p[i + 3], r)) {
+                            return ok = false;
+                        }
+                        r += 3;
+                    }
+                    if (!write(buffer, count / 4 * 3)) {
+                        return false;
+                    }
+                    p += count;
+                    size -= count;
+                }
+                return true;
+            }
+
+            bool write(const std::byte* data, std::size_t size)
+            {
+                PERSISTENCE_IF_UNLIKELY(!sink.write(data, size)) {
+                    write_failed = true;
+                    return ok = false;
+                }
+                return true;
+            }
+
+            ByteSink& sink;
+            char pending[4];
+            std::size_t pending_size = 0;
+            bool ok = true;
+            bool write_failed = false;
+        };
+    }
 }
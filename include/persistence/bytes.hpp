@@ -12,4 +12,44 @@ namespace persistence
     byte_vector make_byte_vector(Ts&&... args) noexcept {
         return { std::byte(std::forward<Ts>(args))... };
     }
+
+    /**
+     * Receives a sequence of bytes in chunks, as a Base64-encoded string is decoded piece by piece.
+     *
+     * Derive from this class to pass a large binary value on to a file or a socket as it is parsed, such that the
+     * value is never held in memory at once.
+     */
+    class ByteSink
+    {
+    public:
+        virtual ~ByteSink() = default;
+
+        /**
+         * Receives the next chunk of bytes.
+         *
+         * @return False if the bytes cannot be stored, which stops parsing.
+         */
+        virtual bool write(const std::byte* data, std::size_t size) = 0;
+    };
+
+    namespace detail
+    {
+        /** Appends bytes to a byte vector. */
+        class ByteVectorSink : public ByteSink
+        {
+        public:
+            explicit ByteVectorSink(byte_vector& bytes)
+                : bytes(bytes)
+            {}
+
+            bool write(const std::byte* data, std::size_t size) override
+            {
+                bytes.insert(bytes.end(), data, data + size);
+                return true;
+            }
+
+        private:
+            byte_vector& bytes;
+        };
+    }
 }
@@ -1,54 +1,103 @@
 #pragma once
+#include "detail/integer_formatter.hpp"
+#include "detail/integer_parser.hpp"
+#include "detail/time_encoding.hpp"
 #include "detail/unlikely.hpp"
-#include <charconv>
 #include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ratio>
 
-#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
 namespace persistence
 {
+    using timestamp = std::chrono::time_point<std::chrono::system_clock>;
+
     namespace detail
     {
+        /** A date in the proleptic Gregorian calendar. */
+        struct civil_date
+        {
+            std::int64_t year;
+            unsigned month;
+            unsigned day;
+        };
+
         /**
-         * Converts a Gregorian calendar UTC timestamp into a POSIX timestamp (seconds since epoch).
+         * Converts a Gregorian calendar date into the number of days since the UNIX epoch (1970-01-01).
+         *
+         * Uses the algorithm by Howard Hinnant: years are shifted to start in March, such that the leap day is the last
+         * day of the year, and counted in eras of 400 years, which have the same number of days.
          */
-        inline std::time_t utc_to_posix(std::tm* cal) {
-            return _mkgmtime(cal);
+        constexpr std::int64_t days_from_civil(std::int64_t year, unsigned month, unsigned day)
+        {
+            year -= month <= 2;
+            const std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+            const unsigned year_of_era = static_cast<unsigned>(year - era * 400);
+            const unsigned day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+            const unsigned day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+            return era * 146097 + static_cast<std::int64_t>(day_of_era) - 719468;
         }
-    }
-}
-#else
-namespace persistence
-{
-    namespace detail
-    {
+
         /**
-         * Converts a Gregorian calendar UTC timestamp into a POSIX timestamp (seconds since epoch).
+         * Converts the number of days since the UNIX epoch (1970-01-01) into a Gregorian calendar date.
          */
-        inline std::time_t utc_to_posix(std::tm* cal) {
-            return timegm(cal);
+        constexpr civil_date civil_from_days(std::int64_t days)
+        {
+            days += 719468;
+            const std::int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+            const unsigned day_of_era = static_cast<unsigned>(days - era * 146097);
+            const unsigned year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+            const unsigned day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+            const unsigned shifted_month = (5 * day_of_year + 2) / 153;
+            const unsigned day = day_of_year - (153 * shifted_month + 2) / 5 + 1;
+            const unsigned month = shifted_month < 10 ? shifted_month + 3 : shifted_month - 9;
+            return { static_cast<std::int64_t>(year_of_era) + era * 400 + (month <= 2), month, day };
         }
-    }
-}
-#endif
 
-namespace persistence
-{
-    using timestamp = std::chrono::time_point<std::chrono::system_clock>;
+        /** Splits seconds since the epoch into days since the epoch and seconds of the day, rounding towards the past. */
+        constexpr std::int64_t split_days(std::int64_t seconds, unsigned& second_of_day)
+        {
+            std::int64_t days = seconds / 86400;
+            std::int64_t remainder = seconds % 86400;
+            if (remainder < 0) {
+                --days;
+                remainder += 86400;
+            }
+            second_of_day = static_cast<unsigned>(remainder);
+            return days;
+        }
+
+        /** Creates a time point from seconds since the epoch and a fraction of a second, if the clock can represent it. */
+        inline bool make_timestamp(std::int64_t seconds, unsigned nanosecond, timestamp& value)
+        {
+            using std::chrono::duration_cast;
+
+            // leave room for the fraction of a second
+            constexpr std::int64_t min_seconds = duration_cast<std::chrono::seconds>(timestamp::duration::min()).count() + 1;
+            constexpr std::int64_t max_seconds = duration_cast<std::chrono::seconds>(timestamp::duration::max()).count() - 1;
+            PERSISTENCE_IF_UNLIKELY(seconds < min_seconds || seconds > max_seconds) {
+                return false;
+            }
+
+            value = timestamp(
+                duration_cast<timestamp::duration>(std::chrono::seconds(seconds)) +
+                duration_cast<timestamp::duration>(std::chrono::nanoseconds(nanosecond))
+            );
+            return true;
+        }
+    }
 
     /**
      * Creates a chrono time point from a Gregorian calendar date and UTC time.
      */
-    inline timestamp make_datetime(unsigned year, unsigned month, unsigned day, unsigned hour, unsigned minute, unsigned second)
+    inline timestamp make_datetime(unsigned year, unsigned month, unsigned day, unsigned hour, unsigned minute, unsigned second, unsigned nanosecond = 0)
     {
-        std::tm tm{};
-        tm.tm_year = year - 1900;
-        tm.tm_mon = month - 1;
-        tm.tm_mday = day;
-        tm.tm_hour = hour;
-        tm.tm_min = minute;
-        tm.tm_sec = second;
-        std::time_t t = detail::utc_to_posix(&tm);
-        return std::chrono::system_clock::from_time_t(t);
+        const std::int64_t seconds = detail::days_from_civil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+        return timestamp(
+            std::chrono::duration_cast<timestamp::duration>(std::chrono::seconds(seconds)) +
+            std::chrono::duration_cast<timestamp::duration>(std::chrono::nanoseconds(nanosecond))
+        );
     }
 
     inline constexpr bool is_leap_year(unsigned year)
@@ -91,10 +140,69 @@ namespace persistence
 
     namespace detail
     {
-        inline bool from_digits(const char* first, const char* last, unsigned& value)
+        /**
+         * Reads 8 characters made up of 2-digit groups and separators, such as `HH:MM:SS`, validating all digits at once
+         * and combining adjacent digits into 2-digit values with SIMD within a register (SWAR).
+         *
+         * @param separator_mask A word with all bits set in the bytes of separator positions, with the first character
+         * in the least significant byte.
+         * @param separators A word with the expected separator characters in the bytes of separator positions.
+         * @param pairs Receives the 2-digit value of the digits at positions `k` and `k+1` in byte `k`.
+         */
+        inline bool parse_digit_pairs(const char* p, std::uint64_t separator_mask, std::uint64_t separators, std::uint64_t& pairs)
         {
-            auto result = std::from_chars(first, last, value);
-            return result.ec == std::errc() && result.ptr == last;
+            const std::uint64_t word = read_eight_chars(p);
+            const std::uint64_t digits = (word & ~separator_mask) | (0x3030303030303030ull & separator_mask);
+            PERSISTENCE_IF_UNLIKELY((word & separator_mask) != separators || !is_eight_digits(digits)) {
+                return false;
+            }
+
+            // bytes hold values 0 to 9, so neither step carries into the next byte
+            const std::uint64_t values = digits - 0x3030303030303030ull;
+            pairs = values * 10 + (values >> 8);
+            return true;
+        }
+
+        inline unsigned digit_pair_at(std::uint64_t pairs, int position)
+        {
+            return static_cast<unsigned>((pairs >> (8 * position)) & 0xFF);
+        }
+
+        inline bool parse_two_digits(const char* p, unsigned& value)
+        {
+            const unsigned tens = static_cast<unsigned char>(p[0] - '0');
+            const unsigned ones = static_cast<unsigned char>(p[1] - '0');
+            PERSISTENCE_IF_UNLIKELY(tens > 9 || ones > 9) {
+                return false;
+            }
+            value = 10 * tens + ones;
+            return true;
+        }
+
+        /** Parses and validates the date `YYYY-MM-DD` in the first 10 characters. */
+        inline bool parse_iso_date(const char* p, unsigned& year, unsigned& month, unsigned& day)
+        {
+            // YYYY-MM-
+            std::uint64_t pairs;
+            PERSISTENCE_IF_UNLIKELY(!parse_digit_pairs(p, 0xFF0000FF00000000ull, 0x2D00002D00000000ull, pairs) || !parse_two_digits(p + 8, day)) {
+                return false;
+            }
+            year = 100 * digit_pair_at(pairs, 0) + digit_pair_at(pairs, 2);
+            month = digit_pair_at(pairs, 5);
+            return is_valid_date(year, month, day);
+        }
+
+        /** Parses and validates the time `HH:MM:SS` in the first 8 characters. */
+        inline bool parse_iso_time(const char* p, unsigned& hour, unsigned& minute, unsigned& second)
+        {
+            std::uint64_t pairs;
+            PERSISTENCE_IF_UNLIKELY(!parse_digit_pairs(p, 0x0000FF0000FF0000ull, 0x00003A00003A0000ull, pairs)) {
+                return false;
+            }
+            hour = digit_pair_at(pairs, 0);
+            minute = digit_pair_at(pairs, 3);
+            second = digit_pair_at(pairs, 6);
+            return hour < 24 && minute < 60 && second < 60;
         }
     }
 
@@ -107,107 +215,81 @@ namespace persistence
             return false;
         }
 
-        PERSISTENCE_IF_UNLIKELY(text[4] != '-' || text[7] != '-') {
-            return false;
-        }
-
-        using detail::from_digits;
         unsigned year, month, day;
-        PERSISTENCE_IF_UNLIKELY(
-            !from_digits(text, text + 4, year) ||
-            !from_digits(text + 5, text + 7, month) ||
-            !from_digits(text + 8, text + 10, day)
-        ) {
-            return false;
-        }
-
-        PERSISTENCE_IF_UNLIKELY(!is_valid_date(year, month, day)) {
+        PERSISTENCE_IF_UNLIKELY(!detail::parse_iso_date(text, year, month, day)) {
             return false;
         }
 
-        value = make_datetime(year, month, day, 0, 0, 0);
-        return true;
+        return detail::make_timestamp(detail::days_from_civil(year, month, day) * 86400, 0, value);
     }
 
     /**
      * Parses a chrono time point from an ISO 8601 date-time string.
+     *
+     * The time may have a fraction of a second with up to 9 digits, and is followed by either `Z` for UTC or an offset
+     * from UTC, such as `+01:00`, e.g. `2022-02-01T23:02:01.250+01:00`.
      */
     inline bool parse_datetime(const char* text, std::size_t len, timestamp& value)
     {
-        PERSISTENCE_IF_UNLIKELY(len != 20) {
+        PERSISTENCE_IF_UNLIKELY(len < 20) {
             return false;
         }
 
+        unsigned year, month, day, hour, minute, second;
         PERSISTENCE_IF_UNLIKELY(
-            text[4] != '-' || text[7] != '-' ||
+            !detail::parse_iso_date(text, year, month, day) ||
             (text[10] != 'T' && text[10] != ' ') ||
-            text[13] != ':' || text[16] != ':' || text[19] != 'Z'
+            !detail::parse_iso_time(text + 11, hour, minute, second)
         ) {
             return false;
         }
 
-        using detail::from_digits;
-        unsigned year, month, day, hour, minute, second;
-        PERSISTENCE_IF_UNLIKELY(
-            !from_digits(text, text + 4, year) ||
-            !from_digits(text + 5, text + 7, month) ||
-            !from_digits(text + 8, text + 10, day) ||
-            !from_digits(text + 11, text + 13, hour) ||
-            !from_digits(text + 14, text + 16, minute) ||
-            !from_digits(text + 17, text + 19, second)
-        ) {
-            return false;
+        const char* p = text + 19;
+        const char* last = text + len;
+
+        // fraction of a second, scaled to nanoseconds
+        unsigned nanosecond = 0;
+        if (*p == '.') {
+            const char* first = ++p;
+            while (p != last && p - first < 9 && static_cast<unsigned char>(*p - '0') <= 9) {
+                nanosecond = 10 * nanosecond + static_cast<unsigned>(*p - '0');
+                ++p;
+            }
+            PERSISTENCE_IF_UNLIKELY(p == first) {
+                return false;
+            }
+            for (std::ptrdiff_t count = p - first; count < 9; ++count) {
+                nanosecond *= 10;
+            }
         }
 
-        PERSISTENCE_IF_UNLIKELY(!is_valid_date(year, month, day)) {
+        // time zone designator
+        std::int64_t offset = 0;
+        PERSISTENCE_IF_UNLIKELY(p == last) {
             return false;
         }
-        PERSISTENCE_IF_UNLIKELY(hour >= 24 || minute >= 60 || second >= 60) {
+        if (*p == 'Z') {
+            ++p;
+        } else if (*p == '+' || *p == '-') {
+            unsigned offset_hour, offset_minute;
+            PERSISTENCE_IF_UNLIKELY(
+                last - p < 6 ||
+                !detail::parse_two_digits(p + 1, offset_hour) || p[3] != ':' || !detail::parse_two_digits(p + 4, offset_minute) ||
+                offset_hour >= 24 || offset_minute >= 60
+            ) {
+                return false;
+            }
+            offset = (*p == '-' ? -1 : 1) * static_cast<std::int64_t>(offset_hour * 3600 + offset_minute * 60);
+            p += 6;
+        } else {
             return false;
         }
-
-        value = make_datetime(year, month, day, hour, minute, second);
-        return true;
-    }
-
-    namespace detail
-    {
-        template<std::size_t N>
-        struct AlignedDigitWriter {
-            std::to_chars_result operator()(char* ptr, int value) const;
-        };
-
-        template<>
-        struct AlignedDigitWriter<4> {
-            std::to_chars_result operator()(char* ptr, int value) const {
-                char* last = ptr + 4;
-                if (value < 10) {
-                    ptr += 3;
-                } else if (value < 100) {
-                    ptr += 2;
-                } else if (value < 1000) {
-                    ptr += 1;
-                }
-                return std::to_chars(ptr, last, value);
-            }
-        };
-
-        template<>
-        struct AlignedDigitWriter<2> {
-            std::to_chars_result operator()(char* ptr, int value) const {
-                char* last = ptr + 2;
-                if (value < 10) {
-                    ptr += 1;
-                }
-                return std::to_chars(ptr, last, value);
-            }
-        };
-
-        template<std::size_t N>
-        std::to_chars_result to_aligned_digits(char* ptr, int value) {
-            AlignedDigitWriter<N> writer;
-            return writer(ptr, value);
+        PERSISTENCE_IF_UNLIKELY(p != last) {
+            return false;
         }
+
+        const std::int64_t seconds = detail::days_from_civil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second - offset;
+        return detail::make_timestamp(seconds, nanosecond, value);
     }
 
     /**
@@ -221,15 +303,24 @@ namespace persistence
         char* month() { return text + 5; }
         char* day() { return text + 8; }
 
+        /** The number of characters in a date string. */
         constexpr static std::size_t length() { return 10; }
+
+        /** The number of characters in this date string, or zero if the year is not in the range 0000 to 9999. */
+        std::size_t size() const
+        {
+            return text_size;
+        }
+
+        std::size_t text_size = 0;
     };
 
     /**
-     * Represents an ISO 8601 date-time string.
+     * Represents an ISO 8601 date-time string in UTC, with a fraction of a second only if the time has one.
      */
     struct iso_datetime
     {
-        char text[21] = "0000-00-00T00:00:00Z";
+        char text[31] = "0000-00-00T00:00:00.000000000Z";
 
         char* year() { return text; }
         char* month() { return text + 5; }
@@ -238,60 +329,162 @@ namespace persistence
         char* minute() { return text + 14; }
         char* second() { return text + 17; }
 
+        /** The number of characters in a date-time string without a fraction of a second. */
         constexpr static std::size_t length() { return 20; }
+
+        /** The number of characters in a date-time string with nanoseconds. */
+        constexpr static std::size_t max_length() { return 30; }
+
+        /** The number of characters in this date-time string, or zero if the year is not in the range 0000 to 9999. */
+        std::size_t size() const
+        {
+            return text_size;
+        }
+
+        std::size_t text_size = 0;
     };
 
+    namespace detail
+    {
+        /** Writes the date `YYYY-MM-DD` into the first 10 characters, if the year has 4 digits. */
+        inline bool format_iso_date(const civil_date& date, char* p)
+        {
+            PERSISTENCE_IF_UNLIKELY(date.year < 0 || date.year > 9999) {
+                return false;
+            }
+
+            const unsigned year = static_cast<unsigned>(date.year);
+            write_two_digits(year / 100, p);
+            write_two_digits(year % 100, p + 2);
+            p[4] = '-';
+            write_two_digits(date.month, p + 5);
+            p[7] = '-';
+            write_two_digits(date.day, p + 8);
+            return true;
+        }
+
+        /** Writes digits of a fraction of a second into a buffer filled with zeros, and returns the number of digits. */
+        inline std::size_t format_fraction(unsigned nanosecond, char* p)
+        {
+            // as many digits as milliseconds, microseconds or nanoseconds require
+            if (nanosecond % 1000000 == 0) {
+                write_digits(nanosecond / 1000000, p + 3);
+                return 3;
+            } else if (nanosecond % 1000 == 0) {
+                write_digits(nanosecond / 1000, p + 6);
+                return 6;
+            } else {
+                write_digits(nanosecond, p + 9);
+                return 9;
+            }
+        }
+    }
+
     /**
      * Converts a chrono time point to an ISO 8601 date string.
      */
     inline iso_date to_iso_date(timestamp value)
     {
-        // get number of seconds since the UNIX epoch: Thu, January 1, 1970, 00:00:00 UTC
-        std::time_t posix_time = std::chrono::system_clock::to_time_t(value);
-
-        // convert to calendar time in timezone UTC
-        auto calendar_time = gmtime(&posix_time);
-        int year = calendar_time->tm_year + 1900;
-        int month = calendar_time->tm_mon + 1;
-        int day = calendar_time->tm_mday;
+        const auto seconds = std::chrono::floor<std::chrono::seconds>(value.time_since_epoch());
+        unsigned second_of_day;
+        const std::int64_t days = detail::split_days(seconds.count(), second_of_day);
 
-        // format to seconds resolution, e.g. 1982-10-23T01:20:40Z
         iso_date dt;
-        using detail::to_aligned_digits;
-        to_aligned_digits<4>(dt.year(), year);
-        to_aligned_digits<2>(dt.month(), month);
-        to_aligned_digits<2>(dt.day(), day);
-
+        if (detail::format_iso_date(detail::civil_from_days(days), dt.text)) {
+            dt.text_size = iso_date::length();
+        }
         return dt;
     }
 
     /**
-     * Converts a chrono time point to an ISO 8601 date-time string.
+     * Converts a chrono time point to an ISO 8601 date-time string, e.g. `1982-10-23T01:20:40Z` or
+     * `1982-10-23T01:20:40.250Z`.
+     *
+     * Thread-safe and independent of the C library time functions.
      */
     inline iso_datetime to_iso_datetime(timestamp value)
     {
-        // get number of seconds since the UNIX epoch: Thu, January 1, 1970, 00:00:00 UTC
-        std::time_t posix_time = std::chrono::system_clock::to_time_t(value);
-
-        // convert to calendar time in timezone UTC
-        auto calendar_time = gmtime(&posix_time);
-        int year = calendar_time->tm_year + 1900;
-        int month = calendar_time->tm_mon + 1;
-        int day = calendar_time->tm_mday;
-        int hour = calendar_time->tm_hour;
-        int minute = calendar_time->tm_min;
-        int second = calendar_time->tm_sec;
-
-        // format to seconds resolution, e.g. 1982-10-23T01:20:40Z
+        const auto seconds = std::chrono::floor<std::chrono::seconds>(value.time_since_epoch());
+        const auto nanosecond = static_cast<unsigned>(std::chrono::duration_cast<std::chrono::nanoseconds>(value.time_since_epoch() - seconds).count());
+        unsigned second_of_day;
+        const std::int64_t days = detail::split_days(seconds.count(), second_of_day);
+
         iso_datetime dt;
-        using detail::to_aligned_digits;
-        to_aligned_digits<4>(dt.year(), year);
-        to_aligned_digits<2>(dt.month(), month);
-        to_aligned_digits<2>(dt.day(), day);
-        to_aligned_digits<2>(dt.hour(), hour);
-        to_aligned_digits<2>(dt.minute(), minute);
-        to_aligned_digits<2>(dt.second(), second);
+        char* p = dt.text;
+        if (!detail::format_iso_date(detail::civil_from_days(days), p)) {
+            return dt;
+        }
 
+        using detail::write_two_digits;
+        write_two_digits(second_of_day / 3600, p + 11);
+        write_two_digits(second_of_day / 60 % 60, p + 14);
+        write_two_digits(second_of_day % 60, p + 17);
+        p += 19;
+
+        if (nanosecond != 0) {
+            p += 1 + detail::format_fraction(nanosecond, p + 1);
+        }
+        *p++ = 'Z';
+        *p = '\0';
+        dt.text_size = static_cast<std::size_t>(p - dt.text);
         return dt;
     }
+
+    namespace detail
+    {
+        /** The number of whole units of a duration since the epoch, rounding towards the past. */
+        template<typename Duration>
+        std::int64_t to_epoch_count(timestamp value)
+        {
+            return static_cast<std::int64_t>(std::chrono::floor<Duration>(value.time_since_epoch()).count());
+        }
+
+        /** Creates a time point from a number of units of a duration since the epoch, if the clock can represent it. */
+        template<typename Duration>
+        bool from_epoch_count(std::int64_t count, timestamp& value)
+        {
+            using ratio = std::ratio_divide<typename Duration::period, timestamp::period>;
+            if constexpr (ratio::den == 1) {
+                // the unit is a multiple of the clock tick
+                constexpr std::int64_t limit = std::numeric_limits<timestamp::rep>::max() / ratio::num;
+                PERSISTENCE_IF_UNLIKELY(count > limit || count < -limit) {
+                    return false;
+                }
+                value = timestamp(timestamp::duration(static_cast<timestamp::rep>(count * ratio::num)));
+            } else {
+                value = timestamp(std::chrono::floor<timestamp::duration>(Duration(count)));
+            }
+            return true;
+        }
+
+        /** The number of units since the epoch that represents a time point in an integer time encoding. */
+        inline std::int64_t to_epoch(timestamp value, TimeEncoding encoding)
+        {
+            switch (encoding) {
+                case TimeEncoding::epoch_seconds:
+                    return to_epoch_count<std::chrono::seconds>(value);
+                case TimeEncoding::epoch_milliseconds:
+                    return to_epoch_count<std::chrono::milliseconds>(value);
+                case TimeEncoding::epoch_microseconds:
+                    return to_epoch_count<std::chrono::microseconds>(value);
+                default:
+                    return to_epoch_count<std::chrono::nanoseconds>(value);
+            }
+        }
+
+        /** Creates a time point from the number of units since the epoch in an integer time encoding. */
+        inline bool from_epoch(std::int64_t count, TimeEncoding encoding, timestamp& value)
+        {
+            switch (encoding) {
+                case TimeEncoding::epoch_seconds:
+                    return from_epoch_count<std::chrono::seconds>(count, value);
+                case TimeEncoding::epoch_milliseconds:
+                    return from_epoch_count<std::chrono::milliseconds>(count, value);
+                case TimeEncoding::epoch_microseconds:
+                    return from_epoch_count<std::chrono::microseconds>(count, value);
+                default:
+                    return from_epoch_count<std::chrono::nanoseconds>(count, value);
+            }
+        }
+    }
 }
@@ -0,0 +1,174 @@
+#pragma once
+#include "detail/float_formatter.hpp"
+#include "detail/float_parser.hpp"
+#include "detail/integer_formatter.hpp"
+#include "detail/unlikely.hpp"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace persistence
+{
+    /**
+     * An exact decimal number `coefficient * 10^-scale`, such as an amount of money.
+     *
+     * A decimal is built straight from a JSON number literal, and written back with the same digits, including
+     * trailing zeros: `19.90` has coefficient 1990 and scale 2. The coefficient is a signed 64-bit integer, which
+     * holds any literal of up to 18 significant digits; literals with more digits than the coefficient holds are
+     * rejected.
+     */
+    struct decimal
+    {
+        constexpr decimal() = default;
+
+        constexpr decimal(std::int64_t coefficient, std::int32_t scale = 0)
+            : coefficient(coefficient)
+            , scale(scale)
+        {}
+
+        std::int64_t coefficient = 0;
+        std::int32_t scale = 0;
+    };
+
+    namespace detail
+    {
+        /** Maximum number of characters in the JSON representation of a decimal. */
+        constexpr std::size_t max_decimal_length = 40;
+
+        /** Removes trailing zeros from the coefficient, which gives every numeric value a unique representation. */
+        inline decimal normalize_decimal(decimal value)
+        {
+            if (value.coefficient == 0) {
+                return decimal();
+            }
+            while (value.coefficient % 10 == 0 && value.scale > std::numeric_limits<std::int32_t>::min()) {
+                value.coefficient /= 10;
+                --value.scale;
+            }
+            return value;
+        }
+
+        inline std::uint64_t decimal_magnitude(std::int64_t value)
+        {
+            return value < 0 ? 0 - static_cast<std::uint64_t>(value) : static_cast<std::uint64_t>(value);
+        }
+
+        /** Builds a decimal from a sign, a magnitude and a decimal exponent, if in range. */
+        inline bool make_decimal(bool negative, std::uint64_t mantissa, std::int64_t exponent, decimal& value)
+        {
+            const std::uint64_t limit = static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()) + negative;
+            PERSISTENCE_IF_UNLIKELY(mantissa > limit) {
+                return false;
+            }
+            PERSISTENCE_IF_UNLIKELY(exponent < -static_cast<std::int64_t>(std::numeric_limits<std::int32_t>::max()) || exponent > std::numeric_limits<std::int32_t>::max()) {
+                return false;
+            }
+
+            value.coefficient = negative ? static_cast<std::int64_t>(0 - mantissa) : static_cast<std::int64_t>(mantissa);
+            value.scale = static_cast<std::int32_t>(-exponent);
+            return true;
+        }
+
+        /**
+         * Converts a finite floating-point number into the shortest decimal that reads back as the same number.
+         *
+         * Used when the JSON number literal is no longer available, e.g. when the value comes from a JSON DOM.
+         */
+        inline bool double_to_decimal(double d, decimal& value)
+        {
+            PERSISTENCE_IF_UNLIKELY(!std::isfinite(d)) {
+                return false;
+            }
+            DecimalLiteral literal = to_decimal(d);
+            return make_decimal(literal.negative, literal.mantissa, literal.exponent, value);
+        }
+
+        /** Converts a decimal into the nearest floating-point number. */
+        inline double decimal_to_double(const decimal& value)
+        {
+            AdjustedMantissa am = compute_float<double>(-static_cast<std::int64_t>(value.scale), decimal_magnitude(value.coefficient));
+            return to_float<double>(value.coefficient < 0, am);
+        }
+
+        /**
+         * Writes a decimal as a JSON number literal with all digits of the coefficient.
+         *
+         * Fixed notation is used unless the scale is negative or more than 6 zeros would follow the decimal point,
+         * in which case the coefficient is followed by an exponent, e.g. `15e3` or `25e-12`.
+         *
+         * @param buffer A buffer of at least `max_decimal_length` characters.
+         * @return The position past the last character written.
+         */
+        inline char* format_decimal(const decimal& value, char* buffer)
+        {
+            if (value.coefficient < 0) {
+                *buffer++ = '-';
+            }
+
+            const std::uint64_t digits = decimal_magnitude(value.coefficient);
+            const int length = decimal_length(digits);
+            const std::int64_t scale = value.scale;
+
+            if (scale == 0) {
+                write_digits(digits, buffer + length);
+                return buffer + length;
+            } else if (0 < scale && scale < length) {
+                // 1990 with scale 2 -> 19.90
+                const int integer_length = length - static_cast<int>(scale);
+                write_digits(digits, buffer + length + 1);
+                std::memmove(buffer, buffer + 1, static_cast<std::size_t>(integer_length));
+                buffer[integer_length] = '.';
+                return buffer + length + 1;
+            } else if (length <= scale && scale <= length + 6) {
+                // 5 with scale 3 -> 0.005
+                const int zeros = static_cast<int>(scale) - length;
+                buffer[0] = '0';
+                buffer[1] = '.';
+                std::memset(buffer + 2, '0', static_cast<std::size_t>(zeros));
+                char* last = buffer + 2 + zeros + length;
+                write_digits(digits, last);
+                return last;
+            }
+
+            write_digits(digits, buffer + length);
+            char* p = buffer + length;
+            *p++ = 'e';
+            std::int64_t exponent = -scale;
+            if (exponent < 0) {
+                *p++ = '-';
+                exponent = -exponent;
+            }
+            const int exponent_length = decimal_length(static_cast<std::uint64_t>(exponent));
+            write_digits(static_cast<std::uint64_t>(exponent), p + exponent_length);
+            return p + exponent_length;
+        }
+    }
+
+    /** True if two decimals have the same numeric value; `1.5` equals `1.50`. */
+    inline bool operator==(const decimal& left, const decimal& right)
+    {
+        decimal l = detail::normalize_decimal(left);
+        decimal r = detail::normalize_decimal(right);
+        return l.coefficient == r.coefficient && l.scale == r.scale;
+    }
+
+    inline bool operator!=(const decimal& left, const decimal& right)
+    {
+        return !(left == right);
+    }
+
+    /**
+     * Parses a JSON number literal into a decimal, keeping all digits including trailing zeros.
+     *
+     * @return False if the literal is malformed, or has more significant digits than the coefficient can hold.
+     */
+    inline bool parse_decimal(const char* str, std::size_t len, decimal& value)
+    {
+        detail::DecimalLiteral literal;
+        PERSISTENCE_IF_UNLIKELY(!detail::parse_decimal(str, str + len, literal) || literal.truncated) {
+            return false;
+        }
+        return detail::make_decimal(literal.negative, literal.mantissa, literal.exponent, value);
+    }
+}
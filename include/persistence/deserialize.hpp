@@ -2,6 +2,7 @@
 #include "deserialize_base.hpp"
 #include "detail/deserialize_aware.hpp"
 #include "detail/traits.hpp"
+#include "utf8.hpp"
 #include <rapidjson/error/en.h>
 
 namespace persistence
@@ -63,14 +64,22 @@ namespace persistence
      *
      * Does not throw parse exceptions.
      *
+     * @tparam ParseFlags RapidJSON parse flags. With `rapidjson::kParseValidateEncodingFlag`, the string is validated
+     * as UTF-8 with vector instructions before it is parsed.
      * @param str The source string.
      * @param obj A reference to an empty C++ object to populate.
      */
-    template<typename T>
+    template<typename T, unsigned ParseFlags = rapidjson::kParseDefaultFlags>
     bool deserialize(const std::string& str, T& obj)
     {
+        if constexpr (detail::validate_utf8<ParseFlags>) {
+            if (!is_valid_utf8(str)) {
+                return false;
+            }
+        }
+
         rapidjson::Document doc;
-        doc.Parse(str.data());
+        doc.Parse<detail::reader_flags<ParseFlags>>(str.data());
         auto&& error = doc.GetParseError();
         return !error && deserialize(doc, obj);
     }
@@ -80,14 +89,22 @@ namespace persistence
      *
      * Does not throw parse exceptions.
      *
+     * @tparam ParseFlags RapidJSON parse flags. With `rapidjson::kParseValidateEncodingFlag`, the string is validated
+     * as UTF-8 with vector instructions before it is parsed.
      * @param str The source string.
      * @param obj A reference to an empty C++ object to populate.
      */
-    template<typename T>
+    template<typename T, unsigned ParseFlags = rapidjson::kParseDefaultFlags>
     bool deserialize(std::string&& str, T& obj)
     {
+        if constexpr (detail::validate_utf8<ParseFlags>) {
+            if (!is_valid_utf8(str)) {
+                return false;
+            }
+        }
+
         rapidjson::Document doc;
-        doc.ParseInsitu(str.data());
+        doc.ParseInsitu<detail::reader_flags<ParseFlags>>(str.data());
         auto&& error = doc.GetParseError();
         return !error && deserialize(doc, obj);
     }
@@ -95,26 +112,40 @@ namespace persistence
     /**
      * Deserializes a C++ object from a JSON string via JSON DOM.
      */
-    template<typename T>
+    template<typename T, unsigned ParseFlags = rapidjson::kParseDefaultFlags>
     T deserialize(const std::string& str)
     {
         static_assert(!std::is_const_v<T> && !std::is_volatile_v<T> && !std::is_reference_v<T>, "expected a type without qualifiers");
 
+        if constexpr (detail::validate_utf8<ParseFlags>) {
+            auto result = detail::check_utf8(str);
+            if (result.IsError()) {
+                throw JsonParseError(rapidjson::GetParseError_En(result.Code()), result.Offset());
+            }
+        }
+
         rapidjson::Document doc;
-        doc.Parse(str.data());
+        doc.Parse<detail::reader_flags<ParseFlags>>(str.data());
         return deserialize<T>(doc);
     }
 
     /**
      * Deserializes a C++ object from a JSON string via JSON DOM.
      */
-    template<typename T>
+    template<typename T, unsigned ParseFlags = rapidjson::kParseDefaultFlags>
     T deserialize(std::string&& str)
     {
         static_assert(!std::is_const_v<T> && !std::is_volatile_v<T> && !std::is_reference_v<T>, "expected a type without qualifiers");
 
+        if constexpr (detail::validate_utf8<ParseFlags>) {
+            auto result = detail::check_utf8(str);
+            if (result.IsError()) {
+                throw JsonParseError(rapidjson::GetParseError_En(result.Code()), result.Offset());
+            }
+        }
+
         rapidjson::Document doc;
-        doc.ParseInsitu(str.data());
+        doc.ParseInsitu<detail::reader_flags<ParseFlags>>(str.data());
         return deserialize<T>(doc);
     }
 }
@@ -11,6 +11,7 @@
 #include "deserialize_array.hpp"
 #include "deserialize_bytes.hpp"
 #include "deserialize_datetime.hpp"
+#include "deserialize_decimal.hpp"
 #include "deserialize_enum.hpp"
 #include "deserialize_map.hpp"
 #include "deserialize_set.hpp"
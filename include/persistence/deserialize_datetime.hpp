@@ -12,8 +12,17 @@ namespace persistence
     {
         using JsonContextAwareDeserializer::JsonContextAwareDeserializer;
 
+        JsonDeserializer(DeserializerContext& context, TimeEncoding encoding)
+            : JsonContextAwareDeserializer(context)
+            , encoding(encoding)
+        {}
+
         bool operator()(const rapidjson::Value& json, timestamp& value) const
         {
+            if (encoding != TimeEncoding::iso8601) {
+                return deserialize_epoch(json, value);
+            }
+
             if (!detail::check_string<Exception>(json, context)) {
                 return false;
             }
@@ -21,7 +30,35 @@ namespace persistence
             PERSISTENCE_IF_UNLIKELY(!parse_datetime(json.GetString(), json.GetStringLength(), value)) {
                 if constexpr (Exception) {
                     throw JsonDeserializationError(
-                        "invalid ISO-8601 date-time; expected: YYYY-MM-DDTHH:MM:SSZ, got: " + std::string(json.GetString(), json.GetStringLength()),
+                        "invalid ISO-8601 date-time; expected: YYYY-MM-DDTHH:MM:SS[.fff](Z|+hh:mm), got: " + std::string(json.GetString(), json.GetStringLength()),
+                        Path(context.segments()).str()
+                    );
+                } else {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+    private:
+        bool deserialize_epoch(const rapidjson::Value& json, timestamp& value) const
+        {
+            PERSISTENCE_IF_UNLIKELY(!json.IsInt64()) {
+                if constexpr (Exception) {
+                    throw JsonDeserializationError(
+                        "wrong JSON data type; expected: 64-bit integer",
+                        Path(context.segments()).str()
+                    );
+                } else {
+                    return false;
+                }
+            }
+
+            PERSISTENCE_IF_UNLIKELY(!detail::from_epoch(json.GetInt64(), encoding, value)) {
+                if constexpr (Exception) {
+                    throw JsonDeserializationError(
+                        "time point out of the range of the clock: " + std::to_string(json.GetInt64()),
                         Path(context.segments()).str()
                     );
                 } else {
@@ -31,5 +68,7 @@ namespace persistence
 
             return true;
         }
+
+        TimeEncoding encoding = TimeEncoding::iso8601;
     };
 }
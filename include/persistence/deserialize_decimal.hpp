@@ -0,0 +1,58 @@
+#pragma once
+#include "decimal.hpp"
+#include "deserialize_base.hpp"
+#include "detail/deserialize_aware.hpp"
+#include "detail/path.hpp"
+#include "detail/unlikely.hpp"
+
+namespace persistence
+{
+    /**
+     * De-serializes a JSON DOM number into a decimal.
+     *
+     * Integers are taken as they are. Floating-point numbers, which the JSON DOM stores in binary, become the
+     * shortest decimal that reads back as the same number, such that `19.99` remains `19.99`. Only literals of up
+     * to 15 significant digits are recovered exactly this way; use `parse` to keep all digits of longer literals.
+     */
+    template<bool Exception>
+    struct JsonDeserializer<Exception, decimal> : JsonContextAwareDeserializer
+    {
+        using JsonContextAwareDeserializer::JsonContextAwareDeserializer;
+
+        bool operator()(const rapidjson::Value& json, decimal& value) const
+        {
+            PERSISTENCE_IF_UNLIKELY(!json.IsNumber()) {
+                if constexpr (Exception) {
+                    throw JsonDeserializationError(
+                        "wrong JSON data type; expected: number",
+                        Path(context.segments()).str()
+                    );
+                } else {
+                    return false;
+                }
+            }
+
+            bool result;
+            if (json.IsInt64()) {
+                value = decimal(json.GetInt64());
+                result = true;
+            } else if (json.IsUint64()) {
+                result = false;
+            } else {
+                result = detail::double_to_decimal(json.GetDouble(), value);
+            }
+
+            PERSISTENCE_IF_UNLIKELY(!result) {
+                if constexpr (Exception) {
+                    throw JsonDeserializationError(
+                        "decimal out of range",
+                        Path(context.segments()).str()
+                    );
+                } else {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+}
@@ -4,7 +4,7 @@
 #include "deserialize_fundamental.hpp"
 #include "detail/unlikely.hpp"
 #ifdef PERSISTENCE_BOOST_DESCRIBE
-#include <boost/describe/enum_from_string.hpp>
+#include "enum_utility.hpp"
 #endif
 
 namespace persistence
@@ -75,7 +75,7 @@ namespace persistence
             }
 
             std::string_view view(json.GetString(), json.GetStringLength());
-            PERSISTENCE_IF_UNLIKELY(!::boost::describe::enum_from_string(view.data(), value)) {
+            PERSISTENCE_IF_UNLIKELY(!detail::described_enum_converter<T>.from_string(view, value)) {
                 if constexpr (Exception) {
                     throw JsonDeserializationError(
                         "unrecognized enumeration string value; got: " + std::string(view),
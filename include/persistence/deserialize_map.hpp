@@ -1,12 +1,39 @@
 #pragma once
+#include "dictionary.hpp"
 #include "deserialize_base.hpp"
 #include "deserialize_check.hpp"
 #include "detail/deserialize_aware.hpp"
+#include "detail/integer_key.hpp"
+#include "detail/unlikely.hpp"
 #include <map>
 #include <unordered_map>
 
 namespace persistence
 {
+    namespace detail
+    {
+        /** Converts a JSON object key into a dictionary key of a string or integer type. */
+        template<bool Exception, typename K>
+        bool deserialize_object_key(const std::string_view& name, K& key, DeserializerContext& context)
+        {
+            if constexpr (is_integer_key_v<K>) {
+                PERSISTENCE_IF_UNLIKELY(!parse_integer_key(name, key)) {
+                    if constexpr (Exception) {
+                        throw JsonDeserializationError(
+                            "expected an integer object key; got: " + std::string(name),
+                            Path(context.segments()).str()
+                        );
+                    } else {
+                        return false;
+                    }
+                }
+            } else {
+                key = K(name);
+            }
+            return true;
+        }
+    }
+
     template<bool Exception, typename C>
     struct JsonDictionaryDeserializer : JsonContextAwareDeserializer
     {
@@ -33,6 +60,105 @@ namespace persistence
         }
     };
 
+    /**
+     * De-serializes a JSON object whose keys are decimal integers into a dictionary with integer keys.
+     */
+    template<bool Exception, typename C>
+    struct JsonIntegerKeyDictionaryDeserializer : JsonContextAwareDeserializer
+    {
+        using JsonContextAwareDeserializer::JsonContextAwareDeserializer;
+
+        bool operator()(const rapidjson::Value& json, C& value) const
+        {
+            using key_type = typename C::key_type;
+            using item_type = typename C::mapped_type;
+
+            if (!detail::check_object<Exception>(json, context)) {
+                return false;
+            }
+
+            value.clear();
+            for (auto&& it = json.MemberBegin(); it != json.MemberEnd(); ++it) {
+                const std::string_view name(it->name.GetString(), it->name.GetStringLength());
+                DeserializerContext item_context(context, Segment(name));
+
+                key_type key;
+                PERSISTENCE_IF_UNLIKELY(!detail::deserialize_object_key<Exception>(name, key, item_context)) {
+                    return false;
+                }
+
+                item_type item;
+                if (!deserialize<Exception>(it->value, item, item_context)) {
+                    return false;
+                }
+                value[key] = std::move(item);
+            }
+            return true;
+        }
+    };
+
+    /**
+     * De-serializes a JSON object into a vector of key and value pairs, in the order the keys appear in the input.
+     */
+    template<bool Exception, typename C>
+    struct JsonDictDeserializer : JsonContextAwareDeserializer
+    {
+        using JsonContextAwareDeserializer::JsonContextAwareDeserializer;
+
+        bool operator()(const rapidjson::Value& json, C& value) const
+        {
+            if (!detail::check_object<Exception>(json, context)) {
+                return false;
+            }
+
+            value.clear();
+            value.reserve(json.MemberCount());
+            for (auto&& it = json.MemberBegin(); it != json.MemberEnd(); ++it) {
+                const std::string_view name(it->name.GetString(), it->name.GetStringLength());
+                DeserializerContext item_context(context, Segment(name));
+
+                auto& item = value.emplace_back();
+                PERSISTENCE_IF_UNLIKELY(!detail::deserialize_object_key<Exception>(name, item.first, item_context)) {
+                    return false;
+                }
+                if (!deserialize<Exception>(it->value, item.second, item_context)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    /**
+     * De-serializes a JSON object into a sorted flat dictionary, sorting the items once all have been collected.
+     */
+    template<bool Exception, typename C>
+    struct JsonFlatMapDeserializer : JsonContextAwareDeserializer
+    {
+        using JsonContextAwareDeserializer::JsonContextAwareDeserializer;
+
+        bool operator()(const rapidjson::Value& json, C& value) const
+        {
+            typename C::container_type items;
+            JsonDictDeserializer<Exception, typename C::container_type> deserializer(context);
+            if (!deserializer(json, items)) {
+                return false;
+            }
+
+            PERSISTENCE_IF_UNLIKELY(!value.assign(std::move(items))) {
+                if constexpr (Exception) {
+                    throw JsonDeserializationError(
+                        "duplicate key in JSON object",
+                        Path(context.segments()).str()
+                    );
+                } else {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
     template<bool Exception, typename T>
     struct JsonDeserializer<Exception, std::map<std::string, T>> : JsonDictionaryDeserializer<Exception, std::map<std::string, T>>
     {
@@ -44,4 +170,28 @@ namespace persistence
     {
         using JsonDictionaryDeserializer<Exception, std::unordered_map<std::string, T>>::JsonDictionaryDeserializer;
     };
+
+    template<bool Exception, typename K, typename T>
+    struct JsonDeserializer<Exception, std::map<K, T>, std::enable_if_t<detail::is_integer_key_v<K>>> : JsonIntegerKeyDictionaryDeserializer<Exception, std::map<K, T>>
+    {
+        using JsonIntegerKeyDictionaryDeserializer<Exception, std::map<K, T>>::JsonIntegerKeyDictionaryDeserializer;
+    };
+
+    template<bool Exception, typename K, typename T>
+    struct JsonDeserializer<Exception, std::unordered_map<K, T>, std::enable_if_t<detail::is_integer_key_v<K>>> : JsonIntegerKeyDictionaryDeserializer<Exception, std::unordered_map<K, T>>
+    {
+        using JsonIntegerKeyDictionaryDeserializer<Exception, std::unordered_map<K, T>>::JsonIntegerKeyDictionaryDeserializer;
+    };
+
+    template<bool Exception, typename T>
+    struct JsonDeserializer<Exception, string_dict<T>> : JsonDictDeserializer<Exception, string_dict<T>>
+    {
+        using JsonDictDeserializer<Exception, string_dict<T>>::JsonDictDeserializer;
+    };
+
+    template<bool Exception, typename K, typename T, DuplicateKeys Duplicates>
+    struct JsonDeserializer<Exception, flat_map<K, T, Duplicates>> : JsonFlatMapDeserializer<Exception, flat_map<K, T, Duplicates>>
+    {
+        using JsonFlatMapDeserializer<Exception, flat_map<K, T, Duplicates>>::JsonFlatMapDeserializer;
+    };
 }
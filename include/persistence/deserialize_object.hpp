@@ -5,6 +5,7 @@
 #include "deserialize_check.hpp"
 #include "detail/deserialize_aware.hpp"
 #include "detail/traits.hpp"
+#include "detail/unlikely.hpp"
 #include <optional>
 
 namespace persistence
@@ -35,9 +36,11 @@ namespace persistence
 
             auto it = detail::find_object_member(json_object, member);
             if (it != json_object.MemberEnd()) {
-                T value;
+                T value = T();
                 DeserializerContext value_context(context, Segment(it->name.GetString()));
-                result = deserialize<Exception>(it->value, value, value_context);
+                PERSISTENCE_IF_UNLIKELY(!deserialize_member(it->value, value, member.time_encoding(), value_context)) {
+                    result = false;
+                }
                 member.ref(object) = std::move(value);
             } else {
                 member.ref(object) = std::nullopt;
@@ -53,7 +56,9 @@ namespace persistence
             auto it = detail::find_object_member(json_object, member);
             if (it != json_object.MemberEnd()) {
                 DeserializerContext value_context(context, Segment(it->name.GetString()));
-                result = deserialize<Exception>(it->value, member.ref(object), value_context);
+                PERSISTENCE_IF_UNLIKELY(!deserialize_member(it->value, member.ref(object), member.time_encoding(), value_context)) {
+                    result = false;
+                }
                 return *this;
             } else {
                 if constexpr (Exception) {
@@ -76,7 +81,9 @@ namespace persistence
             auto it = detail::find_object_member(json_object, member);
             if (it != json_object.MemberEnd()) {
                 DeserializerContext value_context(context, Segment(it->name.GetString()));
-                result = deserialize<Exception>(it->value, member.ref(object), value_context);
+                PERSISTENCE_IF_UNLIKELY(!deserialize_member(it->value, member.ref(object), member.time_encoding(), value_context)) {
+                    result = false;
+                }
             }
             return *this;
         }
@@ -91,6 +98,18 @@ namespace persistence
             return !result;
         }
 
+    private:
+        template<typename T>
+        static bool deserialize_member(const rapidjson::Value& json, T& ref, TimeEncoding encoding, DeserializerContext& context)
+        {
+            if constexpr (detail::is_time_encodable_v<T>) {
+                if (encoding != TimeEncoding::iso8601) {
+                    return JsonDeserializer<Exception, T>(context, encoding)(json, ref);
+                }
+            }
+            return deserialize<Exception>(json, ref, context);
+        }
+
     private:
         /** The JSON object from which data is read. */
         const rapidjson::Value& json_object;
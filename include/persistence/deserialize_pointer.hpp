@@ -47,11 +47,11 @@ namespace persistence
                     }
 
                     auto ref = context.get(object);
-                    PERSISTENCE_IF_UNLIKELY(!ref.has_value()) {
+                    PERSISTENCE_IF_UNLIKELY(!ref) {
                         return false;
                     }
 
-                    pointer = std::reinterpret_pointer_cast<T>(ref.value());
+                    pointer = std::reinterpret_pointer_cast<T>(*ref);
                     return true;
                 }
             }
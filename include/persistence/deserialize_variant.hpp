@@ -1,9 +1,12 @@
 #pragma once
+#include "variant.hpp"
 #include "deserialize_base.hpp"
+#include "deserialize_check.hpp"
 #include "exception.hpp"
 #include "detail/deserialize_aware.hpp"
 #include "detail/path.hpp"
 #include "detail/unlikely.hpp"
+#include <string>
 #include <variant>
 
 namespace persistence
@@ -15,17 +18,21 @@ namespace persistence
 
         bool operator()(const rapidjson::Value& json, std::variant<Ts...>& value) const
         {
-            PERSISTENCE_IF_UNLIKELY(!(... || deserialize_variant<Ts>(json, value))) {
-                if constexpr (Exception) {
-                    throw JsonDeserializationError(
-                        "unable to match either of the variant types",
-                        Path(context.segments()).str()
-                    );
-                } else {
-                    return false;
+            if constexpr (is_tagged_variant_v<Ts...>) {
+                return deserialize_tagged(json, value);
+            } else {
+                PERSISTENCE_IF_UNLIKELY(!(... || deserialize_variant<Ts>(json, value))) {
+                    if constexpr (Exception) {
+                        throw JsonDeserializationError(
+                            "unable to match either of the variant types",
+                            Path(context.segments()).str()
+                        );
+                    } else {
+                        return false;
+                    }
                 }
+                return true;
             }
-            return true;
         }
 
     private:
@@ -40,5 +47,50 @@ namespace persistence
             value = std::move(var);
             return true;
         }
+
+        /** Selects the alternative to de-serialize based on the value of the discriminator property. */
+        bool deserialize_tagged(const rapidjson::Value& json, std::variant<Ts...>& value) const
+        {
+            using tags_type = VariantTags<Ts...>;
+
+            if (!detail::check_object<Exception>(json, context)) {
+                return false;
+            }
+
+            rapidjson::Value name(rapidjson::StringRef(tags_type::discriminator.data(), tags_type::discriminator.size()));
+            auto it = json.FindMember(name);
+            PERSISTENCE_IF_UNLIKELY(it == json.MemberEnd()) {
+                if constexpr (Exception) {
+                    throw JsonDeserializationError(
+                        "missing discriminator property: " + std::string(tags_type::discriminator),
+                        Path(context.segments()).str()
+                    );
+                } else {
+                    return false;
+                }
+            }
+
+            DeserializerContext tag_context(context, Segment(it->name.GetString()));
+            if (!detail::check_string<Exception>(it->value, tag_context)) {
+                return false;
+            }
+
+            std::string_view tag(it->value.GetString(), it->value.GetStringLength());
+            std::size_t index = tags_type::index(tag);
+            PERSISTENCE_IF_UNLIKELY(index == sizeof...(Ts)) {
+                if constexpr (Exception) {
+                    throw JsonDeserializationError(
+                        "unrecognized variant tag: " + std::string(tag),
+                        Path(tag_context.segments()).str()
+                    );
+                } else {
+                    return false;
+                }
+            }
+
+            return tags_type::dispatch(index, [&](auto I) -> bool {
+                return deserialize<Exception>(json, value.template emplace<I>(), context);
+            });
+        }
     };
 }
@@ -0,0 +1,222 @@
+#pragma once
+#include "cpu_features.hpp"
+#include <cstddef>
+
+namespace persistence
+{
+    namespace detail
+    {
+#if defined(PERSISTENCE_X86_SIMD)
+        /**
+         * Encodes groups of 12 bytes into 16 Base64 characters with SSSE3 instructions.
+         *
+         * Bytes are spread into 6-bit indices with multiplications in 16-bit lanes, and indices are mapped to
+         * characters by adding an offset looked up by the range the index falls into.
+         *
+         * @return The number of bytes consumed, a multiple of 3.
+         */
+        PERSISTENCE_TARGET("ssse3")
+        inline std::size_t base64_encode_ssse3(const std::byte* in, std::size_t size, char* out)
+        {
+            const __m128i shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+            const __m128i offset_table = _mm_setr_epi8(
+                'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0
+            );
+
+            // each iteration reads 16 bytes but consumes only 12
+            std::size_t i = 0;
+            for (; i + 16 <= size; i += 12) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                v = _mm_shuffle_epi8(v, shuffle);
+
+                const __m128i ac = _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+                const __m128i bd = _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+                const __m128i indices = _mm_or_si128(ac, bd);
+
+                __m128i ranges = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+                const __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+                ranges = _mm_or_si128(ranges, _mm_and_si128(upper, _mm_set1_epi8(13)));
+                const __m128i chars = _mm_add_epi8(indices, _mm_shuffle_epi8(offset_table, ranges));
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), chars);
+                out += 16;
+            }
+            return i;
+        }
+
+        /**
+         * Encodes groups of 24 bytes into 32 Base64 characters with AVX2 instructions.
+         *
+         * @return The number of bytes consumed, a multiple of 3.
+         */
+        PERSISTENCE_TARGET("avx2")
+        inline std::size_t base64_encode_avx2(const std::byte* in, std::size_t size, char* out)
+        {
+            const __m256i shuffle = _mm256_broadcastsi128_si256(_mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+            const __m256i offset_table = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+                'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0
+            ));
+
+            // each iteration reads 28 bytes but consumes only 24, 12 bytes per 128-bit lane
+            std::size_t i = 0;
+            for (; i + 28 <= size; i += 24) {
+                const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 12));
+                __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+                v = _mm256_shuffle_epi8(v, shuffle);
+
+                const __m256i ac = _mm256_mulhi_epu16(_mm256_and_si256(v, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+                const __m256i bd = _mm256_mullo_epi16(_mm256_and_si256(v, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+                const __m256i indices = _mm256_or_si256(ac, bd);
+
+                __m256i ranges = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+                const __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+                ranges = _mm256_or_si256(ranges, _mm256_and_si256(upper, _mm256_set1_epi8(13)));
+                const __m256i chars = _mm256_add_epi8(indices, _mm256_shuffle_epi8(offset_table, ranges));
+
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), chars);
+                out += 32;
+            }
+            return i;
+        }
+
+        /**
+         * Decodes groups of 16 Base64 characters into 12 bytes with SSSE3 instructions.
+         *
+         * Characters are validated and translated into 6-bit values with lookups by high and low nibble, and
+         * the values are packed with multiply-add instructions. Stops at the first group with a character outside
+         * the Base64 alphabet, including padding, which is left for the scalar decoder to handle.
+         *
+         * @param out A buffer with room for at least `size / 4 * 3` bytes; up to 4 bytes past the decoded output
+         * may be overwritten.
+         * @return The number of characters consumed, a multiple of 4, excluding at least the last 8 characters.
+         */
+        PERSISTENCE_TARGET("ssse3")
+        inline std::size_t base64_decode_ssse3(const char* in, std::size_t size, std::byte* out)
+        {
+            const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+            const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+            const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+            const __m128i mask_2f = _mm_set1_epi8(0x2F);
+            const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+            std::size_t i = 0;
+            for (; i + 24 <= size; i += 16) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+
+                const __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(v, 4), mask_2f);
+                const __m128i lo_nibbles = _mm_and_si128(v, mask_2f);
+                const __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+                const __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+                if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0) {
+                    break;
+                }
+
+                const __m128i roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(_mm_cmpeq_epi8(v, mask_2f), hi_nibbles));
+                v = _mm_add_epi8(v, roll);
+
+                v = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+                v = _mm_madd_epi16(v, _mm_set1_epi32(0x00011000));
+                v = _mm_shuffle_epi8(v, pack);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), v);
+                out += 12;
+            }
+            return i;
+        }
+
+        /**
+         * Decodes groups of 32 Base64 characters into 24 bytes with AVX2 instructions.
+         *
+         * @param out A buffer with room for at least `size / 4 * 3` bytes; up to 8 bytes past the decoded output
+         * may be overwritten.
+         * @return The number of characters consumed, a multiple of 4, excluding at least the last 16 characters.
+         */
+        PERSISTENCE_TARGET("avx2")
+        inline std::size_t base64_decode_avx2(const char* in, std::size_t size, std::byte* out)
+        {
+            const __m256i lut_lo = _mm256_broadcastsi128_si256(_mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A));
+            const __m256i lut_hi = _mm256_broadcastsi128_si256(_mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10));
+            const __m256i lut_roll = _mm256_broadcastsi128_si256(_mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0));
+            const __m256i mask_2f = _mm256_set1_epi8(0x2F);
+            const __m256i pack = _mm256_broadcastsi128_si256(_mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+            const __m256i merge = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+
+            std::size_t i = 0;
+            for (; i + 48 <= size; i += 32) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+
+                const __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(v, 4), mask_2f);
+                const __m256i lo_nibbles = _mm256_and_si256(v, mask_2f);
+                const __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+                const __m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+                if (_mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_and_si256(lo, hi), _mm256_setzero_si256())) != 0) {
+                    break;
+                }
+
+                const __m256i roll = _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(_mm256_cmpeq_epi8(v, mask_2f), hi_nibbles));
+                v = _mm256_add_epi8(v, roll);
+
+                v = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+                v = _mm256_madd_epi16(v, _mm256_set1_epi32(0x00011000));
+                v = _mm256_shuffle_epi8(v, pack);
+                v = _mm256_permutevar8x32_epi32(v, merge);
+
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), v);
+                out += 24;
+            }
+            return i;
+        }
+#endif
+
+        /**
+         * Encodes a prefix of a sequence of bytes with the widest vector instructions available.
+         *
+         * @return The number of bytes consumed, a multiple of 3, possibly zero.
+         */
+        inline std::size_t base64_encode_simd(const std::byte* in, std::size_t size, char* out)
+        {
+#if defined(PERSISTENCE_X86_SIMD)
+            switch (supported_simd_level()) {
+                case simd_level::avx2:
+                    return base64_encode_avx2(in, size, out);
+                case simd_level::ssse3:
+                    return base64_encode_ssse3(in, size, out);
+                default:
+                    break;
+            }
+#else
+            (void)in;
+            (void)size;
+            (void)out;
+#endif
+            return 0;
+        }
+
+        /**
+         * Decodes a prefix of a Base64 string with the widest vector instructions available.
+         *
+         * @return The number of characters consumed, a multiple of 4, never including the last 4 characters.
+         */
+        inline std::size_t base64_decode_simd(const char* in, std::size_t size, std::byte* out)
+        {
+#if defined(PERSISTENCE_X86_SIMD)
+            switch (supported_simd_level()) {
+                case simd_level::avx2:
+                    return base64_decode_avx2(in, size, out);
+                case simd_level::ssse3:
+                    return base64_decode_ssse3(in, size, out);
+                default:
+                    break;
+            }
+#else
+            (void)in;
+            (void)size;
+            (void)out;
+#endif
+            return 0;
+        }
+    }
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <array>
 #include <stdexcept>
 
 namespace persistence
@@ -37,6 +38,12 @@ namespace persistence
             values[k] = true;
         }
 
+        /** Clears the state of a bit at the given index. */
+        constexpr void reset(std::size_t k)
+        {
+            values[k] = false;
+        }
+
         /** Returns the index of the first bit that is non-zero. */
         constexpr std::size_t first_set() const
         {
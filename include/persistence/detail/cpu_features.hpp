@@ -0,0 +1,76 @@
+#pragma once
+
+// detect instruction sets that may be selected at run time
+#if !defined(PERSISTENCE_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define PERSISTENCE_X86_SIMD
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#include <immintrin.h>
+#endif
+
+// enable instruction sets for a single function
+#if defined(_MSC_VER) && !defined(__clang__)
+#define PERSISTENCE_TARGET(features)
+#else
+#define PERSISTENCE_TARGET(features) __attribute__((target(features)))
+#endif
+
+namespace persistence
+{
+    namespace detail
+    {
+        /** Vector instruction set extensions, ordered by capability. */
+        enum class simd_level
+        {
+            none,
+            ssse3,
+            avx2
+        };
+
+        /** Queries the processor and the operating system for the vector instruction sets available. */
+        inline simd_level detect_simd_level()
+        {
+#if defined(PERSISTENCE_X86_SIMD) && defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+            const int max_function = info[0];
+
+            __cpuid(info, 1);
+            const bool ssse3 = (info[2] & (1 << 9)) != 0;
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            const bool avx = (info[2] & (1 << 28)) != 0;
+
+            // the operating system saves the upper halves of YMM registers on context switch
+            const bool ymm_state = osxsave && avx && (_xgetbv(0) & 0x6) == 0x6;
+
+            bool avx2 = false;
+            if (max_function >= 7) {
+                __cpuidex(info, 7, 0);
+                avx2 = ymm_state && (info[1] & (1 << 5)) != 0;
+            }
+
+            if (avx2) {
+                return simd_level::avx2;
+            } else if (ssse3) {
+                return simd_level::ssse3;
+            }
+#elif defined(PERSISTENCE_X86_SIMD)
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2")) {
+                return simd_level::avx2;
+            } else if (__builtin_cpu_supports("ssse3")) {
+                return simd_level::ssse3;
+            }
+#endif
+            return simd_level::none;
+        }
+
+        /** The vector instruction sets available, detected once on first use. */
+        inline simd_level supported_simd_level()
+        {
+            static const simd_level level = detect_simd_level();
+            return level;
+        }
+    }
+}
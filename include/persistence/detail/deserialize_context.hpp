@@ -2,6 +2,7 @@
 #include "document_context.hpp"
 #include "references.hpp"
 #include "segment.hpp"
+#include <memory>
 
 namespace persistence
 {
@@ -10,7 +11,7 @@ namespace persistence
     {
         using DocumentContext::DocumentContext;
 
-        ReferenceTable<const rapidjson::Value*, std::shared_ptr<void>> references;
+        ReferenceTable<std::shared_ptr<void>> references;
     };
 
     struct DeserializerContext
@@ -26,14 +27,14 @@ namespace persistence
             , segment(segment)
         {}
 
-        std::optional<std::shared_ptr<void>> get(const rapidjson::Value* pointer) const
+        const std::shared_ptr<void>* get(const rapidjson::Value* pointer) const
         {
             return global.references.get(pointer);
         }
 
         void put(const rapidjson::Value* pointer, std::shared_ptr<void> object)
         {
-            global.references.put(std::move(pointer), std::move(object));
+            global.references.put(pointer, std::move(object));
         }
 
         rapidjson::Document& document()
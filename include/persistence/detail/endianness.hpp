@@ -0,0 +1,20 @@
+#pragma once
+
+namespace persistence
+{
+    namespace detail
+    {
+        enum class endianness
+        {
+        #ifdef _WIN32
+            little = 0,
+            big    = 1,
+            native = little
+        #else
+            little = __ORDER_LITTLE_ENDIAN__,
+            big    = __ORDER_BIG_ENDIAN__,
+            native = __BYTE_ORDER__
+        #endif
+        };
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <array>
+#include <cstddef>
+
+namespace persistence
+{
+    namespace detail
+    {
+        /** Number of characters in a string written as the contents of a JSON string, with escape sequences. */
+        constexpr std::size_t escaped_length(const char* str)
+        {
+            std::size_t length = 0;
+            for (; *str != '\0'; ++str) {
+                const unsigned char c = static_cast<unsigned char>(*str);
+                if (c == '"' || c == '\\' || c == '\b' || c == '\f' || c == '\n' || c == '\r' || c == '\t') {
+                    length += 2;
+                } else if (c < 0x20) {
+                    length += 6;
+                } else {
+                    length += 1;
+                }
+            }
+            return length;
+        }
+
+        /**
+         * The name of an object member in its JSON form preceded by a separator, as in `,"name"`, built at compile
+         * time with the same escape sequences RapidJSON uses.
+         *
+         * @tparam Descriptor Structure that provides compile-time access to the member name as a string literal.
+         */
+        template<typename Descriptor>
+        struct escaped_key
+        {
+            constexpr static std::size_t size = escaped_length(Descriptor::name()) + 3;
+
+            constexpr static std::array<char, size> make()
+            {
+                constexpr char hex_digits[] = "0123456789ABCDEF";
+
+                std::array<char, size> key{};
+                std::size_t n = 0;
+                key[n++] = ',';
+                key[n++] = '"';
+                for (const char* p = Descriptor::name(); *p != '\0'; ++p) {
+                    const unsigned char c = static_cast<unsigned char>(*p);
+                    switch (c) {
+                        case '"': key[n++] = '\\'; key[n++] = '"'; break;
+                        case '\\': key[n++] = '\\'; key[n++] = '\\'; break;
+                        case '\b': key[n++] = '\\'; key[n++] = 'b'; break;
+                        case '\f': key[n++] = '\\'; key[n++] = 'f'; break;
+                        case '\n': key[n++] = '\\'; key[n++] = 'n'; break;
+                        case '\r': key[n++] = '\\'; key[n++] = 'r'; break;
+                        case '\t': key[n++] = '\\'; key[n++] = 't'; break;
+                        default:
+                            if (c < 0x20) {
+                                key[n++] = '\\';
+                                key[n++] = 'u';
+                                key[n++] = '0';
+                                key[n++] = '0';
+                                key[n++] = hex_digits[c >> 4];
+                                key[n++] = hex_digits[c & 0xF];
+                            } else {
+                                key[n++] = static_cast<char>(c);
+                            }
+                    }
+                }
+                key[n++] = '"';
+                return key;
+            }
+
+            constexpr static std::array<char, size> value = make();
+        };
+    }
+}
@@ -0,0 +1,321 @@
+#pragma once
+#include "float_parser.hpp"
+#include "integer_formatter.hpp"
+#include "number_format.hpp"
+#include "power_of_five.hpp"
+#include <cstdint>
+#include <cstring>
+
+namespace persistence
+{
+    namespace detail
+    {
+        /** Maximum number of characters in the shortest representation of a `float` or `double`. */
+        constexpr std::size_t max_float_length = 32;
+
+        /** Computes `floor(log10(2^e))` for binary exponents in the range of `double`. */
+        constexpr int floor_log10_pow2(int e)
+        {
+            return (e * 1262611) >> 22;
+        }
+
+        /** Computes `floor(log10(3/4 * 2^e))` for binary exponents in the range of `double`. */
+        constexpr int floor_log10_three_quarters_pow2(int e)
+        {
+            return (e * 1262611 - 524031) >> 22;
+        }
+
+        /** Computes `floor(log2(10^e))` for decimal exponents in the range of `double`. */
+        constexpr int floor_log2_pow10(int e)
+        {
+            return (e * 1741647) >> 19;
+        }
+
+        /**
+         * Returns the normalized 128-bit approximation of `10^k` (equivalently, of `5^k`), rounded up.
+         *
+         * Entries of the power-of-five table are exact for `0 <= k <= 55`, rounded up for `-27 <= k < 0`, and
+         * truncated otherwise.
+         */
+        inline Value128 power_of_ten_ceil(int k)
+        {
+            const std::size_t index = 2 * static_cast<std::size_t>(k - smallest_power_of_five);
+            Value128 g = { power_of_five_128[index + 1], power_of_five_128[index] };
+            if (k < -27 || k > 55) {
+                if (++g.low == 0) {
+                    ++g.high;
+                }
+            }
+            return g;
+        }
+
+        /** Computes `g * cp / 2^128`, rounded to odd. */
+        inline std::uint64_t round_to_odd(const Value128& g, std::uint64_t cp)
+        {
+            Value128 x = full_multiplication(g.low, cp);
+            Value128 y = full_multiplication(g.high, cp);
+            std::uint64_t z = y.low + x.high;
+            std::uint64_t vb = y.high + (z < y.low);
+            return vb | (z > 1);
+        }
+
+        /** Computes `g * cp / 2^64`, rounded to odd. */
+        inline std::uint32_t round_to_odd(std::uint64_t g, std::uint32_t cp)
+        {
+            std::uint64_t lo = (g & 0xFFFFFFFF) * cp;
+            std::uint64_t hi = (g >> 32) * cp + (lo >> 32);
+            return static_cast<std::uint32_t>(hi >> 32) | ((hi & 0xFFFFFFFF) > 1);
+        }
+
+        /** Multiplier of the Schubfach algorithm with just enough precision for the floating-point type. */
+        template<typename T>
+        auto schubfach_multiplier(int k)
+        {
+            Value128 g = power_of_ten_ceil(k);
+            if constexpr (std::is_same_v<T, float>) {
+                return g.high + (g.low != 0);
+            } else {
+                return g;
+            }
+        }
+
+        inline void remove_trailing_zeros(DecimalLiteral& decimal)
+        {
+            while (decimal.mantissa % 10 == 0) {
+                decimal.mantissa /= 10;
+                ++decimal.exponent;
+            }
+        }
+
+        /**
+         * Converts a finite binary floating-point number into the shortest decimal `mantissa * 10^exponent` that
+         * reads back as the same number, with the Schubfach algorithm.
+         *
+         * If several decimals of the shortest length qualify, the one closest to the exact value is chosen.
+         * The mantissa has no trailing zeros.
+         */
+        template<typename T>
+        DecimalLiteral to_decimal(T value)
+        {
+            using format = binary_format<T>;
+            using bits_type = typename format::bits_type;
+
+            constexpr int exponent_bias = -format::minimum_exponent + format::mantissa_explicit_bits;
+            constexpr bits_type hidden_bit = bits_type(1) << format::mantissa_explicit_bits;
+
+            bits_type bits;
+            std::memcpy(&bits, &value, sizeof(T));
+
+            DecimalLiteral decimal;
+            decimal.negative = (bits >> format::sign_index) != 0;
+            const bits_type significand = bits & (hidden_bit - 1);
+            const int biased_exponent = static_cast<int>((bits >> format::mantissa_explicit_bits) & format::infinite_power);
+
+            bits_type c;
+            int q;
+            if (biased_exponent != 0) {
+                c = hidden_bit | significand;
+                q = biased_exponent - exponent_bias;
+
+                // integers in the range of the mantissa need no conversion
+                if (q <= 0 && -q <= format::mantissa_explicit_bits) {
+                    const bits_type mask = (bits_type(1) << -q) - 1;
+                    if ((c & mask) == 0) {
+                        decimal.mantissa = c >> -q;
+                        remove_trailing_zeros(decimal);
+                        return decimal;
+                    }
+                }
+            } else {
+                if (significand == 0) {
+                    return decimal;
+                }
+                c = significand;
+                q = 1 - exponent_bias;
+            }
+
+            const bool is_even = (c & 1) == 0;
+            const bool lower_boundary_is_closer = significand == 0 && biased_exponent > 1;
+
+            // boundaries of the rounding interval, and the value itself, scaled by 4
+            const bits_type cbl = 4 * c - 2 + lower_boundary_is_closer;
+            const bits_type cb = 4 * c;
+            const bits_type cbr = 4 * c + 2;
+
+            const int k = lower_boundary_is_closer ? floor_log10_three_quarters_pow2(q) : floor_log10_pow2(q);
+            const int h = q + floor_log2_pow10(-k) + 1;
+
+            const auto g = schubfach_multiplier<T>(-k);
+            const bits_type vbl = round_to_odd(g, static_cast<bits_type>(cbl << h));
+            const bits_type vb = round_to_odd(g, static_cast<bits_type>(cb << h));
+            const bits_type vbr = round_to_odd(g, static_cast<bits_type>(cbr << h));
+
+            const bits_type lower = vbl + !is_even;
+            const bits_type upper = vbr - !is_even;
+
+            // try a decimal with one digit less than the precision of the interval
+            const bits_type s = vb / 4;
+            if (s >= 10) {
+                const bits_type sp = s / 10;
+                const bool up_inside = lower <= 40 * sp;
+                const bool wp_inside = 40 * sp + 40 <= upper;
+                if (up_inside != wp_inside) {
+                    decimal.mantissa = sp + wp_inside;
+                    decimal.exponent = k + 1;
+                    remove_trailing_zeros(decimal);
+                    return decimal;
+                }
+            }
+
+            const bool u_inside = lower <= 4 * s;
+            const bool w_inside = 4 * s + 4 <= upper;
+            if (u_inside != w_inside) {
+                decimal.mantissa = s + w_inside;
+                decimal.exponent = k;
+                remove_trailing_zeros(decimal);
+                return decimal;
+            }
+
+            // both candidates are inside the interval, pick the closer, with ties to even
+            const bits_type mid = 4 * s + 2;
+            const bool round_up = vb > mid || (vb == mid && (s & 1) != 0);
+            decimal.mantissa = s + round_up;
+            decimal.exponent = k;
+            remove_trailing_zeros(decimal);
+            return decimal;
+        }
+
+        /** Rounds a decimal to drop a number of its least significant digits, with ties away from zero. */
+        inline void drop_digits(DecimalLiteral& decimal, int count)
+        {
+            if (count <= 0) {
+                return;
+            }
+
+            if (count > decimal_length(decimal.mantissa)) {
+                decimal.mantissa = 0;
+            } else {
+                std::uint64_t divisor = 1;
+                for (int k = 0; k < count; ++k) {
+                    divisor *= 10;
+                }
+                std::uint64_t remainder = decimal.mantissa % divisor;
+                decimal.mantissa = decimal.mantissa / divisor + (remainder >= divisor / 2);
+            }
+
+            if (decimal.mantissa == 0) {
+                decimal = DecimalLiteral();
+            } else {
+                decimal.exponent += count;
+                remove_trailing_zeros(decimal);
+            }
+        }
+
+        /** Rounds a decimal to the precision a number format permits. */
+        inline void round_decimal(DecimalLiteral& decimal, const NumberFormat& format)
+        {
+            if (format.significant_digits >= 0) {
+                drop_digits(decimal, decimal_length(decimal.mantissa) - format.significant_digits);
+            }
+            if (format.decimal_places >= 0) {
+                drop_digits(decimal, static_cast<int>(-decimal.exponent) - format.decimal_places);
+            }
+        }
+
+        /**
+         * Writes a decimal number in the notation RapidJSON uses: fixed notation with at least one fractional
+         * digit for decimal exponents in the range [-6, 21), and scientific notation otherwise.
+         *
+         * @return The position past the last character written.
+         */
+        inline char* write_decimal(const DecimalLiteral& decimal, char* buffer)
+        {
+            if (decimal.negative) {
+                *buffer++ = '-';
+            }
+
+            if (decimal.mantissa == 0) {
+                std::memcpy(buffer, "0.0", 3);
+                return buffer + 3;
+            }
+
+            const int length = decimal_length(decimal.mantissa);
+            const int k = static_cast<int>(decimal.exponent);
+            const int kk = length + k;  // 10^(kk-1) <= value < 10^kk
+
+            if (0 <= k && kk <= 21) {
+                // 1234e7 -> 12340000000.0
+                write_digits(decimal.mantissa, buffer + length);
+                std::memset(buffer + length, '0', static_cast<std::size_t>(k));
+                buffer[kk] = '.';
+                buffer[kk + 1] = '0';
+                return buffer + kk + 2;
+            } else if (0 < kk && kk <= 21) {
+                // 1234e-2 -> 12.34
+                write_digits(decimal.mantissa, buffer + length + 1);
+                std::memmove(buffer, buffer + 1, static_cast<std::size_t>(kk));
+                buffer[kk] = '.';
+                return buffer + length + 1;
+            } else if (-6 < kk && kk <= 0) {
+                // 1234e-6 -> 0.001234
+                const int offset = 2 - kk;
+                buffer[0] = '0';
+                buffer[1] = '.';
+                std::memset(buffer + 2, '0', static_cast<std::size_t>(-kk));
+                write_digits(decimal.mantissa, buffer + offset + length);
+                return buffer + offset + length;
+            }
+
+            // 1234e30 -> 1.234e33
+            char* p;
+            if (length == 1) {
+                buffer[0] = static_cast<char>('0' + decimal.mantissa);
+                p = buffer + 1;
+            } else {
+                write_digits(decimal.mantissa, buffer + length + 1);
+                buffer[0] = buffer[1];
+                buffer[1] = '.';
+                p = buffer + length + 1;
+            }
+            *p++ = 'e';
+            int exponent = kk - 1;
+            if (exponent < 0) {
+                *p++ = '-';
+                exponent = -exponent;
+            }
+            const int exponent_length = decimal_length(static_cast<std::uint64_t>(exponent));
+            write_digits(static_cast<std::uint64_t>(exponent), p + exponent_length);
+            return p + exponent_length;
+        }
+
+        /**
+         * Writes the shortest representation of a finite floating-point number that reads back as the same number.
+         *
+         * Shortest is relative to the type: `0.1f` is written as `0.1`, not as the digits of its `double` value.
+         *
+         * @param buffer A buffer of at least `max_float_length` characters.
+         * @return The position past the last character written.
+         */
+        template<typename T>
+        char* format_float(T value, char* buffer)
+        {
+            static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "expected a float or double");
+            return write_decimal(to_decimal(value), buffer);
+        }
+
+        /**
+         * Writes a finite floating-point number rounded to the precision a number format permits.
+         *
+         * @param buffer A buffer of at least `max_float_length` characters.
+         * @return The position past the last character written.
+         */
+        template<typename T>
+        char* format_float(T value, const NumberFormat& format, char* buffer)
+        {
+            static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "expected a float or double");
+            DecimalLiteral decimal = to_decimal(value);
+            round_decimal(decimal, format);
+            return write_decimal(decimal, buffer);
+        }
+    }
+}
@@ -0,0 +1,412 @@
+#pragma once
+#include "power_of_five.hpp"
+#include "unlikely.hpp"
+#include <cfloat>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace persistence
+{
+    namespace detail
+    {
+        /**
+         * A decimal floating-point number `(-1)^negative * mantissa * 10^exponent`.
+         *
+         * At most 19 significant digits are kept in the mantissa; if further non-zero digits are present in the
+         * input, the number is marked as truncated.
+         */
+        struct DecimalLiteral
+        {
+            std::uint64_t mantissa = 0;
+            std::int64_t exponent = 0;
+            bool negative = false;
+            bool truncated = false;
+        };
+
+        /** Maximum number of decimal digits that always fit into a 64-bit unsigned integer. */
+        constexpr int max_mantissa_digits = 19;
+
+        inline bool is_decimal_digit(char c)
+        {
+            return static_cast<unsigned char>(c - '0') < 10;
+        }
+
+        /**
+         * Splits a JSON number literal into a decimal mantissa and exponent.
+         *
+         * Does not depend on the current locale, and reads no characters beyond the given range.
+         */
+        inline bool parse_decimal(const char* first, const char* last, DecimalLiteral& literal)
+        {
+            const char* p = first;
+            if (p != last && *p == '-') {
+                literal.negative = true;
+                ++p;
+            }
+
+            int digits = 0;
+            bool has_digits = false;
+
+            // integer part, digits beyond the mantissa capacity scale the number up
+            for (; p != last && is_decimal_digit(*p); ++p) {
+                has_digits = true;
+                if (digits < max_mantissa_digits) {
+                    literal.mantissa = 10 * literal.mantissa + static_cast<std::uint64_t>(*p - '0');
+                    digits += literal.mantissa != 0;
+                } else {
+                    ++literal.exponent;
+                    literal.truncated = literal.truncated || *p != '0';
+                }
+            }
+
+            // fractional part, digits beyond the mantissa capacity are dropped
+            if (p != last && *p == '.') {
+                ++p;
+                for (; p != last && is_decimal_digit(*p); ++p) {
+                    has_digits = true;
+                    if (digits < max_mantissa_digits) {
+                        literal.mantissa = 10 * literal.mantissa + static_cast<std::uint64_t>(*p - '0');
+                        digits += literal.mantissa != 0;
+                        --literal.exponent;
+                    } else {
+                        literal.truncated = literal.truncated || *p != '0';
+                    }
+                }
+            }
+
+            PERSISTENCE_IF_UNLIKELY(!has_digits) {
+                return false;
+            }
+
+            if (p != last && (*p == 'e' || *p == 'E')) {
+                ++p;
+                bool negative_exponent = false;
+                if (p != last && (*p == '-' || *p == '+')) {
+                    negative_exponent = *p == '-';
+                    ++p;
+                }
+
+                PERSISTENCE_IF_UNLIKELY(p == last || !is_decimal_digit(*p)) {
+                    return false;
+                }
+
+                // saturate such that the exponent cannot overflow; the value is zero or infinity anyway
+                std::int64_t exponent = 0;
+                for (; p != last && is_decimal_digit(*p); ++p) {
+                    if (exponent < 0x10000000) {
+                        exponent = 10 * exponent + (*p - '0');
+                    }
+                }
+                literal.exponent += negative_exponent ? -exponent : exponent;
+            }
+
+            return p == last;
+        }
+
+        /** Parameters of IEEE 754 binary floating-point formats. */
+        template<typename T>
+        struct binary_format;
+
+        template<>
+        struct binary_format<double>
+        {
+            using bits_type = std::uint64_t;
+
+            constexpr static int mantissa_explicit_bits = 52;
+            constexpr static int minimum_exponent = -1023;
+            constexpr static int infinite_power = 0x7FF;
+            constexpr static int sign_index = 63;
+            constexpr static int smallest_power_of_ten = -342;
+            constexpr static int largest_power_of_ten = 308;
+            constexpr static int min_exponent_round_to_even = -4;
+            constexpr static int max_exponent_round_to_even = 23;
+            constexpr static int max_exponent_fast_path = 22;
+            constexpr static std::uint64_t max_mantissa_fast_path = std::uint64_t(2) << mantissa_explicit_bits;
+
+            static double exact_power_of_ten(std::int64_t power)
+            {
+                constexpr static double powers[] = {
+                    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+                };
+                return powers[power];
+            }
+        };
+
+        template<>
+        struct binary_format<float>
+        {
+            using bits_type = std::uint32_t;
+
+            constexpr static int mantissa_explicit_bits = 23;
+            constexpr static int minimum_exponent = -127;
+            constexpr static int infinite_power = 0xFF;
+            constexpr static int sign_index = 31;
+            constexpr static int smallest_power_of_ten = -65;
+            constexpr static int largest_power_of_ten = 38;
+            constexpr static int min_exponent_round_to_even = -17;
+            constexpr static int max_exponent_round_to_even = 10;
+            constexpr static int max_exponent_fast_path = 10;
+            constexpr static std::uint64_t max_mantissa_fast_path = std::uint64_t(2) << mantissa_explicit_bits;
+
+            static float exact_power_of_ten(std::int64_t power)
+            {
+                constexpr static float powers[] = {
+                    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+                };
+                return powers[power];
+            }
+        };
+
+        /** A binary floating-point number as a biased exponent and an explicit mantissa. */
+        struct AdjustedMantissa
+        {
+            std::uint64_t mantissa = 0;
+            int power2 = 0;
+
+            bool operator==(const AdjustedMantissa& op) const
+            {
+                return mantissa == op.mantissa && power2 == op.power2;
+            }
+
+            bool operator!=(const AdjustedMantissa& op) const
+            {
+                return !(*this == op);
+            }
+        };
+
+        struct Value128
+        {
+            std::uint64_t low;
+            std::uint64_t high;
+        };
+
+        inline int leading_zeroes(std::uint64_t value)
+        {
+#if defined(__GNUC__)
+            return __builtin_clzll(value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+            unsigned long index;
+            _BitScanReverse64(&index, value);
+            return 63 - static_cast<int>(index);
+#else
+            int count = 0;
+            for (std::uint64_t bit = std::uint64_t(1) << 63; (value & bit) == 0; bit >>= 1) {
+                ++count;
+            }
+            return count;
+#endif
+        }
+
+        inline Value128 full_multiplication(std::uint64_t a, std::uint64_t b)
+        {
+            Value128 answer;
+#if defined(__SIZEOF_INT128__)
+            __extension__ typedef unsigned __int128 uint128_t;
+            uint128_t r = static_cast<uint128_t>(a) * b;
+            answer.low = static_cast<std::uint64_t>(r);
+            answer.high = static_cast<std::uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+            answer.low = _umul128(a, b, &answer.high);
+#else
+            std::uint64_t a_lo = a & 0xFFFFFFFF, a_hi = a >> 32;
+            std::uint64_t b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+            std::uint64_t lo_lo = a_lo * b_lo;
+            std::uint64_t hi_lo = a_hi * b_lo;
+            std::uint64_t lo_hi = a_lo * b_hi;
+            std::uint64_t hi_hi = a_hi * b_hi;
+            std::uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+            answer.high = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+            answer.low = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+#endif
+            return answer;
+        }
+
+        /**
+         * Computes the product of a normalized mantissa and a power of five, truncated to 128 bits, with enough
+         * correct leading bits to determine the binary mantissa.
+         */
+        template<int BitPrecision>
+        Value128 compute_product_approximation(std::int64_t q, std::uint64_t w)
+        {
+            const std::size_t index = 2 * static_cast<std::size_t>(q - smallest_power_of_five);
+            constexpr std::uint64_t precision_mask = ~std::uint64_t(0) >> BitPrecision;
+
+            Value128 first_product = full_multiplication(w, power_of_five_128[index]);
+            if ((first_product.high & precision_mask) == precision_mask) {
+                Value128 second_product = full_multiplication(w, power_of_five_128[index + 1]);
+                first_product.low += second_product.high;
+                if (second_product.high > first_product.low) {
+                    ++first_product.high;
+                }
+            }
+            return first_product;
+        }
+
+        /** Computes `floor(log2(10^q)) + 63` for decimal exponents in the supported range. */
+        inline int binary_power(int q)
+        {
+            return (((152170 + 65536) * q) >> 16) + 63;
+        }
+
+        /**
+         * Converts `w * 10^q` into a binary floating-point number with the Eisel-Lemire algorithm.
+         *
+         * The result is correctly rounded (round to nearest, ties to even) for an exact decimal mantissa `w`.
+         */
+        template<typename T>
+        AdjustedMantissa compute_float(std::int64_t q, std::uint64_t w)
+        {
+            using format = binary_format<T>;
+
+            AdjustedMantissa answer;
+            if (w == 0 || q < format::smallest_power_of_ten) {
+                return answer;
+            }
+            if (q > format::largest_power_of_ten) {
+                answer.power2 = format::infinite_power;
+                return answer;
+            }
+
+            int lz = leading_zeroes(w);
+            w <<= lz;
+
+            Value128 product = compute_product_approximation<format::mantissa_explicit_bits + 3>(q, w);
+            int upper_bit = static_cast<int>(product.high >> 63);
+            int shift = upper_bit + 64 - format::mantissa_explicit_bits - 3;
+
+            answer.mantissa = product.high >> shift;
+            answer.power2 = binary_power(static_cast<int>(q)) + upper_bit - lz - format::minimum_exponent;
+
+            if (answer.power2 <= 0) {
+                // subnormal number
+                if (-answer.power2 + 1 >= 64) {
+                    answer.mantissa = 0;
+                    answer.power2 = 0;
+                    return answer;
+                }
+
+                answer.mantissa >>= -answer.power2 + 1;
+                answer.mantissa += (answer.mantissa & 1);
+                answer.mantissa >>= 1;
+                answer.power2 = (answer.mantissa < (std::uint64_t(1) << format::mantissa_explicit_bits)) ? 0 : 1;
+                return answer;
+            }
+
+            // exactly half-way between two floating-point numbers, which calls for rounding to even
+            if (product.low <= 1 && q >= format::min_exponent_round_to_even && q <= format::max_exponent_round_to_even && (answer.mantissa & 3) == 1) {
+                if ((answer.mantissa << shift) == product.high) {
+                    answer.mantissa &= ~std::uint64_t(1);
+                }
+            }
+
+            answer.mantissa += (answer.mantissa & 1);
+            answer.mantissa >>= 1;
+            if (answer.mantissa >= (std::uint64_t(2) << format::mantissa_explicit_bits)) {
+                answer.mantissa = std::uint64_t(1) << format::mantissa_explicit_bits;
+                ++answer.power2;
+            }
+
+            answer.mantissa &= ~(std::uint64_t(1) << format::mantissa_explicit_bits);
+            if (answer.power2 >= format::infinite_power) {
+                answer.mantissa = 0;
+                answer.power2 = format::infinite_power;
+            }
+            return answer;
+        }
+
+        template<typename T>
+        T to_float(bool negative, const AdjustedMantissa& am)
+        {
+            using format = binary_format<T>;
+            using bits_type = typename format::bits_type;
+
+            bits_type bits = static_cast<bits_type>(am.mantissa)
+                | (static_cast<bits_type>(am.power2) << format::mantissa_explicit_bits)
+                | (static_cast<bits_type>(negative) << format::sign_index);
+
+            T value;
+            std::memcpy(&value, &bits, sizeof(T));
+            return value;
+        }
+
+        /** Parses a floating-point number with the standard library, used when the decimal mantissa is inexact. */
+        template<typename T>
+        bool parse_float_fallback(const char* first, const char* last, T& value)
+        {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+            auto result = std::from_chars(first, last, value);
+            return result.ec == std::errc() && result.ptr == last;
+#else
+            // copy ensures termination of the string, which `strtod` requires
+            std::string str(first, last);
+            char* end;
+            if constexpr (std::is_same_v<T, float>) {
+                value = std::strtof(str.c_str(), &end);
+            } else if constexpr (std::is_same_v<T, double>) {
+                value = std::strtod(str.c_str(), &end);
+            } else {
+                value = std::strtold(str.c_str(), &end);
+            }
+            return end == str.c_str() + str.size() && value != std::numeric_limits<T>::infinity() && value != -std::numeric_limits<T>::infinity();
+#endif
+        }
+
+        /**
+         * Parses a JSON number literal into a binary floating-point number, correctly rounded.
+         *
+         * Exact numbers that fit into the floating-point mantissa take the Clinger fast path. Otherwise, the number
+         * is converted with the Eisel-Lemire algorithm. Numbers with more than 19 significant digits fall back to
+         * the standard library only when the truncated mantissa leaves the result ambiguous.
+         *
+         * @return False if the literal is malformed or the value is out of range.
+         */
+        template<typename T>
+        bool parse_float(const char* first, const char* last, T& value)
+        {
+            using format = binary_format<T>;
+
+            DecimalLiteral literal;
+            PERSISTENCE_IF_UNLIKELY(!parse_decimal(first, last, literal)) {
+                return false;
+            }
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+            if (!literal.truncated && literal.mantissa <= format::max_mantissa_fast_path && literal.exponent >= -format::max_exponent_fast_path && literal.exponent <= format::max_exponent_fast_path) {
+                // both operands are exact, and IEEE 754 guarantees a correctly rounded result
+                value = static_cast<T>(literal.mantissa);
+                if (literal.exponent < 0) {
+                    value = value / format::exact_power_of_ten(-literal.exponent);
+                } else {
+                    value = value * format::exact_power_of_ten(literal.exponent);
+                }
+                if (literal.negative) {
+                    value = -value;
+                }
+                return true;
+            }
+#endif
+
+            AdjustedMantissa am = compute_float<T>(literal.exponent, literal.mantissa);
+            if (literal.truncated && am != compute_float<T>(literal.exponent, literal.mantissa + 1)) {
+                return parse_float_fallback(first, last, value);
+            }
+
+            PERSISTENCE_IF_UNLIKELY(am.power2 == format::infinite_power) {
+                return false;
+            }
+
+            value = to_float<T>(literal.negative, am);
+            return true;
+        }
+    }
+}
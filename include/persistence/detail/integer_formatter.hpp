@@ -0,0 +1,125 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace persistence
+{
+    namespace detail
+    {
+        /** Maximum number of characters in the decimal representation of a 64-bit integer, including the sign. */
+        constexpr std::size_t max_integer_length = 20;
+
+        /** Number of decimal digits in a 32-bit unsigned integer. */
+        inline int decimal_length(std::uint32_t value)
+        {
+            if (value < 100000) {
+                if (value < 100) {
+                    return value < 10 ? 1 : 2;
+                }
+                if (value < 1000) {
+                    return 3;
+                }
+                return value < 10000 ? 4 : 5;
+            }
+            if (value < 10000000) {
+                return value < 1000000 ? 6 : 7;
+            }
+            if (value < 1000000000) {
+                return value < 100000000 ? 8 : 9;
+            }
+            return 10;
+        }
+
+        /** Number of decimal digits in a 64-bit unsigned integer. */
+        inline int decimal_length(std::uint64_t value)
+        {
+            if (value <= 0xFFFFFFFF) {
+                return decimal_length(static_cast<std::uint32_t>(value));
+            }
+
+            int length = 10;
+            for (std::uint64_t bound = 10000000000; length < 20 && value >= bound; bound *= 10) {
+                ++length;
+            }
+            return length;
+        }
+
+        /** The decimal digits of the numbers 0 to 99, two characters each. */
+        inline constexpr char digit_pairs[] =
+            "00010203040506070809"
+            "10111213141516171819"
+            "20212223242526272829"
+            "30313233343536373839"
+            "40414243444546474849"
+            "50515253545556575859"
+            "60616263646566676869"
+            "70717273747576777879"
+            "80818283848586878889"
+            "90919293949596979899";
+
+        /** Writes a number less than 100 as exactly two digits. */
+        inline void write_two_digits(unsigned value, char* p)
+        {
+            std::memcpy(p, digit_pairs + 2 * value, 2);
+        }
+
+        template<typename U>
+        void write_digit_pairs(U value, char* last)
+        {
+            while (value >= 100) {
+                last -= 2;
+                std::memcpy(last, digit_pairs + 2 * (value % 100), 2);
+                value /= 100;
+            }
+            if (value >= 10) {
+                last -= 2;
+                std::memcpy(last, digit_pairs + 2 * value, 2);
+            } else {
+                *--last = static_cast<char>('0' + value);
+            }
+        }
+
+        /**
+         * Writes the decimal digits of an unsigned integer such that the last digit precedes the given position.
+         *
+         * Values that fit into 32 bits are converted with cheaper 32-bit divisions.
+         */
+        inline void write_digits(std::uint64_t value, char* last)
+        {
+            if (value <= 0xFFFFFFFF) {
+                write_digit_pairs(static_cast<std::uint32_t>(value), last);
+            } else {
+                write_digit_pairs(value, last);
+            }
+        }
+
+        /**
+         * Writes the decimal representation of an integer, two digits at a time.
+         *
+         * @param buffer A buffer of at least `max_integer_length` characters.
+         * @return The position past the last character written.
+         */
+        template<typename T>
+        char* format_integer(T value, char* buffer)
+        {
+            static_assert(std::is_integral_v<T>, "expected an integer type");
+
+            std::uint64_t magnitude;
+            if constexpr (std::is_signed_v<T>) {
+                if (value < 0) {
+                    *buffer++ = '-';
+                    magnitude = std::uint64_t(0) - static_cast<std::uint64_t>(value);
+                } else {
+                    magnitude = static_cast<std::uint64_t>(value);
+                }
+            } else {
+                magnitude = static_cast<std::uint64_t>(value);
+            }
+
+            const int length = decimal_length(magnitude);
+            write_digits(magnitude, buffer + length);
+            return buffer + length;
+        }
+    }
+}
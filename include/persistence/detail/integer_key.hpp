@@ -0,0 +1,51 @@
+#pragma once
+#include "integer_formatter.hpp"
+#include "integer_parser.hpp"
+#include <string_view>
+#include <type_traits>
+
+namespace persistence
+{
+    namespace detail
+    {
+        /** True if dictionaries with the key type are mapped to JSON objects whose keys are decimal integers. */
+        template<typename K>
+        inline constexpr bool is_integer_key_v =
+            std::is_integral_v<K> &&
+            !std::is_same_v<K, bool> &&
+            !std::is_same_v<K, char> &&
+            !std::is_same_v<K, wchar_t> &&
+            !std::is_same_v<K, char16_t> &&
+            !std::is_same_v<K, char32_t>;
+
+        /** The decimal representation of an integer dictionary key, formatted into a buffer on the stack. */
+        class IntegerKey
+        {
+        public:
+            template<typename K>
+            explicit IntegerKey(K key)
+                : size(static_cast<std::size_t>(format_integer(key, buffer) - buffer))
+            {}
+
+            std::string_view view() const
+            {
+                return std::string_view(buffer, size);
+            }
+
+        private:
+            char buffer[max_integer_length];
+            std::size_t size;
+        };
+
+        /**
+         * Parses a JSON object key as an integer dictionary key.
+         *
+         * @return False if the key is not a decimal integer, or its value is out of range for the key type.
+         */
+        template<typename K>
+        bool parse_integer_key(const std::string_view& str, K& key)
+        {
+            return parse_integer(str.data(), str.data() + str.size(), key);
+        }
+    }
+}
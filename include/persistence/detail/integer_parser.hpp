@@ -0,0 +1,135 @@
+#pragma once
+#include "endianness.hpp"
+#include "unlikely.hpp"
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace persistence
+{
+    namespace detail
+    {
+        /** Reads 8 characters as a 64-bit word with the first character in the least significant byte. */
+        inline std::uint64_t read_eight_chars(const char* p)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, p, sizeof(word));
+            if constexpr (endianness::native == endianness::big) {
+                word = ((word & 0x00000000FFFFFFFFull) << 32) | ((word & 0xFFFFFFFF00000000ull) >> 32);
+                word = ((word & 0x0000FFFF0000FFFFull) << 16) | ((word & 0xFFFF0000FFFF0000ull) >> 16);
+                word = ((word & 0x00FF00FF00FF00FFull) << 8) | ((word & 0xFF00FF00FF00FF00ull) >> 8);
+            }
+            return word;
+        }
+
+        /** True if all 8 characters packed in a word are decimal digits. */
+        inline bool is_eight_digits(std::uint64_t word)
+        {
+            return ((word & 0xF0F0F0F0F0F0F0F0ull) | (((word + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+        }
+
+        /**
+         * Converts 8 decimal digits packed in a word into an integer with SIMD within a register (SWAR).
+         *
+         * Each step combines adjacent groups of digits: single digits into pairs, pairs into quadruples, and
+         * quadruples into the final value, with a single multiplication per step.
+         */
+        inline std::uint32_t parse_eight_digits(std::uint64_t word)
+        {
+            word = ((word & 0x0F0F0F0F0F0F0F0Full) * 2561) >> 8;
+            word = ((word & 0x00FF00FF00FF00FFull) * 6553601) >> 16;
+            return static_cast<std::uint32_t>(((word & 0x0000FFFF0000FFFFull) * 42949672960001ull) >> 32);
+        }
+
+        /** Parses a non-empty sequence of decimal digits into an unsigned 64-bit integer, rejecting overflow. */
+        inline bool parse_digits(const char* first, const char* last, std::uint64_t& value)
+        {
+            PERSISTENCE_IF_UNLIKELY(first == last) {
+                return false;
+            }
+
+            while (first != last && *first == '0') {
+                ++first;
+            }
+
+            // up to 19 digits always fit, 20 digits might, more digits never do
+            std::size_t count = static_cast<std::size_t>(last - first);
+            PERSISTENCE_IF_UNLIKELY(count > 20) {
+                return false;
+            }
+            const char* stop = count == 20 ? last - 1 : last;
+
+            std::uint64_t result = 0;
+            const char* p = first;
+            for (; stop - p >= 8; p += 8) {
+                std::uint64_t word = read_eight_chars(p);
+                PERSISTENCE_IF_UNLIKELY(!is_eight_digits(word)) {
+                    return false;
+                }
+                result = 100000000 * result + parse_eight_digits(word);
+            }
+            for (; p != stop; ++p) {
+                std::uint64_t digit = static_cast<unsigned char>(*p - '0');
+                PERSISTENCE_IF_UNLIKELY(digit > 9) {
+                    return false;
+                }
+                result = 10 * result + digit;
+            }
+
+            if (count == 20) {
+                std::uint64_t digit = static_cast<unsigned char>(*p - '0');
+                PERSISTENCE_IF_UNLIKELY(digit > 9 || result > (std::numeric_limits<std::uint64_t>::max() - digit) / 10) {
+                    return false;
+                }
+                result = 10 * result + digit;
+            }
+
+            value = result;
+            return true;
+        }
+
+        /**
+         * Parses a JSON integer literal directly into an integer type of any width.
+         *
+         * @return False if the literal is malformed or the value is out of range for the integer type.
+         */
+        template<typename T>
+        bool parse_integer(const char* first, const char* last, T& value)
+        {
+            static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "expected an integer type");
+
+            bool negative = false;
+            if constexpr (std::is_signed_v<T>) {
+                if (first != last && *first == '-') {
+                    negative = true;
+                    ++first;
+                }
+            }
+
+            std::uint64_t magnitude;
+            PERSISTENCE_IF_UNLIKELY(!parse_digits(first, last, magnitude)) {
+                return false;
+            }
+
+            if constexpr (std::is_signed_v<T>) {
+                if (negative) {
+                    PERSISTENCE_IF_UNLIKELY(magnitude > static_cast<std::uint64_t>(std::numeric_limits<T>::max()) + 1) {
+                        return false;
+                    }
+
+                    // avoid negating the magnitude of the smallest value, which is not representable
+                    value = magnitude == 0 ? T(0) : static_cast<T>(-static_cast<std::int64_t>(magnitude - 1) - 1);
+                    return true;
+                }
+            }
+
+            PERSISTENCE_IF_UNLIKELY(magnitude > static_cast<std::uint64_t>(std::numeric_limits<T>::max())) {
+                return false;
+            }
+
+            value = static_cast<T>(magnitude);
+            return true;
+        }
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "traits.hpp"
+
+namespace persistence
+{
+    /**
+     * Precision of a floating-point value when written to JSON.
+     *
+     * Values are rounded from their shortest round-trip representation, with ties away from zero.
+     */
+    struct NumberFormat
+    {
+        /** Maximum number of digits after the decimal point, or -1 for no limit. */
+        int decimal_places = -1;
+
+        /** Maximum number of significant digits, or -1 for no limit. */
+        int significant_digits = -1;
+
+        /** True if the format limits precision. */
+        constexpr explicit operator bool() const
+        {
+            return decimal_places >= 0 || significant_digits >= 0;
+        }
+    };
+
+    namespace detail
+    {
+        /**
+         * Member descriptor that extends another descriptor with a number format.
+         *
+         * @tparam Descriptor Structure that provides compile-time access to the member name as a string literal.
+         */
+        template<typename Descriptor, int DecimalPlaces, int SignificantDigits>
+        struct formatted_member_descriptor : Descriptor
+        {
+            constexpr static NumberFormat number_format = { DecimalPlaces, SignificantDigits };
+        };
+
+        template<typename Descriptor>
+        using number_format_member = decltype(Descriptor::number_format);
+
+        /** The number format a member descriptor specifies, or a format that does not limit precision. */
+        template<typename Descriptor>
+        constexpr NumberFormat number_format_of()
+        {
+            if constexpr (detect<Descriptor, number_format_member>::value) {
+                return Descriptor::number_format;
+            } else {
+                return NumberFormat();
+            }
+        }
+    }
+}
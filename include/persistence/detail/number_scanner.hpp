@@ -0,0 +1,175 @@
+#pragma once
+#include "float_parser.hpp"
+#include "unlikely.hpp"
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace persistence
+{
+    namespace detail
+    {
+        inline bool is_json_whitespace(char c)
+        {
+            return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+        }
+
+        inline const char* skip_json_whitespace(const char* p)
+        {
+            while (is_json_whitespace(*p)) {
+                ++p;
+            }
+            return p;
+        }
+
+        /**
+         * Finds the end of a JSON number literal in a null-terminated string, validating it against the JSON grammar.
+         *
+         * @param integral Set to true if the literal has neither a fractional part nor an exponent.
+         * @return The position past the literal, or null if no valid literal starts at the given position.
+         */
+        inline const char* scan_number(const char* p, bool& integral)
+        {
+            if (*p == '-') {
+                ++p;
+            }
+            if (*p == '0') {
+                ++p;
+            } else if (static_cast<unsigned char>(*p - '1') < 9) {
+                ++p;
+                while (is_decimal_digit(*p)) {
+                    ++p;
+                }
+            } else {
+                return nullptr;
+            }
+
+            integral = true;
+            if (*p == '.') {
+                ++p;
+                PERSISTENCE_IF_UNLIKELY(!is_decimal_digit(*p)) {
+                    return nullptr;
+                }
+                while (is_decimal_digit(*p)) {
+                    ++p;
+                }
+                integral = false;
+            }
+            if (*p == 'e' || *p == 'E') {
+                ++p;
+                if (*p == '+' || *p == '-') {
+                    ++p;
+                }
+                PERSISTENCE_IF_UNLIKELY(!is_decimal_digit(*p)) {
+                    return nullptr;
+                }
+                while (is_decimal_digit(*p)) {
+                    ++p;
+                }
+                integral = false;
+            }
+            return p;
+        }
+
+        inline bool is_number_char(char c)
+        {
+            return is_decimal_digit(c) || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+        }
+
+        /**
+         * Finds the start of a JSON number literal that ends at a given position, such as a literal just consumed by
+         * the reader.
+         *
+         * @param first The start of the input, which bounds the search.
+         * @param last The position past the literal.
+         */
+        inline const char* find_number_start(const char* first, const char* last)
+        {
+            const char* p = last;
+            while (p != first && is_number_char(p[-1])) {
+                --p;
+            }
+            return p;
+        }
+
+        /**
+         * Reads a JSON integer literal in a null-terminated string directly into an integer type, computing the value
+         * while digits are scanned.
+         *
+         * @return The position past the literal, or null if no integer literal starts at the given position, the
+         * literal has a fractional part or exponent, or the value is out of range for the integer type.
+         */
+        template<typename T>
+        const char* scan_integer(const char* p, T& value)
+        {
+            bool negative = false;
+            if constexpr (std::is_signed_v<T>) {
+                if (*p == '-') {
+                    negative = true;
+                    ++p;
+                }
+            }
+
+            std::uint64_t magnitude = static_cast<unsigned char>(*p - '0');
+            PERSISTENCE_IF_UNLIKELY(magnitude > 9) {
+                return nullptr;
+            }
+            ++p;
+            if (magnitude != 0) {
+                // up to 19 digits always fit, the 20th digit might
+                int count = 1;
+                std::uint64_t digit;
+                for (; count != 19 && (digit = static_cast<unsigned char>(*p - '0')) <= 9; ++count) {
+                    magnitude = 10 * magnitude + digit;
+                    ++p;
+                }
+                if (count == 19 && (digit = static_cast<unsigned char>(*p - '0')) <= 9) {
+                    PERSISTENCE_IF_UNLIKELY(magnitude > (std::numeric_limits<std::uint64_t>::max() - digit) / 10) {
+                        return nullptr;
+                    }
+                    magnitude = 10 * magnitude + digit;
+                    ++p;
+                }
+            }
+
+            // a fractional part, an exponent, a leading zero, or more than 20 digits
+            PERSISTENCE_IF_UNLIKELY(*p == '.' || *p == 'e' || *p == 'E' || is_decimal_digit(*p)) {
+                return nullptr;
+            }
+
+            if constexpr (std::is_signed_v<T>) {
+                if (negative) {
+                    PERSISTENCE_IF_UNLIKELY(magnitude > static_cast<std::uint64_t>(std::numeric_limits<T>::max()) + 1) {
+                        return nullptr;
+                    }
+                    value = magnitude == 0 ? T(0) : static_cast<T>(-static_cast<std::int64_t>(magnitude - 1) - 1);
+                    return p;
+                }
+            }
+
+            PERSISTENCE_IF_UNLIKELY(magnitude > static_cast<std::uint64_t>(std::numeric_limits<T>::max())) {
+                return nullptr;
+            }
+            value = static_cast<T>(magnitude);
+            return p;
+        }
+
+        /**
+         * Converts a JSON number literal found by `scan_number` into a floating-point number.
+         *
+         * Integer literals with more digits than the floating-point type represents exactly are rejected, such that
+         * the result is certain to agree with parsing the literal as a JSON token.
+         */
+        template<typename T>
+        bool convert_scanned_float(const char* first, const char* last, bool integral, T& value)
+        {
+            if (integral) {
+                const auto digits = last - first - (*first == '-');
+                PERSISTENCE_IF_UNLIKELY(digits > std::numeric_limits<T>::digits10) {
+                    return false;
+                }
+            }
+            return parse_float(first, last, value);
+        }
+    }
+}
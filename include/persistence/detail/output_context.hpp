@@ -1,13 +1,19 @@
 #pragma once
 #include "references.hpp"
 #include "segment.hpp"
-#include <memory>
+#include "path_tree.hpp"
+#include <optional>
+#include <string>
 
 namespace persistence
 {
     struct WriterReferenceContext
     {
-        ReferenceTable<std::shared_ptr<void>, Segments> references;
+        /** Maps objects already written to the node that identifies their first occurrence. */
+        ReferenceTable<PathTree::node_id> references;
+
+        /** Paths of objects already written, shared by common prefix. */
+        PathTree paths;
     };
 
     template<typename GlobalContext>
@@ -16,22 +22,31 @@ namespace persistence
         OutputContext(GlobalContext& global)
             : global_context(global)
             , parent_context(nullptr)
+            , node(PathTree::root)
         {}
 
         OutputContext(OutputContext<GlobalContext>& local, Segment segment)
             : global_context(local.global_context)
             , parent_context(&local)
             , segment(segment)
+            , node(PathTree::none)
         {}
 
-        std::optional<Segments> get(const std::shared_ptr<void>& pointer) const
+        /** Returns the JSON Pointer to the first occurrence of an object already written, if any. */
+        std::optional<std::string> get(const void* pointer) const
         {
-            return global_context.references.get(pointer);
+            const PathTree::node_id* id = global_context.references.get(pointer);
+            if (id) {
+                return global_context.paths.str(*id);
+            } else {
+                return std::nullopt;
+            }
         }
 
-        void put(std::shared_ptr<void> pointer)
+        /** Records the current location as the first occurrence of an object. */
+        void put(const void* pointer)
         {
-            global_context.references.put(std::move(pointer), segments());
+            global_context.references.put(pointer, intern());
         }
 
         GlobalContext& global()
@@ -51,8 +66,18 @@ namespace persistence
         }
 
     private:
+        /** Assigns a node in the path tree to this context and all its ancestors that do not have one yet. */
+        PathTree::node_id intern()
+        {
+            if (node == PathTree::none) {
+                node = global_context.paths.add(parent_context->intern(), segment);
+            }
+            return node;
+        }
+
         GlobalContext& global_context;
         OutputContext<GlobalContext>* parent_context;
         Segment segment;
+        PathTree::node_id node;
     };
 }
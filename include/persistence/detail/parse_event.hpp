@@ -1,4 +1,7 @@
 #pragma once
+#include "parse_path.hpp"
+#include "unlikely.hpp"
+#include "utf8_simd.hpp"
 #include <string_view>
 
 namespace persistence
@@ -135,74 +138,117 @@ namespace persistence
     {
         bool Int(int value)
         {
+            path.value();
             return handler->parse(JsonValueInteger(value));
         }
 
         bool Uint(unsigned int value)
         {
+            path.value();
             return handler->parse(JsonValueUnsigned(value));
         }
 
         bool Int64(std::int64_t value)
         {
+            path.value();
             return handler->parse(JsonValueInteger64(value));
         }
 
         bool Uint64(std::uint64_t value)
         {
+            path.value();
             return handler->parse(JsonValueUnsigned64(value));
         }
 
         bool Double(double value)
         {
+            path.value();
             return handler->parse(JsonValueDouble(value));
         }
 
         bool Null()
         {
+            path.value();
             return handler->parse(JsonValueNull());
         }
 
         bool Bool(bool value)
         {
+            path.value();
             return handler->parse(JsonValueBoolean(value));
         }
 
         bool RawNumber(const char* str, std::size_t length, bool /*copy*/)
         {
+            path.value();
             return handler->parse(JsonValueNumber(str, length));
         }
 
         bool String(const char* str, std::size_t length, bool /*copy*/)
         {
+            path.value();
+            PERSISTENCE_IF_UNLIKELY(!is_valid_string(str, length)) {
+                return false;
+            }
             return handler->parse(JsonValueString(str, length));
         }
 
         bool StartObject()
         {
-            return handler->parse(JsonObjectStart());
+            path.value();
+            bool result = handler->parse(JsonObjectStart());
+            path.start_object();
+            return result;
         }
 
         bool Key(const char* str, std::size_t length, bool /*copy*/)
         {
+            PERSISTENCE_IF_UNLIKELY(!is_valid_string(str, length)) {
+                return false;
+            }
+            path.key(str, length);
             return handler->parse(JsonObjectKey(str, length));
         }
 
         bool EndObject(std::size_t /*memberCount*/)
         {
+            path.end();
             return handler->parse(JsonObjectEnd());
         }
 
         bool StartArray()
         {
-            return handler->parse(JsonArrayStart());
+            path.value();
+            bool result = handler->parse(JsonArrayStart());
+            path.start_array();
+            return result;
         }
 
         bool EndArray(std::size_t /*elementCount*/)
         {
+            path.end();
             return handler->parse(JsonArrayEnd());
         }
 
         JsonParseEvent* handler = nullptr;
+
+        /** True if string values and object keys are validated as UTF-8 as they are delivered. */
+        bool validate_utf8 = false;
+
+        /** Set when a string value or object key has been rejected as ill-formed UTF-8. */
+        bool invalid_utf8 = false;
+
+        /** Location of the value being parsed, used for resolving back-references. */
+        JsonPathTracker path;
+
+    private:
+        bool is_valid_string(const char* str, std::size_t length)
+        {
+            if (validate_utf8 && !detail::utf8_validate(str, length)) {
+                invalid_utf8 = true;
+                return false;
+            }
+            return true;
+        }
     };
 }
@@ -0,0 +1,110 @@
+#pragma once
+#include <charconv>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace persistence
+{
+    /**
+     * Tracks the location of the JSON value being parsed as a sequence of object keys and array indices.
+     *
+     * Storage for nesting levels is retained when a level is left such that key names of subsequent siblings
+     * can be copied without dynamic memory allocation. Tracking may be switched off when no value needs its location,
+     * which spares copying every object key.
+     */
+    struct JsonPathTracker
+    {
+        /** True if the location is tracked. */
+        bool enabled = true;
+
+        /** Signals the start of a value, which advances the index when inside an array. */
+        void value()
+        {
+            if (enabled && depth > 0) {
+                Level& level = levels[depth - 1];
+                if (level.is_array) {
+                    ++level.index;
+                }
+            }
+        }
+
+        /** Enters an object, whose member values are identified by key. */
+        void start_object()
+        {
+            if (enabled) {
+                push(false);
+            }
+        }
+
+        /** Enters an array, whose element values are identified by index. */
+        void start_array()
+        {
+            if (enabled) {
+                push(true);
+            }
+        }
+
+        /** Leaves the object or array last entered. */
+        void end()
+        {
+            if (enabled) {
+                --depth;
+            }
+        }
+
+        /** Records the key of the object member whose value comes next. */
+        void key(const char* str, std::size_t len)
+        {
+            if (enabled) {
+                levels[depth - 1].key.assign(str, len);
+            }
+        }
+
+        /** Returns the JSON Pointer to the current value. */
+        std::string str() const
+        {
+            if (depth == 0) {
+                return "/";
+            }
+
+            std::string path;
+            for (std::size_t k = 0; k < depth; ++k) {
+                const Level& level = levels[k];
+                path.push_back('/');
+                if (level.is_array) {
+                    char buf[std::numeric_limits<std::size_t>::digits10 + 1];
+                    auto result = std::to_chars(buf, buf + sizeof(buf), level.index);
+                    path.append(buf, result.ptr);
+                } else {
+                    path.append(level.key);
+                }
+            }
+            return path;
+        }
+
+    private:
+        struct Level
+        {
+            bool is_array = false;
+            std::size_t index = 0;
+            std::string key;
+        };
+
+        void push(bool is_array)
+        {
+            if (depth == levels.size()) {
+                levels.emplace_back();
+            }
+            Level& level = levels[depth];
+            level.is_array = is_array;
+            level.index = std::numeric_limits<std::size_t>::max();  // wraps to 0 on first element
+            ++depth;
+        }
+
+        std::vector<Level> levels;
+        std::size_t depth = 0;
+    };
+}
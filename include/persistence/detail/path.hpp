@@ -1,6 +1,8 @@
 #pragma once
 #include "segment.hpp"
 #include <charconv>
+#include <limits>
+#include <string>
 
 namespace persistence
 {
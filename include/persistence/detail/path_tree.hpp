@@ -0,0 +1,78 @@
+#pragma once
+#include "segment.hpp"
+#include "path.hpp"
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace persistence
+{
+    /**
+     * An interned tree of JSON Path segments.
+     *
+     * Each node stores a single segment and the index of its parent node such that paths with a common prefix
+     * share storage. Nodes live in a single contiguous buffer, and a JSON Pointer string is built only on request.
+     */
+    struct PathTree
+    {
+        using node_id = std::size_t;
+
+        /** Identifies the root of the tree, which corresponds to the empty path. */
+        constexpr static node_id root = 0;
+
+        /** Marks a node that has not been interned yet. */
+        constexpr static node_id none = std::numeric_limits<node_id>::max();
+
+        PathTree()
+        {
+            nodes.push_back(Node{ Segment(), root });
+        }
+
+        PathTree(const PathTree&) = delete;
+
+        /**
+         * Adds a node as a child of an existing node, and returns its identifier.
+         *
+         * The name of a segment is copied because it may refer to a temporary, such as a formatted integer key.
+         */
+        node_id add(node_id parent, const Segment& segment)
+        {
+            if (segment.is_named()) {
+                nodes.push_back(Node{ Segment(std::string_view(names.emplace_back(segment.name))), parent });
+            } else {
+                nodes.push_back(Node{ segment, parent });
+            }
+            return nodes.size() - 1;
+        }
+
+        /** Returns the segments leading to a node, starting with the node itself and ending just below the root. */
+        Segments segments(node_id id) const
+        {
+            Segments segs;
+            for (; id != root; id = nodes[id].parent) {
+                segs.push_back(nodes[id].segment);
+            }
+            return segs;
+        }
+
+        /** Returns the JSON Pointer string that identifies a node. */
+        std::string str(node_id id) const
+        {
+            return Path(segments(id)).str();
+        }
+
+    private:
+        struct Node
+        {
+            Segment segment;
+            node_id parent;
+        };
+
+        std::vector<Node> nodes;
+
+        /** Storage for segment names, which keeps their address when more are added. */
+        std::deque<std::string> names;
+    };
+}
@@ -1,5 +1,7 @@
 #pragma once
 #include "bitset.hpp"
+#include <array>
+#include <stdexcept>
 #include <string_view>
 
 namespace persistence
@@ -8,7 +10,13 @@ namespace persistence
     {
         using hash_t = std::size_t;
     
-        /** Fowler–Noll–Vo hash function variant FNV-1. */
+        /**
+         * Fowler–Noll–Vo hash function variant FNV-1.
+         *
+         * The low bits of an FNV-1 hash depend only on the low bits of the seed and of the characters, so the upper
+         * half is folded into the lower half: otherwise, keys that agree in the low bits of their characters (e.g.
+         * `created` and `updated`) would map to the same slot of a small table for every seed.
+         */
         inline constexpr hash_t hash(hash_t d, const std::string_view& str)
         {
             if constexpr (sizeof(hash_t) == sizeof(std::uint32_t)) {
@@ -23,7 +31,7 @@ namespace persistence
                     // xor the bottom with the current octet
                     d ^= str[i];
                 }
-                return d & 0x7fffffff;
+                return (d ^ (d >> 16)) & 0x7fffffff;
             } else if constexpr (sizeof(hash_t) == sizeof(std::uint64_t)) {
                 // Fowler–Noll–Vo hash function variant FNV-1 for 64 bits
                 if (d == 0) {
@@ -36,7 +44,7 @@ namespace persistence
                     // xor the bottom with the current octet
                     d ^= str[i];
                 }
-                return d & 0x7fffffffffffffff;
+                return (d ^ (d >> 32)) & 0x7fffffffffffffff;
             }
         }
     }
@@ -80,47 +88,71 @@ namespace persistence
             using namespace detail;
 
             // place all of the items into buckets
-            BitSet<Size> buckets[Size];
+            std::size_t bucket_of[Size] = { 0 };
+            std::size_t bucket_size[Size] = { 0 };
+            std::size_t max_size = 0;
             for (std::size_t k = 0; k < Size; ++k) {
                 std::size_t key = hash(0, items[k]) % Size;
-                buckets[key].set(k);
+                bucket_of[k] = key;
+                ++bucket_size[key];
+                if (bucket_size[key] > max_size) {
+                    max_size = bucket_size[key];
+                }
+            }
+
+            // list the items of each bucket next to one another, keeping their original order; equal items would
+            // share a bucket where no seed could separate them, so they are rejected
+            std::size_t bucket_start[Size] = { 0 };
+            for (std::size_t i = 1; i < Size; ++i) {
+                bucket_start[i] = bucket_start[i - 1] + bucket_size[i - 1];
+            }
+            std::size_t bucket_items[Size] = { 0 };
+            std::size_t bucket_fill[Size] = { 0 };
+            for (std::size_t k = 0; k < Size; ++k) {
+                std::size_t key = bucket_of[k];
+                for (std::size_t i = 0; i < bucket_fill[key]; ++i) {
+                    if (items[bucket_items[bucket_start[key] + i]] == items[k]) {
+                        throw std::invalid_argument("duplicate item in perfect hash");
+                    }
+                }
+                bucket_items[bucket_start[key] + bucket_fill[key]] = k;
+                ++bucket_fill[key];
             }
 
             // process the buckets with the most items first (but at least 2)
             BitSet<Size> taken;
-            for (std::size_t count = Size; count > 1; --count) {
+            for (std::size_t count = max_size; count > 1; --count) {
                 for (std::size_t i = 0; i < Size; ++i) {
-                    if (buckets[i].count() != count) {
+                    if (bucket_size[i] != count) {
                         continue;
                     }
 
-                    // find a seed that places all items into free slots
-                    hash_t d = scatter(items, buckets[i], taken);
-                    G[hash(0, items[buckets[i].first_set()]) % Size] = d;
+                    // find a seed that places all items into free slots, and take those slots
+                    const std::size_t* bucket = bucket_items + bucket_start[i];
+                    hash_t d = scatter(items, bucket, count, taken);
+                    G[i] = d;
 
-                    // assign items to free slots
+                    // assign items to the slots taken
                     for (std::size_t k = 0; k < count; ++k) {
-                        auto item_index = buckets[i].pick(k);
-                        auto bucket_item = items[item_index];
-
-                        hash_t index = hash(d, bucket_item) % Size;
-
-                        taken.set(index);
-                        index_map[index] = item_index;
+                        auto item_index = bucket[k];
+                        index_map[hash(d, items[item_index]) % Size] = item_index;
                     }
                 }
             }
 
             // process buckets with exactly 1 item by directly placing them into a free slot
+            std::size_t index = 0;
             for (std::size_t i = 0; i < Size; ++i) {
-                if (buckets[i].count() == 1) {
-                    auto item_index = buckets[i].first_set();
-                    auto bucket_item = items[item_index];
+                if (bucket_size[i] == 1) {
+                    auto item_index = bucket_items[bucket_start[i]];
 
-                    std::size_t index = taken.first_unset();
+                    // slots are never released, so the search for a free slot resumes where it left off
+                    while (taken.get(index)) {
+                        ++index;
+                    }
 
                     // ones' complement indicates that this fast path was taken
-                    G[hash(0, bucket_item) % Size] = ~static_cast<hash_t>(index);
+                    G[i] = ~static_cast<hash_t>(index);
 
                     taken.set(index);
                     index_map[index] = item_index;
@@ -130,17 +162,18 @@ namespace persistence
 
         /**
          * Repeatedly tries different seed values until it finds one that places
-         * all items into different free slots.
+         * all items into different free slots, and marks those slots as occupied.
          *
          * @param items An array of items to place into free slots.
-         * @param mask A mask that identifies which items in the array to take into account.
+         * @param bucket Indices of the items in the array to take into account.
+         * @param count The number of indices in the bucket.
          * @param taken A mask that identifies occupied slots.
          */
         template<typename Indexable>
-        constexpr detail::hash_t scatter(const Indexable& items, const BitSet<Size>& mask, const BitSet<Size>& taken)
+        constexpr detail::hash_t scatter(const Indexable& items, const std::size_t* bucket, std::size_t count, BitSet<Size>& taken)
         {
             detail::hash_t d = 1;
-            while (!is_distributable(d, items, mask, taken)) {
+            while (!is_distributable(d, items, bucket, count, taken)) {
                 ++d;
             }
             return d;
@@ -149,21 +182,24 @@ namespace persistence
         /**
          * Checks if a seed value places all items into different free slots.
          *
+         * If so, the slots are marked as occupied; otherwise, the mask of occupied slots is left unchanged.
+         *
          * @param d The seed value to test.
          * @param items An array of items to place into free slots.
-         * @param mask A mask that identifies which items in the array to take into account.
+         * @param bucket Indices of the items in the array to take into account.
+         * @param count The number of indices in the bucket.
          * @param taken A mask that identifies occupied slots.
          */
         template<typename Indexable>
-        constexpr bool is_distributable(detail::hash_t d, const Indexable& items, const BitSet<Size>& mask, BitSet<Size> taken)
+        constexpr bool is_distributable(detail::hash_t d, const Indexable& items, const std::size_t* bucket, std::size_t count, BitSet<Size>& taken)
         {
-            for (std::size_t k = 0; k < Size; ++k) {
-                if (!mask.get(k)) {
-                    continue;
-                }
-
-                auto key = detail::hash(d, items[k]) % Size;
+            for (std::size_t k = 0; k < count; ++k) {
+                auto key = detail::hash(d, items[bucket[k]]) % Size;
                 if (taken.get(key)) {
+                    // release the slots taken by the items placed so far
+                    for (std::size_t i = 0; i < k; ++i) {
+                        taken.reset(detail::hash(d, items[bucket[i]]) % Size);
+                    }
                     return false;
                 }
                 taken.set(key);
@@ -175,4 +211,17 @@ namespace persistence
         std::size_t index_map[Size] = { 0 };
         detail::hash_t G[Size] = { 0 };
     };
+
+    /** A lookup table with no items, for which no index is valid. */
+    template<>
+    struct PerfectHash<0>
+    {
+        constexpr PerfectHash(const std::array<std::string_view, 0>&)
+        {}
+
+        constexpr std::size_t index(const std::string_view&) const
+        {
+            return 0;
+        }
+    };
 }
@@ -1,33 +1,109 @@
 #pragma once
-#include <map>
-#include <optional>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
 
 namespace persistence
 {
-    template<typename K, typename V>
+    /**
+     * Maps object addresses to values, used for detecting repeated occurrences of the same object.
+     *
+     * The table uses open addressing with linear probing over a power-of-two number of slots. Keys are raw
+     * addresses, which means lookup involves neither reference counting nor dynamic memory allocation.
+     *
+     * @tparam V Type of value associated with an address.
+     */
+    template<typename V>
     struct ReferenceTable
     {
-        std::optional<V> get(const K& key) const
+        /** Returns the value associated with an address, or null if the address is not in the table. */
+        const V* get(const void* key) const
         {
-            auto&& it = references.find(key);
-            if (it != references.end()) {
-                return it->second;
-            } else {
-                return std::nullopt;
+            if (slots.empty()) {
+                return nullptr;
             }
+
+            for (std::size_t index = hash(key);; index = (index + 1) & mask()) {
+                const Slot& slot = slots[index];
+                if (slot.first == key) {
+                    return &slot.second;
+                } else if (slot.first == nullptr) {
+                    return nullptr;
+                }
+            }
+        }
+
+        /** Associates a value with an address unless the address is already in the table. */
+        void put(const void* key, V value)
+        {
+            if ((count + 1) * 2 > slots.size()) {
+                rehash(slots.empty() ? 16 : 2 * slots.size());
+            }
+            insert(key, std::move(value));
         }
 
-        void put(const K& key, const V& value)
+        /** Ensures that the table can hold the given number of entries without re-hashing. */
+        void reserve(std::size_t capacity)
         {
-            references.insert(std::make_pair(key, value));
+            std::size_t size = slots.empty() ? 16 : slots.size();
+            while (size < 2 * capacity) {
+                size *= 2;
+            }
+            if (capacity > 0 && size > slots.size()) {
+                rehash(size);
+            }
         }
 
-        void put(K&& key, V&& value)
+        /** Number of entries in the table. */
+        std::size_t size() const
         {
-            references.insert(std::make_pair(std::move(key), std::move(value)));
+            return count;
         }
 
     private:
-        std::map<K, V> references;
+        using Slot = std::pair<const void*, V>;
+
+        std::size_t mask() const
+        {
+            return slots.size() - 1;
+        }
+
+        /** Fibonacci hashing, which spreads aligned addresses (with low bits all zero) evenly across slots. */
+        std::size_t hash(const void* key) const
+        {
+            std::uint64_t h = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(key)) * 0x9E3779B97F4A7C15ull;
+            return static_cast<std::size_t>(h >> 32) & mask();
+        }
+
+        void insert(const void* key, V&& value)
+        {
+            for (std::size_t index = hash(key);; index = (index + 1) & mask()) {
+                Slot& slot = slots[index];
+                if (slot.first == key) {
+                    return;
+                } else if (slot.first == nullptr) {
+                    slot.first = key;
+                    slot.second = std::move(value);
+                    ++count;
+                    return;
+                }
+            }
+        }
+
+        void rehash(std::size_t size)
+        {
+            std::vector<Slot> previous(size);
+            previous.swap(slots);
+            count = 0;
+            for (Slot& slot : previous) {
+                if (slot.first != nullptr) {
+                    insert(slot.first, std::move(slot.second));
+                }
+            }
+        }
+
+        std::vector<Slot> slots;
+        std::size_t count = 0;
     };
 }
@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+
+namespace persistence
+{
+    namespace detail
+    {
+        /**
+         * A null-terminated JSON string in memory, read by the RapidJSON reader.
+         *
+         * RapidJSON reads a number or a string from a local copy of its own string stream, and writes the copy back
+         * only once the token has been delivered, so while a parser handles the token, the stream it was given still
+         * points at the start of the token. The reader uses this stream in place instead: during a token event, the
+         * position is past the token just delivered, and a parser may move it forward past input it has consumed.
+         *
+         * Implements the input stream concept of RapidJSON.
+         */
+        class StringInput
+        {
+        public:
+            using Ch = char;
+
+            explicit StringInput(const char* str)
+                : head(str)
+                , cur(str)
+            {}
+
+            StringInput(const StringInput&) = delete;
+            StringInput& operator=(const StringInput&) = delete;
+
+            char Peek() const
+            {
+                return *cur;
+            }
+
+            char Take()
+            {
+                return *cur++;
+            }
+
+            /** The number of characters consumed so far. */
+            std::size_t Tell() const
+            {
+                return static_cast<std::size_t>(cur - head);
+            }
+
+            // output is only written when parsing in situ, which the input does not support
+            char* PutBegin() { return nullptr; }
+            void Put(char) {}
+            void Flush() {}
+            std::size_t PutEnd(char*) { return 0; }
+
+            /** The start of the input. */
+            const char* begin() const
+            {
+                return head;
+            }
+
+            /** The position the reader continues from. */
+            const char* position() const
+            {
+                return cur;
+            }
+
+            /** Moves the reader past input that a parser has consumed on its own. */
+            void advance(const char* p)
+            {
+                cur = p;
+            }
+
+        private:
+            const char* head;
+            const char* cur;
+        };
+    }
+}
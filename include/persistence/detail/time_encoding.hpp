@@ -0,0 +1,60 @@
+#pragma once
+#include "traits.hpp"
+#include <chrono>
+#include <type_traits>
+
+namespace persistence
+{
+    /**
+     * Representation of a time point in JSON.
+     */
+    enum class TimeEncoding
+    {
+        /** ISO 8601 date-time string in UTC, e.g. `2022-02-01T23:02:01Z`. */
+        iso8601,
+        /** Integer number of seconds since the UNIX epoch. */
+        epoch_seconds,
+        /** Integer number of milliseconds since the UNIX epoch. */
+        epoch_milliseconds,
+        /** Integer number of microseconds since the UNIX epoch. */
+        epoch_microseconds,
+        /** Integer number of nanoseconds since the UNIX epoch. */
+        epoch_nanoseconds
+    };
+
+    namespace detail
+    {
+        /**
+         * Member descriptor that extends another descriptor with a time encoding.
+         *
+         * @tparam Descriptor Structure that provides compile-time access to the member name as a string literal.
+         */
+        template<typename Descriptor, TimeEncoding Encoding>
+        struct encoded_member_descriptor : Descriptor
+        {
+            constexpr static TimeEncoding time_encoding = Encoding;
+        };
+
+        template<typename Descriptor>
+        using time_encoding_member = decltype(Descriptor::time_encoding);
+
+        /** The time encoding a member descriptor specifies, or an ISO 8601 string. */
+        template<typename Descriptor>
+        constexpr TimeEncoding time_encoding_of()
+        {
+            if constexpr (detect<Descriptor, time_encoding_member>::value) {
+                return Descriptor::time_encoding;
+            } else {
+                return TimeEncoding::iso8601;
+            }
+        }
+
+        /** True if the type is a time point that can be written in a choice of encodings. */
+        template<typename T>
+        struct is_time_encodable : std::is_same<T, std::chrono::time_point<std::chrono::system_clock>>
+        {};
+
+        template<typename T>
+        inline constexpr bool is_time_encodable_v = is_time_encodable<T>::value;
+    }
+}
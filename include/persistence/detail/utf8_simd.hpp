@@ -0,0 +1,327 @@
+#pragma once
+#include "cpu_features.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace persistence
+{
+    namespace detail
+    {
+        /**
+         * Finds the first byte that does not belong to a well-formed UTF-8 sequence.
+         *
+         * Rejects overlong forms, surrogates (U+D800 to U+DFFF), code points above U+10FFFF, and sequences cut short.
+         *
+         * @return The offset of the first byte of the ill-formed sequence, or the size if the input is valid.
+         */
+        inline std::size_t utf8_error_offset(const char* in, std::size_t size)
+        {
+            const unsigned char* p = reinterpret_cast<const unsigned char*>(in);
+            std::size_t i = 0;
+            while (i < size) {
+                // skip 8 ASCII characters at a time
+                if (i + 8 <= size) {
+                    std::uint64_t word;
+                    std::memcpy(&word, p + i, sizeof(word));
+                    if ((word & 0x8080808080808080ull) == 0) {
+                        i += 8;
+                        continue;
+                    }
+                }
+
+                const unsigned char c = p[i];
+                if (c < 0x80) {
+                    ++i;
+                    continue;
+                }
+
+                // the range of the second byte depends on the lead byte, the range of other bytes is always 80..BF
+                std::size_t length;
+                unsigned char low = 0x80;
+                unsigned char high = 0xBF;
+                if (c < 0xC2) {
+                    return i;  // continuation byte, or overlong lead byte C0 or C1
+                } else if (c < 0xE0) {
+                    length = 2;
+                } else if (c < 0xF0) {
+                    length = 3;
+                    if (c == 0xE0) {
+                        low = 0xA0;  // overlong
+                    } else if (c == 0xED) {
+                        high = 0x9F;  // surrogate
+                    }
+                } else if (c < 0xF5) {
+                    length = 4;
+                    if (c == 0xF0) {
+                        low = 0x90;  // overlong
+                    } else if (c == 0xF4) {
+                        high = 0x8F;  // above U+10FFFF
+                    }
+                } else {
+                    return i;
+                }
+
+                if (size - i < length || p[i + 1] < low || p[i + 1] > high) {
+                    return i;
+                }
+                for (std::size_t k = 2; k < length; ++k) {
+                    if (p[i + k] < 0x80 || p[i + k] > 0xBF) {
+                        return i;
+                    }
+                }
+                i += length;
+            }
+            return size;
+        }
+
+#if defined(PERSISTENCE_X86_SIMD)
+        /**
+         * Lookup tables that classify a pair of adjacent bytes by the high nibble of the first byte, the low nibble
+         * of the first byte, and the high nibble of the second byte. Each bit stands for a kind of error; a pair is
+         * ill-formed if a bit is set in all three lookups.
+         */
+        struct utf8_tables
+        {
+            constexpr static std::uint8_t too_short = 1 << 0;       // lead byte followed by a lead byte or ASCII
+            constexpr static std::uint8_t too_long = 1 << 1;        // ASCII followed by a continuation byte
+            constexpr static std::uint8_t overlong_3 = 1 << 2;      // E0 followed by 80..9F
+            constexpr static std::uint8_t too_large = 1 << 3;       // F4 followed by 90..BF, or F5..FF
+            constexpr static std::uint8_t surrogate = 1 << 4;       // ED followed by A0..BF
+            constexpr static std::uint8_t overlong_2 = 1 << 5;      // C0 or C1
+            constexpr static std::uint8_t too_large_1000 = 1 << 6; // F5..FF followed by 80..8F
+            constexpr static std::uint8_t overlong_4 = 1 << 6;      // F0 followed by 80..8F
+            constexpr static std::uint8_t two_conts = 1 << 7;       // continuation byte following a continuation byte
+            constexpr static std::uint8_t carry = too_short | too_long | two_conts;
+
+            alignas(16) constexpr static std::uint8_t byte_1_high[16] = {
+                // 0___ ASCII
+                too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+                // 10__ continuation
+                two_conts, two_conts, two_conts, two_conts,
+                // 1100 two-byte lead
+                too_short | overlong_2,
+                // 1101 two-byte lead
+                too_short,
+                // 1110 three-byte lead
+                too_short | overlong_3 | surrogate,
+                // 1111 four-byte lead
+                too_short | too_large | too_large_1000 | overlong_4
+            };
+
+            alignas(16) constexpr static std::uint8_t byte_1_low[16] = {
+                carry | overlong_3 | overlong_2 | overlong_4,
+                carry | overlong_2,
+                carry,
+                carry,
+                carry | too_large,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000 | surrogate,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000
+            };
+
+            alignas(16) constexpr static std::uint8_t byte_2_high[16] = {
+                // 0___ ASCII
+                too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+                // 1000
+                too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+                // 1001
+                too_long | overlong_2 | two_conts | overlong_3 | too_large,
+                // 101_
+                too_long | overlong_2 | two_conts | surrogate | too_large,
+                too_long | overlong_2 | two_conts | surrogate | too_large,
+                // 11__ lead byte
+                too_short, too_short, too_short, too_short
+            };
+
+            /** Largest values of the last three bytes of a block that do not start a sequence extending past it. */
+            alignas(16) constexpr static std::uint8_t incomplete_max[16] = {
+                0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1
+            };
+        };
+
+        /**
+         * Flags ill-formed UTF-8 in a block of 16 bytes with SSSE3 instructions, given the previous block.
+         *
+         * Pairs of adjacent bytes are classified with table lookups; a third or fourth byte of a sequence is
+         * recognized by the lead byte two or three positions earlier.
+         */
+        PERSISTENCE_TARGET("ssse3")
+        inline __m128i utf8_block_errors_ssse3(__m128i input, __m128i prev_input)
+        {
+            const __m128i low_nibble = _mm_set1_epi8(0x0F);
+            const __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+
+            const __m128i byte_1_high = _mm_shuffle_epi8(
+                _mm_load_si128(reinterpret_cast<const __m128i*>(utf8_tables::byte_1_high)),
+                _mm_and_si128(_mm_srli_epi16(prev1, 4), low_nibble)
+            );
+            const __m128i byte_1_low = _mm_shuffle_epi8(
+                _mm_load_si128(reinterpret_cast<const __m128i*>(utf8_tables::byte_1_low)),
+                _mm_and_si128(prev1, low_nibble)
+            );
+            const __m128i byte_2_high = _mm_shuffle_epi8(
+                _mm_load_si128(reinterpret_cast<const __m128i*>(utf8_tables::byte_2_high)),
+                _mm_and_si128(_mm_srli_epi16(input, 4), low_nibble)
+            );
+            const __m128i special = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+
+            // only 111_____ and 1111____ remain at least 0x80 when shifted down
+            const __m128i prev2 = _mm_alignr_epi8(input, prev_input, 14);
+            const __m128i prev3 = _mm_alignr_epi8(input, prev_input, 13);
+            const __m128i is_third_byte = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+            const __m128i is_fourth_byte = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+            const __m128i must_be_continuation = _mm_and_si128(_mm_or_si128(is_third_byte, is_fourth_byte), _mm_set1_epi8(static_cast<char>(0x80)));
+
+            return _mm_xor_si128(must_be_continuation, special);
+        }
+
+        /**
+         * Validates UTF-8 with SSSE3 instructions, 16 bytes at a time.
+         */
+        PERSISTENCE_TARGET("ssse3")
+        inline bool utf8_validate_ssse3(const char* in, std::size_t size)
+        {
+            const __m128i incomplete_max = _mm_load_si128(reinterpret_cast<const __m128i*>(utf8_tables::incomplete_max));
+
+            __m128i error = _mm_setzero_si128();
+            __m128i prev_input = _mm_setzero_si128();
+            __m128i prev_incomplete = _mm_setzero_si128();
+
+            std::size_t i = 0;
+            alignas(16) char tail[16];
+            while (i < size) {
+                __m128i input;
+                if (i + 16 <= size) {
+                    input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                } else {
+                    // pad the last block with null characters, which are valid on their own
+                    std::memset(tail, 0, sizeof(tail));
+                    std::memcpy(tail, in + i, size - i);
+                    input = _mm_load_si128(reinterpret_cast<const __m128i*>(tail));
+                }
+                i += 16;
+
+                if (_mm_movemask_epi8(input) == 0) {
+                    // ASCII only, but a sequence in the previous block might have been cut short
+                    error = _mm_or_si128(error, prev_incomplete);
+                    prev_incomplete = _mm_setzero_si128();
+                } else {
+                    error = _mm_or_si128(error, utf8_block_errors_ssse3(input, prev_input));
+                    prev_incomplete = _mm_subs_epu8(input, incomplete_max);
+                }
+                prev_input = input;
+            }
+            error = _mm_or_si128(error, prev_incomplete);
+            return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xFFFF;
+        }
+
+        /**
+         * Flags ill-formed UTF-8 in a block of 32 bytes with AVX2 instructions, given the previous block.
+         */
+        PERSISTENCE_TARGET("avx2")
+        inline __m256i utf8_block_errors_avx2(__m256i input, __m256i prev_input)
+        {
+            const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+
+            // the last 16 bytes of the previous block followed by the first 16 bytes of this block
+            const __m256i shifted = _mm256_permute2x128_si256(prev_input, input, 0x21);
+            const __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+
+            const __m256i byte_1_high = _mm256_shuffle_epi8(
+                _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(utf8_tables::byte_1_high))),
+                _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble)
+            );
+            const __m256i byte_1_low = _mm256_shuffle_epi8(
+                _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(utf8_tables::byte_1_low))),
+                _mm256_and_si256(prev1, low_nibble)
+            );
+            const __m256i byte_2_high = _mm256_shuffle_epi8(
+                _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(utf8_tables::byte_2_high))),
+                _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble)
+            );
+            const __m256i special = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+            const __m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+            const __m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+            const __m256i is_third_byte = _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+            const __m256i is_fourth_byte = _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+            const __m256i must_be_continuation = _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte), _mm256_set1_epi8(static_cast<char>(0x80)));
+
+            return _mm256_xor_si256(must_be_continuation, special);
+        }
+
+        /**
+         * Validates UTF-8 with AVX2 instructions, 32 bytes at a time.
+         */
+        PERSISTENCE_TARGET("avx2")
+        inline bool utf8_validate_avx2(const char* in, std::size_t size)
+        {
+            // only the last three bytes of the upper lane may start a sequence that extends past the block
+            const __m256i incomplete_max = _mm256_inserti128_si256(
+                _mm256_set1_epi8(static_cast<char>(0xFF)),
+                _mm_load_si128(reinterpret_cast<const __m128i*>(utf8_tables::incomplete_max)),
+                1
+            );
+
+            __m256i error = _mm256_setzero_si256();
+            __m256i prev_input = _mm256_setzero_si256();
+            __m256i prev_incomplete = _mm256_setzero_si256();
+
+            std::size_t i = 0;
+            alignas(32) char tail[32];
+            while (i < size) {
+                __m256i input;
+                if (i + 32 <= size) {
+                    input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+                } else {
+                    std::memset(tail, 0, sizeof(tail));
+                    std::memcpy(tail, in + i, size - i);
+                    input = _mm256_load_si256(reinterpret_cast<const __m256i*>(tail));
+                }
+                i += 32;
+
+                if (_mm256_movemask_epi8(input) == 0) {
+                    error = _mm256_or_si256(error, prev_incomplete);
+                    prev_incomplete = _mm256_setzero_si256();
+                } else {
+                    error = _mm256_or_si256(error, utf8_block_errors_avx2(input, prev_input));
+                    prev_incomplete = _mm256_subs_epu8(input, incomplete_max);
+                }
+                prev_input = input;
+            }
+            error = _mm256_or_si256(error, prev_incomplete);
+            return _mm256_testz_si256(error, error) != 0;
+        }
+#endif
+
+        /**
+         * Validates UTF-8 with the widest vector instructions available, or one byte at a time for short input.
+         */
+        inline bool utf8_validate(const char* in, std::size_t size)
+        {
+#if defined(PERSISTENCE_X86_SIMD)
+            // short strings such as object keys are not worth the set-up of vector registers
+            if (size >= 32) {
+                switch (supported_simd_level()) {
+                    case simd_level::avx2:
+                        return utf8_validate_avx2(in, size);
+                    case simd_level::ssse3:
+                        return utf8_validate_ssse3(in, size);
+                    default:
+                        break;
+                }
+            }
+#endif
+            return utf8_error_offset(in, size) == size;
+        }
+    }
+}
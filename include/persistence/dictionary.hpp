@@ -1,6 +1,13 @@
 #pragma once
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <map>
 #include <unordered_map>
@@ -24,4 +31,272 @@ namespace persistence
 
     template<typename T>
     using string_unordered_map = std::unordered_map<std::string, T>;
+
+    /**
+     * Treatment of a key that occurs more than once in a JSON object.
+     */
+    enum class DuplicateKeys
+    {
+        /** The value that comes last takes effect, as with `std::map`. */
+        overwrite,
+        /** The JSON object is rejected. */
+        reject
+    };
+
+    namespace detail
+    {
+        /**
+         * Iterates over the items of a flat map, giving access to each item as a pair of references, of which the
+         * key is read-only, such that modifying an item cannot break the order of keys.
+         */
+        template<typename Iterator, typename K, typename T>
+        class flat_map_iterator
+        {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = std::pair<const K, std::remove_const_t<T>>;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::pair<const K&, T&>;
+
+            /** Holds the item returned by the member access operator. */
+            struct pointer
+            {
+                reference item;
+
+                const reference* operator->() const { return &item; }
+            };
+
+            flat_map_iterator() = default;
+
+            explicit flat_map_iterator(Iterator it)
+                : it(it)
+            {}
+
+            /** Converts an iterator to a constant iterator. */
+            template<typename Other, typename U, typename = std::enable_if_t<std::is_convertible_v<Other, Iterator>>>
+            flat_map_iterator(const flat_map_iterator<Other, K, U>& other)
+                : it(other.base())
+            {}
+
+            reference operator*() const { return reference(it->first, it->second); }
+            pointer operator->() const { return pointer{ **this }; }
+
+            flat_map_iterator& operator++()
+            {
+                ++it;
+                return *this;
+            }
+
+            flat_map_iterator operator++(int)
+            {
+                flat_map_iterator previous = *this;
+                ++it;
+                return previous;
+            }
+
+            flat_map_iterator& operator--()
+            {
+                --it;
+                return *this;
+            }
+
+            flat_map_iterator operator--(int)
+            {
+                flat_map_iterator previous = *this;
+                --it;
+                return previous;
+            }
+
+            /** The position in the underlying vector. */
+            Iterator base() const { return it; }
+
+            friend bool operator==(const flat_map_iterator& left, const flat_map_iterator& right)
+            {
+                return left.it == right.it;
+            }
+
+            friend bool operator!=(const flat_map_iterator& left, const flat_map_iterator& right)
+            {
+                return left.it != right.it;
+            }
+
+        private:
+            Iterator it;
+        };
+    }
+
+    /**
+     * A dictionary stored as a vector of key and value pairs sorted by key, with lookup by binary search.
+     *
+     * Suited to dictionaries that are read much more often than they are modified: items are contiguous in memory,
+     * and a dictionary read from JSON is sorted once, after all of its items have been collected.
+     *
+     * @tparam K The key type, such as `std::string` or an integer type.
+     * @tparam T The mapped type.
+     * @tparam Duplicates Treatment of keys that occur more than once when the dictionary is read from JSON.
+     */
+    template<typename K, typename T, DuplicateKeys Duplicates = DuplicateKeys::overwrite>
+    class flat_map
+    {
+    public:
+        using key_type = K;
+        using mapped_type = T;
+        using value_type = std::pair<const K, T>;
+        /** The storage of items, which may be given in any order when the contents are replaced. */
+        using container_type = std::vector<std::pair<K, T>>;
+        using size_type = typename container_type::size_type;
+        using reference = std::pair<const K&, T&>;
+        using const_reference = std::pair<const K&, const T&>;
+        using iterator = detail::flat_map_iterator<typename container_type::iterator, K, T>;
+        using const_iterator = detail::flat_map_iterator<typename container_type::const_iterator, K, const T>;
+
+        flat_map() = default;
+
+        /** Creates a dictionary from items in any order; of several items with the same key, the last one is kept. */
+        flat_map(std::initializer_list<value_type> items)
+            : data(items.begin(), items.end())
+        {
+            sort_items<DuplicateKeys::overwrite>(data);
+        }
+
+        iterator begin() { return iterator(data.begin()); }
+        iterator end() { return iterator(data.end()); }
+        const_iterator begin() const { return const_iterator(data.begin()); }
+        const_iterator end() const { return const_iterator(data.end()); }
+
+        bool empty() const { return data.empty(); }
+        size_type size() const { return data.size(); }
+        void clear() { data.clear(); }
+
+        /** Finds the item with a key, or returns the end iterator. */
+        template<typename Key>
+        iterator find(const Key& key)
+        {
+            return iterator(find_in(data, key));
+        }
+
+        /** Finds the item with a key, or returns the end iterator. */
+        template<typename Key>
+        const_iterator find(const Key& key) const
+        {
+            return const_iterator(find_in(data, key));
+        }
+
+        template<typename Key>
+        bool contains(const Key& key) const
+        {
+            return find_in(data, key) != data.end();
+        }
+
+        /** Accesses the value with a key, or throws `std::out_of_range` if there is no such item. */
+        template<typename Key>
+        const T& at(const Key& key) const
+        {
+            auto it = find_in(data, key);
+            if (it == data.end()) {
+                throw std::out_of_range("key not found in dictionary");
+            }
+            return it->second;
+        }
+
+        /** Accesses the value with a key, inserting a default value at its sorted position if there is no such item. */
+        T& operator[](const K& key)
+        {
+            auto it = lower_bound_in(data, key);
+            if (it == data.end() || key < it->first) {
+                it = data.emplace(it, key, T());
+            }
+            return it->second;
+        }
+
+        /**
+         * Replaces the contents of the dictionary with items in any order.
+         *
+         * @return False if a key occurs more than once and duplicates are rejected; the dictionary is then empty.
+         */
+        bool assign(container_type&& items)
+        {
+            const bool unique = sort_items<Duplicates>(items);
+            data = std::move(items);
+            if (!unique) {
+                data.clear();
+            }
+            return unique;
+        }
+
+        friend bool operator==(const flat_map& left, const flat_map& right)
+        {
+            return left.data == right.data;
+        }
+
+        friend bool operator!=(const flat_map& left, const flat_map& right)
+        {
+            return left.data != right.data;
+        }
+
+    private:
+        /** Finds the first item whose key is not less than a key, with no branches that depend on the comparisons. */
+        template<typename Items, typename Key>
+        static auto lower_bound_in(Items& items, const Key& key)
+        {
+            auto first = items.begin();
+            std::size_t count = items.size();
+            while (count > 1) {
+                const std::size_t half = count / 2;
+                first = first[static_cast<std::ptrdiff_t>(half) - 1].first < key ? first + static_cast<std::ptrdiff_t>(half) : first;
+                count -= half;
+            }
+            return count == 1 && first->first < key ? first + 1 : first;
+        }
+
+        template<typename Items, typename Key>
+        static auto find_in(Items& items, const Key& key)
+        {
+            auto it = lower_bound_in(items, key);
+            return it != items.end() && !(key < it->first) ? it : items.end();
+        }
+
+        /**
+         * Sorts items by key, and keeps the last of several items with the same key.
+         *
+         * @return False if a key occurs more than once and duplicates are rejected.
+         */
+        template<DuplicateKeys Policy>
+        static bool sort_items(container_type& items)
+        {
+            // input written from a sorted dictionary is already in order
+            using item_type = typename container_type::value_type;
+            auto is_less = [](const item_type& left, const item_type& right) {
+                return left.first < right.first;
+            };
+            if (std::adjacent_find(items.begin(), items.end(), [&](const item_type& left, const item_type& right) { return !is_less(left, right); }) == items.end()) {
+                return true;
+            }
+
+            std::stable_sort(items.begin(), items.end(), is_less);
+
+            std::size_t count = 0;
+            for (std::size_t k = 0; k < items.size(); ++k) {
+                if (count > 0 && !is_less(items[count - 1], items[k])) {
+                    if constexpr (Policy == DuplicateKeys::reject) {
+                        return false;
+                    } else {
+                        items[count - 1].second = std::move(items[k].second);
+                    }
+                } else {
+                    if (count != k) {
+                        items[count] = std::move(items[k]);
+                    }
+                    ++count;
+                }
+            }
+            items.erase(items.begin() + static_cast<std::ptrdiff_t>(count), items.end());
+            return true;
+        }
+
+        container_type data;
+    };
+
+    template<typename T, DuplicateKeys Duplicates = DuplicateKeys::overwrite>
+    using string_flat_map = flat_map<std::string, T, Duplicates>;
 }
@@ -1,5 +1,12 @@
 #pragma once
+#include "detail/perfect_hash.hpp"
 #include <array>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#ifdef PERSISTENCE_BOOST_DESCRIBE
+#include <boost/describe/enumerators.hpp>
+#endif
 
 namespace persistence
 {
@@ -21,11 +28,105 @@ namespace persistence
         {
             return detail::to_array_impl(a, std::make_index_sequence<N>{});
         }
+
+        /**
+         * Extracts the names from a list of enumeration value and name pairs.
+         *
+         * Names must be distinct because a perfect hash is built over them, which rejects duplicates.
+         */
+        template<typename E, std::size_t N>
+        constexpr std::array<std::string_view, N> enum_names(const std::array<std::pair<E, std::string_view>, N>& value_to_name)
+        {
+            std::array<std::string_view, N> names = {};
+            for (std::size_t k = 0; k < N; ++k) {
+                names[k] = value_to_name[k].second;
+            }
+            return names;
+        }
+
+        /** Moves an index down a binary max-heap of indices until the heap property is restored. */
+        template<std::size_t N, typename Less>
+        constexpr void sift_down(std::array<std::size_t, N>& heap, std::size_t root, std::size_t end, const Less& less)
+        {
+            while (2 * root + 1 < end) {
+                std::size_t child = 2 * root + 1;
+                if (child + 1 < end && less(heap[child], heap[child + 1])) {
+                    ++child;
+                }
+                if (!less(heap[root], heap[child])) {
+                    return;
+                }
+                const std::size_t index = heap[root];
+                heap[root] = heap[child];
+                heap[child] = index;
+                root = child;
+            }
+        }
+
+        /**
+         * Orders a list of enumeration value and name pairs by value.
+         *
+         * Of several names listed for the same value, the first one listed is placed last, which is where lookup by
+         * value finds it. Heap sort keeps the number of steps at O(N log N), which matters when the list is
+         * ordered at compile time.
+         */
+        template<typename E, std::size_t N>
+        constexpr std::array<std::pair<E, std::string_view>, N> enum_sorted_by_value(const std::array<std::pair<E, std::string_view>, N>& value_to_name)
+        {
+            using integer_type = std::underlying_type_t<E>;
+
+            const auto less = [&value_to_name](std::size_t i, std::size_t j) {
+                const integer_type left = static_cast<integer_type>(value_to_name[i].first);
+                const integer_type right = static_cast<integer_type>(value_to_name[j].first);
+                return left < right || (left == right && i > j);
+            };
+
+            std::array<std::size_t, N> order = {};
+            for (std::size_t k = 0; k < N; ++k) {
+                order[k] = k;
+            }
+            for (std::size_t k = N / 2; k > 0; --k) {
+                sift_down(order, k - 1, N, less);
+            }
+            for (std::size_t end = N; end > 1; --end) {
+                const std::size_t index = order[0];
+                order[0] = order[end - 1];
+                order[end - 1] = index;
+                sift_down(order, 0, end - 1, less);
+            }
+
+            // `std::pair` has no constexpr assignment before C++20
+            std::array<std::pair<E, std::string_view>, N> items = {};
+            for (std::size_t k = 0; k < N; ++k) {
+                items[k].first = value_to_name[order[k]].first;
+                items[k].second = value_to_name[order[k]].second;
+            }
+            return items;
+        }
+
+        /** True if the enumeration values in a sorted list are consecutive integers. */
+        template<typename E, std::size_t N>
+        constexpr bool is_enum_dense(const std::array<std::pair<E, std::string_view>, N>& items)
+        {
+            using unsigned_type = std::make_unsigned_t<std::underlying_type_t<E>>;
+
+            for (std::size_t k = 0; k < N; ++k) {
+                const unsigned_type offset = static_cast<unsigned_type>(static_cast<unsigned_type>(items[k].first) - static_cast<unsigned_type>(items[0].first));
+                if (offset != k) {
+                    return false;
+                }
+            }
+            return true;
+        }
     }
 
     /**
      * Creates a converter that maps enumeration values to strings and vice versa.
      *
+     * Strings are mapped to values with a perfect hash built from the names. Values are mapped to strings by
+     * indexing a table if the values are consecutive integers, and with binary search otherwise. Both lookups
+     * are set up when the converter is constructed, which happens at compile time for a `constexpr` instance.
+     *
      * @tparam E An enumeration type.
      * @tparam N The number of elements in the enumeration.
      */
@@ -33,37 +134,76 @@ namespace persistence
     struct EnumConverter
     {
         static_assert(std::is_enum_v<E>, "expected an enumeration type");
-        static_assert(N >= 1, "expected at least one enumeration value");
 
         constexpr EnumConverter(std::array<std::pair<E, std::string_view>, N> value_to_name)
             : value_to_name(value_to_name)
+            , name_to_index(detail::enum_names(value_to_name))
+            , by_value(detail::enum_sorted_by_value(value_to_name))
+            , dense(detail::is_enum_dense(by_value))
         {}
 
         /** Generates the string representation of an enumeration value. */
-        std::string_view to_string(E value) const
+        constexpr std::string_view to_string(E value) const
         {
-            for (auto&& item : value_to_name) {
-                if (item.first == value) {
-                    return item.second;
-                }
+            if constexpr (N == 0) {
+                // an enumeration with no values has no names
+                static_cast<void>(value);
+                return std::string_view();
+            } else {
+                return find_name(value);
             }
-            return std::string_view();
         }
 
         /** Parses the string representation of an enumeration value. */
-        bool from_string(const std::string_view& name, E& value) const
+        constexpr bool from_string(const std::string_view& name, E& value) const
         {
-            for (auto&& item : value_to_name) {
+            if constexpr (N == 0) {
+                static_cast<void>(name);
+                static_cast<void>(value);
+                return false;
+            } else {
+                // the perfect hash yields an index for any string, which is a match only if the names agree
+                const auto& item = value_to_name[name_to_index.index(name)];
                 if (item.second == name) {
                     value = item.first;
                     return true;
                 }
+                return false;
             }
-            return false;
         }
 
     private:
+        using integer_type = std::underlying_type_t<E>;
+        using unsigned_type = std::make_unsigned_t<integer_type>;
+
+        constexpr std::string_view find_name(E value) const
+        {
+            if (dense) {
+                const unsigned_type offset = static_cast<unsigned_type>(static_cast<unsigned_type>(value) - static_cast<unsigned_type>(by_value[0].first));
+                if (offset < N) {
+                    return by_value[offset].second;
+                }
+                return std::string_view();
+            }
+
+            // find the last item whose value is not greater than the value sought, without branches in the loop
+            std::size_t first = 0;
+            std::size_t count = N;
+            while (count > 1) {
+                const std::size_t half = count / 2;
+                first = static_cast<integer_type>(by_value[first + half].first) <= static_cast<integer_type>(value) ? first + half : first;
+                count -= half;
+            }
+            if (by_value[first].first == value) {
+                return by_value[first].second;
+            }
+            return std::string_view();
+        }
+
         std::array<std::pair<E, std::string_view>, N> value_to_name;
+        PerfectHash<N> name_to_index;
+        std::array<std::pair<E, std::string_view>, N> by_value;
+        bool dense;
     };
 
     template<typename E, std::size_t N>
@@ -89,4 +229,21 @@ namespace persistence
     {
         return EnumConverter<E, N>(detail::to_array(value_to_name));
     }
+
+#ifdef PERSISTENCE_BOOST_DESCRIBE
+    namespace detail
+    {
+        template<typename E, template<class...> class L, typename... D>
+        constexpr auto make_described_enum_converter(L<D...>)
+        {
+            return EnumConverter<E, sizeof...(D)>(std::array<std::pair<E, std::string_view>, sizeof...(D)>{ {
+                std::pair<E, std::string_view>(D::value, std::string_view(D::name))...
+            } });
+        }
+
+        /** Converter built at compile time from the reflection metadata that `BOOST_DESCRIBE_ENUM` provides. */
+        template<typename E>
+        inline constexpr auto described_enum_converter = make_described_enum_converter<E>(::boost::describe::describe_enumerators<E>());
+    }
+#endif
 }
@@ -0,0 +1,269 @@
+#pragma once
+#include "detail/unlikely.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <istream>
+#include <memory>
+#if __has_include(<unistd.h>)
+#include <cerrno>
+#include <unistd.h>
+#define PERSISTENCE_FILE_DESCRIPTOR
+#endif
+
+namespace persistence
+{
+    /**
+     * Receives the contents of a JSON string value straight from the input, in pieces as the input is read.
+     */
+    class StringCapture
+    {
+    public:
+        virtual ~StringCapture() = default;
+
+        /**
+         * Receives the next piece of the string, which contains no escape sequences.
+         *
+         * @return False if the contents are rejected; the rest of the string is skipped.
+         */
+        virtual bool append(const char* data, std::size_t size) = 0;
+    };
+
+    /**
+     * Origin of JSON input that is read in pieces, such as a file or a socket, through a bounded buffer.
+     *
+     * Memory use of the source is bounded by its buffer no matter how large the input is. A parser may ask the source
+     * to capture the next string value, such as a long Base64-encoded string; the contents of the string are then
+     * passed on to the parser as they are read, and the reader sees an empty string instead of accumulating the
+     * contents. Escape sequences and what follows them are left to the reader.
+     *
+     * Implements the input stream concept of RapidJSON.
+     */
+    class InputSource
+    {
+    public:
+        using Ch = char;
+
+        /** Default number of characters read from the origin at a time. */
+        constexpr static std::size_t default_capacity = 65536;
+
+        explicit InputSource(std::size_t capacity = default_capacity)
+            : capacity(std::max(capacity, std::size_t(1)))
+            , buffer(new char[this->capacity])
+        {
+            cur = last = buffer.get();
+        }
+
+        InputSource(const InputSource&) = delete;
+        InputSource& operator=(const InputSource&) = delete;
+        virtual ~InputSource() = default;
+
+        char Peek()
+        {
+            PERSISTENCE_IF_UNLIKELY(cur == last) {
+                refill();
+            }
+            return *cur;
+        }
+
+        char Take()
+        {
+            const char c = Peek();
+            ++cur;
+            PERSISTENCE_IF_UNLIKELY(target != nullptr) {
+                observe(c);
+            }
+            return c;
+        }
+
+        /** The number of characters consumed so far. */
+        std::size_t Tell() const
+        {
+            return offset + static_cast<std::size_t>(cur - buffer.get());
+        }
+
+        // output is only written when parsing in situ, which a source does not support
+        char* PutBegin() { return nullptr; }
+        void Put(char) {}
+        void Flush() {}
+        std::size_t PutEnd(char*) { return 0; }
+
+        /**
+         * Passes the contents of the next string value on to a capture, provided that only whitespace, colons and
+         * commas come before the string; any other character cancels the request.
+         *
+         * @param recipient The recipient of the string contents, or null to cancel a previous request.
+         */
+        void capture(StringCapture* recipient)
+        {
+            target = recipient;
+        }
+
+        /** Cancels a pending request to capture a string value, if made by a given recipient. */
+        void release(const StringCapture* recipient)
+        {
+            if (target == recipient) {
+                target = nullptr;
+            }
+        }
+
+        /** False if reading from the origin has failed. */
+        bool good() const
+        {
+            return ok;
+        }
+
+    protected:
+        /**
+         * Reads characters from the origin.
+         *
+         * @param count Receives the number of characters read, zero at the end of the input.
+         * @return False if reading has failed.
+         */
+        virtual bool read(char* data, std::size_t capacity, std::size_t& count) = 0;
+
+    private:
+        void refill()
+        {
+            std::size_t count = 0;
+            if (!end) {
+                offset += static_cast<std::size_t>(last - buffer.get());
+                PERSISTENCE_IF_UNLIKELY(!read(buffer.get(), capacity, count)) {
+                    ok = false;
+                    count = 0;
+                }
+            }
+            cur = buffer.get();
+            if (count == 0) {
+                // the reader stops at a terminating null character
+                end = true;
+                buffer[0] = '\0';
+                count = 1;
+            }
+            last = cur + count;
+        }
+
+        void observe(char c)
+        {
+            if (c == '"') {
+                StringCapture& recipient = *target;
+                target = nullptr;
+                capture_string(recipient);
+            } else if (c != ' ' && c != '\n' && c != '\r' && c != '\t' && c != ':' && c != ',') {
+                target = nullptr;
+            }
+        }
+
+        /** Passes on characters up to the closing quote, or the first escape sequence or control character. */
+        void capture_string(StringCapture& recipient)
+        {
+            bool accepted = true;
+            while (true) {
+                if (cur == last) {
+                    refill();
+                }
+                char* p = cur;
+                while (p != last && *p != '"' && *p != '\\' && static_cast<unsigned char>(*p) >= 0x20) {
+                    ++p;
+                }
+                if (p != cur && accepted) {
+                    accepted = recipient.append(cur, static_cast<std::size_t>(p - cur));
+                }
+                cur = p;
+                if (p != last) {
+                    return;
+                }
+            }
+        }
+
+        std::size_t capacity;
+        std::unique_ptr<char[]> buffer;
+        char* cur;
+        char* last;
+        std::size_t offset = 0;
+        StringCapture* target = nullptr;
+        bool end = false;
+        bool ok = true;
+    };
+
+    /**
+     * Reads input from a C standard library file stream.
+     */
+    class FileSource : public InputSource
+    {
+    public:
+        explicit FileSource(std::FILE* file, std::size_t capacity = default_capacity)
+            : InputSource(capacity)
+            , file(file)
+        {}
+
+    protected:
+        bool read(char* data, std::size_t capacity, std::size_t& count) override
+        {
+            count = std::fread(data, 1, capacity, file);
+            return count > 0 || !std::ferror(file);
+        }
+
+    private:
+        std::FILE* file;
+    };
+
+    /**
+     * Reads input from a C++ input stream.
+     */
+    class InputStreamSource : public InputSource
+    {
+    public:
+        explicit InputStreamSource(std::istream& stream, std::size_t capacity = default_capacity)
+            : InputSource(capacity)
+            , stream(stream)
+        {}
+
+    protected:
+        bool read(char* data, std::size_t capacity, std::size_t& count) override
+        {
+            stream.read(data, static_cast<std::streamsize>(capacity));
+            count = static_cast<std::size_t>(stream.gcount());
+            return !stream.bad();
+        }
+
+    private:
+        std::istream& stream;
+    };
+
+#if defined(PERSISTENCE_FILE_DESCRIPTOR)
+    /**
+     * Reads input from a POSIX file descriptor such as a file, a pipe or a socket.
+     *
+     * Characters are passed on as soon as they arrive; the source does not wait for the buffer to fill.
+     */
+    class FileDescriptorSource : public InputSource
+    {
+    public:
+        explicit FileDescriptorSource(int fd, std::size_t capacity = default_capacity)
+            : InputSource(capacity)
+            , fd(fd)
+        {}
+
+    protected:
+        bool read(char* data, std::size_t capacity, std::size_t& count) override
+        {
+            while (true) {
+                const ssize_t result = ::read(fd, data, capacity);
+                if (result < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    count = 0;
+                    return false;
+                }
+                count = static_cast<std::size_t>(result);
+                return true;
+            }
+        }
+
+    private:
+        int fd;
+    };
+#endif
+}
@@ -1,22 +1,13 @@
 #pragma once
 #include "detail/defer.hpp"
-#include <charconv>
-#include <cstdlib>
+#include "detail/float_parser.hpp"
+#include "detail/integer_parser.hpp"
+#include <limits>
 #include <string_view>
+#include <type_traits>
 
 namespace persistence
 {
-    namespace detail
-    {
-        template<typename T>
-        bool parse_from_chars(const std::string_view& str, T& value)
-        {
-            const char* last = str.data() + str.size();
-            auto result = std::from_chars(str.data(), last, value);
-            return result.ec == std::errc() && result.ptr == last;
-        }
-    }
-
     template<typename T, typename Enable = void>
     struct NumberParser
     {
@@ -28,39 +19,16 @@ namespace persistence
     {
         bool parse(const std::string_view& str, T& value)
         {
-            return detail::parse_from_chars(str, value);
+            return detail::parse_integer(str.data(), str.data() + str.size(), value);
         }
     };
 
-#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
     template<typename T>
-    struct NumberParser<T, std::enable_if_t<std::is_floating_point_v<T>>>
+    struct NumberParser<T, std::enable_if_t<std::is_same_v<T, float> || std::is_same_v<T, double>>>
     {
         bool parse(const std::string_view& str, T& value)
         {
-            return detail::parse_from_chars(str, value);
-        }
-    };
-#else
-    template<>
-    struct NumberParser<float>
-    {
-        bool parse(const std::string_view& str, float& value)
-        {
-            char* last;
-            value = std::strtof(str.data(), &last);
-            return last == str.data() + str.size();
-        }
-    };
-
-    template<>
-    struct NumberParser<double>
-    {
-        bool parse(const std::string_view& str, double& value)
-        {
-            char* last;
-            value = std::strtod(str.data(), &last);
-            return last == str.data() + str.size();
+            return detail::parse_float(str.data(), str.data() + str.size(), value);
         }
     };
 
@@ -69,12 +37,19 @@ namespace persistence
     {
         bool parse(const std::string_view& str, long double& value)
         {
-            char* last;
-            value = std::strtold(str.data(), &last);
-            return last == str.data() + str.size();
+            if constexpr (std::numeric_limits<long double>::digits == std::numeric_limits<double>::digits) {
+                double result;
+                if (!detail::parse_float(str.data(), str.data() + str.size(), result)) {
+                    return false;
+                }
+                value = result;
+                return true;
+            } else {
+                // extended precision has no fast path
+                return detail::parse_float_fallback(str.data(), str.data() + str.size(), value);
+            }
         }
     };
-#endif
 
     template<typename T>
     bool parse_number(const std::string_view& str, T& value)
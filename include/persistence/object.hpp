@@ -1,5 +1,9 @@
 #pragma once
 #include "detail/defer.hpp"
+#include "detail/number_format.hpp"
+#include "detail/time_encoding.hpp"
+#include <optional>
+#include <type_traits>
 
 /**
  * Provides compile-time access to a string literal.
@@ -106,4 +110,75 @@ namespace persistence
         using Class = typename traits::class_type;
         return member::variable_default<Type, Class, Pointer, Descriptor>();
     }
+
+    /** True for member types whose digits can be limited; the float formatter handles `float` and `double` only. */
+    template<typename T>
+    struct is_formattable_member : std::bool_constant<std::is_same_v<T, float> || std::is_same_v<T, double>>
+    {};
+
+    template<typename T>
+    struct is_formattable_member<std::optional<T>> : std::bool_constant<std::is_same_v<T, float> || std::is_same_v<T, double>>
+    {};
+
+    /**
+     * Limits the number of digits after the decimal point when a floating-point member variable is written.
+     *
+     * ```
+     * & persistence::decimal_places<2>(MEMBER_VARIABLE(price))
+     * ```
+     *
+     * @tparam N The maximum number of digits after the decimal point.
+     */
+    template<int N, template<typename, class, auto, typename> class Variable, typename Type, class Class, auto Pointer, typename Descriptor>
+    constexpr auto decimal_places(Variable<Type, Class, Pointer, Descriptor>)
+    {
+        static_assert(N >= 0, "expected a non-negative number of decimal places");
+        static_assert(is_formattable_member<Type>::value, "expected a member variable of type float or double");
+        constexpr NumberFormat format = detail::number_format_of<Descriptor>();
+        return Variable<Type, Class, Pointer, detail::formatted_member_descriptor<Descriptor, N, format.significant_digits>>();
+    }
+
+    /**
+     * Limits the number of significant digits when a floating-point member variable is written.
+     *
+     * ```
+     * & persistence::significant_digits<4>(MEMBER_VARIABLE(reading))
+     * ```
+     *
+     * @tparam N The maximum number of significant digits.
+     */
+    template<int N, template<typename, class, auto, typename> class Variable, typename Type, class Class, auto Pointer, typename Descriptor>
+    constexpr auto significant_digits(Variable<Type, Class, Pointer, Descriptor>)
+    {
+        static_assert(N > 0, "expected a positive number of significant digits");
+        static_assert(is_formattable_member<Type>::value, "expected a member variable of type float or double");
+        constexpr NumberFormat format = detail::number_format_of<Descriptor>();
+        return Variable<Type, Class, Pointer, detail::formatted_member_descriptor<Descriptor, format.decimal_places, N>>();
+    }
+
+    template<typename T>
+    struct is_time_encodable_member : detail::is_time_encodable<T>
+    {};
+
+    template<typename T>
+    struct is_time_encodable_member<std::optional<T>> : detail::is_time_encodable<T>
+    {};
+
+    /**
+     * Selects how a time point member variable is represented in JSON, e.g. as an integer number of milliseconds
+     * since the UNIX epoch rather than an ISO 8601 string. The encoding applies to writing, parsing,
+     * (de-)serialization and the JSON schema alike.
+     *
+     * ```
+     * & persistence::time_encoding<persistence::TimeEncoding::epoch_milliseconds>(MEMBER_VARIABLE(created))
+     * ```
+     *
+     * @tparam Encoding The representation of the time point.
+     */
+    template<TimeEncoding Encoding, template<typename, class, auto, typename> class Variable, typename Type, class Class, auto Pointer, typename Descriptor>
+    constexpr auto time_encoding(Variable<Type, Class, Pointer, Descriptor>)
+    {
+        static_assert(is_time_encodable_member<Type>::value, "expected a member variable of type `time_point<system_clock>`");
+        return Variable<Type, Class, Pointer, detail::encoded_member_descriptor<Descriptor, Encoding>>();
+    }
 }
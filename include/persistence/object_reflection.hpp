@@ -1,4 +1,6 @@
 #pragma once
+#include "detail/number_format.hpp"
+#include "detail/time_encoding.hpp"
 #include <string_view>
 #include <type_traits>
 
@@ -33,6 +35,22 @@ namespace persistence
                 return Descriptor::name();
             }
 
+            /**
+             * The precision with which a floating-point member variable is written.
+             */
+            constexpr NumberFormat format() const
+            {
+                return detail::number_format_of<Descriptor>();
+            }
+
+            /**
+             * The representation of a time point member variable.
+             */
+            constexpr TimeEncoding time_encoding() const
+            {
+                return detail::time_encoding_of<Descriptor>();
+            }
+
             /**
              * The member variable pointer.
              */
@@ -0,0 +1,531 @@
+#pragma once
+#include "detail/unlikely.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#if __has_include(<version>)
+#include <version>
+#endif
+#if __has_include(<unistd.h>)
+#include <cerrno>
+#include <unistd.h>
+#define PERSISTENCE_FILE_DESCRIPTOR
+#endif
+
+namespace persistence
+{
+    /**
+     * Destination of JSON output, such as a string, a caller-supplied buffer or a file.
+     *
+     * Characters are written into a buffer owned or managed by the sink without any virtual calls. Only when the
+     * buffer is full does the sink get a chance to make room, e.g. by growing the buffer or by passing its contents
+     * on to a file. If the sink fails to make room, it enters a failed state: it reports the error through `good`,
+     * and discards any further output.
+     *
+     * Implements the output stream concept of RapidJSON.
+     */
+    class OutputSink
+    {
+    public:
+        using Ch = char;
+
+        OutputSink() = default;
+        OutputSink(const OutputSink&) = delete;
+        OutputSink& operator=(const OutputSink&) = delete;
+        virtual ~OutputSink() = default;
+
+        void Put(char c)
+        {
+            PERSISTENCE_IF_UNLIKELY(cur == last) {
+                make_room(1);
+            }
+            *cur++ = c;
+        }
+
+        void PutUnsafe(char c)
+        {
+            *cur++ = c;
+        }
+
+        /** Ensures there is space for a number of characters, which may then be written with `PutUnsafe`. */
+        void Reserve(std::size_t count)
+        {
+            PERSISTENCE_IF_UNLIKELY(available() < count) {
+                make_room(count);
+            }
+        }
+
+        /** Allocates space for a number of characters, and returns the position to write them to. */
+        char* Push(std::size_t count)
+        {
+            Reserve(count);
+            return PushUnsafe(count);
+        }
+
+        char* PushUnsafe(std::size_t count)
+        {
+            char* p = cur;
+            cur += count;
+            return p;
+        }
+
+        /** Releases characters at the end of the last space allocated with `Push`. */
+        void Pop(std::size_t count)
+        {
+            cur -= count;
+        }
+
+        /** The number of characters that can be written without making room. */
+        std::size_t available() const
+        {
+            return static_cast<std::size_t>(last - cur);
+        }
+
+        /** Commits all characters written so far to the destination. */
+        void Flush()
+        {
+            if (ok) {
+                ok = sync();
+            }
+        }
+
+        /** False if the sink has failed to make room for or to commit output. */
+        bool good() const
+        {
+            return ok;
+        }
+
+    protected:
+        /** Sets the space characters are written to. */
+        void set_buffer(char* first, char* last)
+        {
+            this->cur = first;
+            this->last = last;
+        }
+
+        /** Leaves the failed state, when a sink discards its output to start over. */
+        void reset_state()
+        {
+            ok = true;
+        }
+
+        /** The position the next character is written to. */
+        char* position() const
+        {
+            return cur;
+        }
+
+        /**
+         * Makes room for at least a number of characters past the current position, and updates the buffer with
+         * `set_buffer` accordingly. Characters before the current position must be preserved or committed.
+         *
+         * @return False if the sink cannot make room.
+         */
+        virtual bool grow(std::size_t count) = 0;
+
+        /** Commits characters before the current position to the destination. */
+        virtual bool sync()
+        {
+            return true;
+        }
+
+    private:
+        void make_room(std::size_t count)
+        {
+            PERSISTENCE_IF_LIKELY(ok && grow(count)) {
+                return;
+            }
+
+            // discard further output in a scratch area such that writers need not check for errors
+            ok = false;
+            if (scratch.size() < count) {
+                scratch.resize(std::max(count, std::size_t(256)));
+            }
+            set_buffer(scratch.data(), scratch.data() + scratch.size());
+        }
+
+        char* cur = nullptr;
+        char* last = nullptr;
+        bool ok = true;
+        std::vector<char> scratch;
+    };
+
+    inline void PutReserve(OutputSink& sink, std::size_t count)
+    {
+        sink.Reserve(count);
+    }
+
+    inline void PutUnsafe(OutputSink& sink, char c)
+    {
+        sink.PutUnsafe(c);
+    }
+
+    inline void PutN(OutputSink& sink, char c, std::size_t n)
+    {
+        std::memset(sink.Push(n), c, n);
+    }
+
+    /**
+     * Appends output to a string in place, with no intermediate buffer.
+     *
+     * The string is extended to its capacity while writing, and trimmed to the output when the sink is flushed. With
+     * C++23, the string is extended without initializing the characters that are about to be overwritten.
+     */
+    class StringSink : public OutputSink
+    {
+    public:
+        explicit StringSink(std::string& str)
+            : str(str)
+        {
+            set_buffer_end(str.size());
+        }
+
+        ~StringSink()
+        {
+            Flush();
+        }
+
+    protected:
+        bool grow(std::size_t count) override
+        {
+            const std::size_t size = static_cast<std::size_t>(position() - str.data());
+            str.resize(size);
+            str.reserve(std::max(size + count, 2 * size));
+            set_buffer_end(size);
+            return true;
+        }
+
+        bool sync() override
+        {
+            const std::size_t size = static_cast<std::size_t>(position() - str.data());
+            str.resize(size);
+            set_buffer(str.data() + size, str.data() + size);
+            return true;
+        }
+
+    private:
+        /** Makes the unused capacity of the string available past a position. */
+        void set_buffer_end(std::size_t size)
+        {
+            const std::size_t capacity = std::max(str.capacity(), std::size_t(256));
+#if defined(__cpp_lib_string_resize_and_overwrite)
+            // characters past the position are overwritten before they are read
+            str.resize_and_overwrite(capacity, [](char*, std::size_t n) { return n; });
+#else
+            str.resize(capacity);
+#endif
+            set_buffer(str.data() + size, str.data() + str.size());
+        }
+
+        std::string& str;
+    };
+
+    /**
+     * Writes output to a fixed caller-supplied buffer, failing when the output does not fit.
+     */
+    class FixedBufferSink : public OutputSink
+    {
+    public:
+        FixedBufferSink(char* buffer, std::size_t capacity)
+            : buffer(buffer)
+        {
+            set_buffer(buffer, buffer + capacity);
+        }
+
+        /** The output written to the buffer, unless the sink has overflowed. */
+        const char* data() const
+        {
+            return buffer;
+        }
+
+        /** The number of characters written to the buffer, or zero if the sink has overflowed. */
+        std::size_t size() const
+        {
+            return good() ? static_cast<std::size_t>(position() - buffer) : 0;
+        }
+
+        /** True if the output has not fit into the buffer. */
+        bool overflow() const
+        {
+            return !good();
+        }
+
+    protected:
+        bool grow(std::size_t) override
+        {
+            return false;
+        }
+
+    private:
+        char* buffer;
+    };
+
+    /**
+     * Writes output to a growable memory buffer owned by the sink.
+     *
+     * Clearing the sink keeps the memory allocated, such that the buffer can be reused as an arena for a
+     * sequence of outputs without further allocations.
+     */
+    class MemorySink : public OutputSink
+    {
+    public:
+        explicit MemorySink(std::size_t capacity = 256)
+            : buffer(static_cast<char*>(std::malloc(capacity)))
+            , capacity(buffer != nullptr ? capacity : 0)
+        {
+            set_buffer(buffer, buffer + this->capacity);
+        }
+
+        ~MemorySink()
+        {
+            std::free(buffer);
+        }
+
+        const char* data() const
+        {
+            return buffer;
+        }
+
+        /** The number of characters written, or zero if the sink has run out of memory. */
+        std::size_t size() const
+        {
+            return good() ? static_cast<std::size_t>(position() - buffer) : 0;
+        }
+
+        std::string_view str() const
+        {
+            return std::string_view(data(), size());
+        }
+
+        /** Discards all output, keeping the memory allocated, and clears the failed state. */
+        void clear()
+        {
+            reset_state();
+            set_buffer(buffer, buffer + capacity);
+        }
+
+    protected:
+        bool grow(std::size_t count) override
+        {
+            // large blocks are typically moved by remapping memory pages rather than by copying
+            const std::size_t size = this->size();
+            const std::size_t new_capacity = std::max(size + count, 2 * capacity);
+            char* new_buffer = static_cast<char*>(std::realloc(buffer, new_capacity));
+            PERSISTENCE_IF_UNLIKELY(new_buffer == nullptr) {
+                return false;
+            }
+            buffer = new_buffer;
+            capacity = new_capacity;
+            set_buffer(buffer + size, buffer + capacity);
+            return true;
+        }
+
+    private:
+        char* buffer;
+        std::size_t capacity;
+    };
+
+    /**
+     * Counts the characters of output without storing them.
+     *
+     * Output is written into a small scratch buffer that is reused whenever it is full, such that the count
+     * reflects exactly what any other sink would receive.
+     */
+    class CountingSink : public OutputSink
+    {
+    public:
+        CountingSink()
+            : buffer(1024)
+        {
+            set_buffer(buffer.data(), buffer.data() + buffer.size());
+        }
+
+        /** The number of characters written so far. */
+        std::size_t size() const
+        {
+            return count + static_cast<std::size_t>(position() - buffer.data());
+        }
+
+    protected:
+        bool grow(std::size_t required) override
+        {
+            count = size();
+            if (buffer.size() < required) {
+                buffer.resize(required);
+            }
+            set_buffer(buffer.data(), buffer.data() + buffer.size());
+            return true;
+        }
+
+    private:
+        std::vector<char> buffer;
+        std::size_t count = 0;
+    };
+
+    /**
+     * Writes output to a destination such as a file or a socket through a bounded buffer, passing the contents of
+     * the buffer on to the destination whenever they reach a watermark.
+     *
+     * Memory use is bounded by the watermark no matter how large the output is. Only a single value that requests
+     * more contiguous space than the watermark permits, such as a long string, enlarges the buffer, until the next
+     * time the buffer is passed on.
+     */
+    class BufferedSink : public OutputSink
+    {
+    public:
+        /** Default number of characters buffered before output is passed on to the destination. */
+        constexpr static std::size_t default_watermark = 65536;
+
+        explicit BufferedSink(std::size_t watermark = default_watermark)
+            : watermark(std::max(watermark, std::size_t(1)))
+        {
+            allocate(this->watermark);
+        }
+
+    protected:
+        /**
+         * Passes characters on to the destination.
+         *
+         * @return False if not all characters could be written, e.g. because the disk is full.
+         */
+        virtual bool write(const char* data, std::size_t size) = 0;
+
+        bool grow(std::size_t count) override
+        {
+            if (!sync()) {
+                return false;
+            }
+            if (count > watermark) {
+                if (count > capacity) {
+                    allocate(count);
+                }
+                set_buffer(buffer.get(), buffer.get() + count);
+            } else if (capacity > watermark) {
+                // release space allocated for a single large value
+                allocate(watermark);
+            }
+            return true;
+        }
+
+        bool sync() override
+        {
+            const std::size_t size = static_cast<std::size_t>(position() - buffer.get());
+            set_buffer(buffer.get(), buffer.get() + watermark);
+            return size == 0 || write(buffer.get(), size);
+        }
+
+    private:
+        void allocate(std::size_t size)
+        {
+            buffer.reset(new char[size]);
+            capacity = size;
+            set_buffer(buffer.get(), buffer.get() + watermark);
+        }
+
+        std::unique_ptr<char[]> buffer;
+        std::size_t capacity = 0;
+        std::size_t watermark;
+    };
+
+    /**
+     * Writes output to a C standard library file stream.
+     *
+     * The file stream is not flushed; output may remain in the buffer of the file stream until it is flushed.
+     */
+    class FileSink : public BufferedSink
+    {
+    public:
+        explicit FileSink(std::FILE* file, std::size_t watermark = default_watermark)
+            : BufferedSink(watermark)
+            , file(file)
+        {}
+
+        ~FileSink()
+        {
+            Flush();
+        }
+
+    protected:
+        bool write(const char* data, std::size_t size) override
+        {
+            return std::fwrite(data, 1, size, file) == size;
+        }
+
+    private:
+        std::FILE* file;
+    };
+
+    /**
+     * Writes output to a C++ output stream.
+     *
+     * The output stream is not flushed; output may remain in the buffer of the output stream until it is flushed.
+     */
+    class OutputStreamSink : public BufferedSink
+    {
+    public:
+        explicit OutputStreamSink(std::ostream& stream, std::size_t watermark = default_watermark)
+            : BufferedSink(watermark)
+            , stream(stream)
+        {}
+
+        ~OutputStreamSink()
+        {
+            Flush();
+        }
+
+    protected:
+        bool write(const char* data, std::size_t size) override
+        {
+            return static_cast<bool>(stream.write(data, static_cast<std::streamsize>(size)));
+        }
+
+    private:
+        std::ostream& stream;
+    };
+
+#if defined(PERSISTENCE_FILE_DESCRIPTOR)
+    /**
+     * Writes output to a POSIX file descriptor such as a file, a pipe or a socket.
+     */
+    class FileDescriptorSink : public BufferedSink
+    {
+    public:
+        explicit FileDescriptorSink(int fd, std::size_t watermark = default_watermark)
+            : BufferedSink(watermark)
+            , fd(fd)
+        {}
+
+        ~FileDescriptorSink()
+        {
+            Flush();
+        }
+
+    protected:
+        bool write(const char* data, std::size_t size) override
+        {
+            while (size > 0) {
+                const ssize_t count = ::write(fd, data, size);
+                if (count < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    return false;
+                }
+                data += count;
+                size -= static_cast<std::size_t>(count);
+            }
+            return true;
+        }
+
+    private:
+        int fd;
+    };
+#endif
+}
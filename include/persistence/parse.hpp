@@ -1,6 +1,8 @@
 #pragma once
 #include "parse_base.hpp"
 #include "exception.hpp"
+#include "utf8.hpp"
+#include "detail/unlikely.hpp"
 #include <rapidjson/reader.h>
 #include <rapidjson/error/en.h>
 
@@ -8,29 +10,83 @@ namespace persistence
 {
     namespace detail
     {
-        template<typename T>
+        /**
+         * True if numbers are converted by the reader or read straight from the input.
+         *
+         * With `rapidjson::kParseNumbersAsStringsFlag`, the reader still converts each number, and copies its literal
+         * twice on top, so passing numbers as strings is always slower than having them converted; arrays of numbers
+         * are read by a dedicated number scanner either way.
+         */
+        template<unsigned ParseFlags>
+        inline constexpr bool has_converted_numbers = (ParseFlags & rapidjson::kParseNumbersAsStringsFlag) == 0;
+
+        template<unsigned ParseFlags, typename T>
         rapidjson::ParseResult parse(ReaderContext& context, const std::string& str, T& value)
         {
+            static_assert(has_converted_numbers<ParseFlags>, "parsing numbers as strings is not supported, use the default flags");
+
+            if constexpr (validate_utf8<ParseFlags>) {
+                // the entire input is at hand, and one pass over it also covers strings that parsers scan directly
+                auto result = check_utf8(str);
+                PERSISTENCE_IF_UNLIKELY(result.IsError()) {
+                    return result;
+                }
+            }
+
             context.emplace<JsonParser<T>>(context, value);
+            context.dispatcher.path.enabled = may_have_back_references_v<T>;
             rapidjson::Reader reader;
-            rapidjson::StringStream stream(str.data());
+            detail::StringInput stream(str.data());
+            if constexpr ((ParseFlags & (rapidjson::kParseCommentsFlag | rapidjson::kParseNanAndInfFlag | rapidjson::kParseTrailingCommasFlag)) == 0) {
+                // input is scanned directly only if the grammar is strict JSON
+                context.input = &stream;
+            }
+            return reader.Parse<reader_flags<ParseFlags>>(stream, context.dispatcher);
+        }
+
+        template<unsigned ParseFlags, typename T>
+        rapidjson::ParseResult parse(ReaderContext& context, InputSource& source, T& value)
+        {
+            static_assert(has_converted_numbers<ParseFlags>, "parsing numbers as strings is not supported, use the default flags");
 
-            // pass flag `kParseNumbersAsStringsFlag` as non-type template argument to prevent
-            // rapidjson from parsing numbers and emitting type-specific events
-            return reader.Parse(stream, context.dispatcher);
+            // parsers may ask the source to capture strings as soon as they are constructed
+            context.source = &source;
+            context.emplace<JsonParser<T>>(context, value);
+            context.dispatcher.path.enabled = may_have_back_references_v<T>;
+            // input arrives in pieces, so each string is validated as it is delivered
+            context.dispatcher.validate_utf8 = validate_utf8<ParseFlags>;
+            rapidjson::Reader reader;
+            auto result = reader.Parse<reader_flags<ParseFlags>>(source, context.dispatcher);
+            source.capture(nullptr);
+            PERSISTENCE_IF_UNLIKELY(context.dispatcher.invalid_utf8) {
+                return rapidjson::ParseResult(rapidjson::kParseErrorStringInvalidEncoding, result.Offset());
+            }
+            return result;
         }
     }
 
-    template<typename T>
+    /**
+     * Parses a JSON string into a C++ object.
+     *
+     * @tparam ParseFlags RapidJSON parse flags. With `rapidjson::kParseValidateEncodingFlag`, the input is validated
+     * as UTF-8 with vector instructions before it is parsed, in place of the slower validation built into RapidJSON.
+     * `rapidjson::kParseNumbersAsStringsFlag` is not supported.
+     */
+    template<typename T, unsigned ParseFlags = rapidjson::kParseDefaultFlags>
     bool parse(const std::string& str, T& value)
     {
         JsonParseEventDispatcher dispatcher;
         ReaderContext context(dispatcher);
-        auto result = detail::parse(context, str, value);
+        auto result = detail::parse<ParseFlags>(context, str, value);
         return !result.IsError();
     }
 
-    template<typename T>
+    /**
+     * Parses a JSON string into a C++ object, throwing an exception on error.
+     *
+     * @tparam ParseFlags RapidJSON parse flags, see the non-throwing variant.
+     */
+    template<typename T, unsigned ParseFlags = rapidjson::kParseDefaultFlags>
     T parse(const std::string& str)
     {
         static_assert(!std::is_const_v<T> && !std::is_volatile_v<T> && !std::is_reference_v<T>, "expected a type without qualifiers");
@@ -38,7 +94,7 @@ namespace persistence
         T obj;
         JsonParseEventDispatcher dispatcher;
         ReaderContext context(dispatcher);
-        auto result = detail::parse(context, str, obj);
+        auto result = detail::parse<ParseFlags>(context, str, obj);
         if (result.IsError()) {
             if (context.has_error()) {
                 throw JsonParseError(context.get_error(), result.Offset());
@@ -48,4 +104,49 @@ namespace persistence
         }
         return obj;
     }
+
+    /**
+     * Parses JSON input read in pieces from a source such as a file into a C++ object.
+     *
+     * Memory use is independent of the size of the input, except for the C++ object itself. Sequences of bytes are
+     * decoded from Base64 as their strings are read.
+     *
+     * @tparam ParseFlags RapidJSON parse flags. With `rapidjson::kParseValidateEncodingFlag`, string values and object
+     * keys are validated as UTF-8 as they are read.
+     * @return False if the input is not valid JSON, does not match the C++ type, or cannot be read.
+     */
+    template<typename T, unsigned ParseFlags = rapidjson::kParseDefaultFlags>
+    bool parse(InputSource& source, T& value)
+    {
+        JsonParseEventDispatcher dispatcher;
+        ReaderContext context(dispatcher);
+        auto result = detail::parse<ParseFlags>(context, source, value);
+        return !result.IsError() && source.good();
+    }
+
+    /**
+     * Parses JSON input read in pieces from a source into a C++ object, throwing an exception on error.
+     *
+     * @tparam ParseFlags RapidJSON parse flags.
+     */
+    template<typename T, unsigned ParseFlags = rapidjson::kParseDefaultFlags>
+    T parse(InputSource& source)
+    {
+        static_assert(!std::is_const_v<T> && !std::is_volatile_v<T> && !std::is_reference_v<T>, "expected a type without qualifiers");
+
+        T obj;
+        JsonParseEventDispatcher dispatcher;
+        ReaderContext context(dispatcher);
+        auto result = detail::parse<ParseFlags>(context, source, obj);
+        if (!source.good()) {
+            throw JsonParseError("failed to read input", source.Tell());
+        } else if (result.IsError()) {
+            if (context.has_error()) {
+                throw JsonParseError(context.get_error(), result.Offset());
+            } else {
+                throw JsonParseError(rapidjson::GetParseError_En(result.Code()), result.Offset());
+            }
+        }
+        return obj;
+    }
 }
@@ -11,10 +11,12 @@
 #include "parse_array.hpp"
 #include "parse_bytes.hpp"
 #include "parse_datetime.hpp"
+#include "parse_decimal.hpp"
 #include "parse_enum.hpp"
 #include "parse_map.hpp"
 #include "parse_set.hpp"
 #include "parse_string.hpp"
+#include "parse_variant.hpp"
 #include "parse_vector.hpp"
 #if __cplusplus >= 202002L
 #include "parse_date.hpp"
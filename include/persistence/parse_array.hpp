@@ -1,5 +1,6 @@
 #pragma once
 #include "parse_base.hpp"
+#include "parse_items.hpp"
 #include <array>
 
 namespace persistence
@@ -136,14 +137,75 @@ namespace persistence
         C& container;
     };
 
+    /**
+     * Parses a JSON array of numbers into a C++ `array<T, N>` efficiently.
+     *
+     * @tparam Integer or floating-point type.
+     */
+    template<typename T, std::size_t N>
+    struct JsonNumberFixedArrayParser : JsonNumberItemParseHandler<T, JsonNumberFixedArrayParser<T, N>>
+    {
+        JsonNumberFixedArrayParser(ReaderContext& context, std::array<T, N>& container)
+            : JsonNumberItemParseHandler<T, JsonNumberFixedArrayParser<T, N>>(context)
+            , container(container)
+        {}
+
+        bool parse(const JsonArrayEnd&) override
+        {
+            PERSISTENCE_IF_UNLIKELY(!full()) {
+                this->context.fail("expected JSON token: " + std::string(JsonValueNumber::name) + "; got: " + std::string(JsonArrayEnd::name));
+                return false;
+            }
+
+            this->context.pop();
+            return true;
+        }
+
+        using JsonNumberItemParseHandler<T, JsonNumberFixedArrayParser<T, N>>::parse;
+
+        bool full() const
+        {
+            return index == N;
+        }
+
+        void append(T value)
+        {
+            container[index++] = value;
+        }
+
+    private:
+        std::array<T, N>& container;
+        std::size_t index = 0;
+    };
+
     template<typename T, std::size_t N>
-    struct JsonParser<std::array<T, N>> : JsonFixedArrayParser<std::array<T, N>, 0, N + 1>
+    struct JsonParser<std::array<T, N>, std::enable_if_t<!is_scanned_number_v<T>>> : JsonFixedArrayParser<std::array<T, N>, 0, N + 1>
     {
         using json_type = JsonArrayStart;
 
         using JsonFixedArrayParser<std::array<T, N>, 0, N + 1>::JsonFixedArrayParser;
     };
 
+    template<typename T, std::size_t N>
+    struct JsonParser<std::array<T, N>, std::enable_if_t<is_scanned_number_v<T>>> : JsonParseHandler<JsonArrayStart>
+    {
+        using json_type = JsonArrayStart;
+
+        JsonParser(ReaderContext& context, std::array<T, N>& ref)
+            : JsonParseHandler<JsonArrayStart>(context)
+            , ref(ref)
+        {}
+
+        bool parse(const JsonArrayStart&) override
+        {
+            context.replace<JsonNumberFixedArrayParser<T, N>>(context, ref);
+            return true;
+        }
+
+    private:
+        std::array<T, N>& ref;
+    };
+
     template<typename T1, typename T2>
     struct JsonParser<std::pair<T1, T2>> : JsonFixedArrayParser<std::pair<T1, T2>, 0, 3>
     {
@@ -159,4 +221,17 @@ namespace persistence
 
         using JsonFixedArrayParser<std::tuple<T...>, 0, sizeof...(T) + 1>::JsonFixedArrayParser;
     };
+
+    template<typename T, std::size_t N, typename Visited>
+    struct may_have_back_references<std::array<T, N>, Visited> : may_have_back_references<T, Visited>
+    {};
+
+    template<typename T1, typename T2, typename Visited>
+    struct may_have_back_references<std::pair<T1, T2>, Visited>
+        : std::disjunction<may_have_back_references<T1, Visited>, may_have_back_references<T2, Visited>>
+    {};
+
+    template<typename... T, typename Visited>
+    struct may_have_back_references<std::tuple<T...>, Visited> : std::disjunction<may_have_back_references<T, Visited>...>
+    {};
 }
@@ -3,7 +3,14 @@
 #include "detail/defer.hpp"
 #include "detail/parse_event.hpp"
 #include "detail/polymorphic_stack.hpp"
+#include "detail/string_input.hpp"
+#include "input_source.hpp"
+#include <memory>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 namespace persistence
 {
@@ -51,11 +58,94 @@ namespace persistence
             error_message = std::move(reason);
         }
 
+        void clear_error()
+        {
+            error_message.clear();
+        }
+
+        /** Returns the JSON Pointer to the value being parsed. */
+        std::string path() const
+        {
+            return dispatcher.path.str();
+        }
+
+        /** Returns the object created at a given JSON Pointer location, or null if there is no such object. */
+        const std::shared_ptr<void>* get(const std::string& path) const
+        {
+            auto it = references.find(path);
+            if (it != references.end()) {
+                return &it->second;
+            } else {
+                return nullptr;
+            }
+        }
+
+        /** Records the object created at a given JSON Pointer location. */
+        void put(std::string&& path, std::shared_ptr<void> object)
+        {
+            auto result = references.emplace(std::move(path), std::move(object));
+            if (result.second && attempts > 0) {
+                recorded.push_back(&result.first->first);
+            }
+        }
+
+        /**
+         * Starts a tentative parse whose recorded objects are discarded if the parse is abandoned.
+         *
+         * @return A mark to pass to `commit` or `rollback`.
+         */
+        std::size_t begin_attempt()
+        {
+            ++attempts;
+            return recorded.size();
+        }
+
+        /** Keeps the objects recorded since a tentative parse started. */
+        void commit(std::size_t)
+        {
+            if (--attempts == 0) {
+                // objects are kept for good unless an enclosing tentative parse is abandoned
+                recorded.clear();
+            }
+        }
+
+        /** Discards the objects recorded since a tentative parse started. */
+        void rollback(std::size_t mark)
+        {
+            while (recorded.size() > mark) {
+                references.erase(references.find(*recorded.back()));
+                recorded.pop_back();
+            }
+            --attempts;
+        }
+
         JsonParseEventDispatcher& dispatcher;
 
+        /**
+         * The null-terminated JSON input being read, or null if tokens do not come straight from the input, e.g.
+         * when buffered tokens are replayed.
+         *
+         * When parsing an array item, a parser may consume subsequent items on its own, as long as it leaves the
+         * input position past an item, where the reader expects a comma or the end of the array.
+         */
+        detail::StringInput* input = nullptr;
+
+        /**
+         * The source the JSON input is read from in pieces, or null if the input is a string in memory.
+         *
+         * A parser for a value that is expected to be a long string may ask the source to capture the string, as long
+         * as the parser is constructed before the reader reaches the value.
+         */
+        InputSource* source = nullptr;
+
     private:
         detail::PolymorphicStack<JsonParseEvent> stack;
         std::string error_message;
+        std::unordered_map<std::string, std::shared_ptr<void>> references;
+
+        /** Locations recorded during tentative parses, in the order the objects were created. */
+        std::vector<const std::string*> recorded;
+        std::size_t attempts = 0;
     };
 
     /** Attempts to parse one of the expected JSON tokens. */
@@ -153,6 +243,43 @@ namespace persistence
         ReaderContext& context;
     };
 
+    /**
+     * Attempts to parse one of the expected JSON tokens, where some tokens are given as a tuple.
+     *
+     * Parsers for C++ types that may be represented with several JSON types (e.g. variants) declare their JSON type as
+     * a tuple of tokens.
+     */
+    template<typename... ExpectTokens, typename... OtherTokens>
+    struct JsonParseHandler<std::tuple<ExpectTokens...>, OtherTokens...> : JsonParseHandler<ExpectTokens..., OtherTokens...>
+    {
+        using JsonParseHandler<ExpectTokens..., OtherTokens...>::JsonParseHandler;
+    };
+
+    /** Maps a JSON token to the token a C++ type declares as its JSON type; all numeric tokens map to `JsonValueNumber`. */
+    template<typename Token>
+    struct json_token_category
+    {
+        using type = Token;
+    };
+
+    template<> struct json_token_category<JsonValueInteger> { using type = JsonValueNumber; };
+    template<> struct json_token_category<JsonValueUnsigned> { using type = JsonValueNumber; };
+    template<> struct json_token_category<JsonValueInteger64> { using type = JsonValueNumber; };
+    template<> struct json_token_category<JsonValueUnsigned64> { using type = JsonValueNumber; };
+    template<> struct json_token_category<JsonValueDouble> { using type = JsonValueNumber; };
+
+    /** True if a JSON token can start a value whose JSON type (or tuple of JSON types) is given. */
+    template<typename JsonType, typename Token>
+    struct is_json_type : std::is_same<JsonType, typename json_token_category<Token>::type>
+    {};
+
+    template<typename... JsonTypes, typename Token>
+    struct is_json_type<std::tuple<JsonTypes...>, Token> : std::disjunction<is_json_type<JsonTypes, Token>...>
+    {};
+
+    template<typename JsonType, typename Token>
+    constexpr bool is_json_type_v = is_json_type<JsonType, Token>::value;
+
     template<typename T, typename Enable = void>
     struct JsonParser
     {
@@ -160,4 +287,23 @@ namespace persistence
         // headers are included, and (de-)serialization is supported for the type
         static_assert(detail::fail<T>, "expected a type that can be deserialized from JSON");
     };
+
+    /**
+     * True if a value of the type may hold objects that are shared by back-reference, in which case the location of
+     * each value is tracked while parsing.
+     *
+     * Values parsed from a JSON scalar hold none. Parsers of compound types specialize this trait for the types they
+     * contain; any other type parsed from a JSON object or array is assumed to hold some.
+     *
+     * @tparam Visited The classes whose members are being inspected, which ends the inspection of recursive types.
+     */
+    template<typename T, typename Visited = std::tuple<>, typename Enable = void>
+    struct may_have_back_references : std::bool_constant<
+        is_json_type_v<typename JsonParser<T>::json_type, JsonObjectStart> ||
+        is_json_type_v<typename JsonParser<T>::json_type, JsonArrayStart>
+    >
+    {};
+
+    template<typename T>
+    constexpr bool may_have_back_references_v = may_have_back_references<T>::value;
 }
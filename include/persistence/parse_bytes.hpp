@@ -1,9 +1,74 @@
 #pragma once
 #include "base64.hpp"
 #include "parse_base.hpp"
+#include "parse_vector.hpp"
+#include <string_view>
+#include <type_traits>
 
 namespace persistence
 {
+    namespace detail
+    {
+        /**
+         * Decodes a Base64-encoded string into a byte sink in pieces, as the string is read from an input source.
+         *
+         * If the source captures the string, the reader passes on only the part of the string that the source has
+         * left to it, which is empty unless the string has escape sequences.
+         */
+        class Base64Capture : public StringCapture
+        {
+        public:
+            explicit Base64Capture(ByteSink& sink)
+                : decoder(sink)
+            {}
+
+            ~Base64Capture()
+            {
+                // the parser may be done before the reader reaches another string
+                if (source != nullptr) {
+                    source->release(this);
+                }
+            }
+
+            /** Asks the input source, if any, to capture the next string value. */
+            void request(ReaderContext& context)
+            {
+                source = context.source;
+                if (source != nullptr) {
+                    source->capture(this);
+                }
+            }
+
+            bool append(const char* data, std::size_t size) override
+            {
+                captured = true;
+                return decoder.update(data, size);
+            }
+
+            /** Decodes the part of the string passed on by the reader, and completes decoding. */
+            bool finish(ReaderContext& context, std::string_view rest)
+            {
+                captured = false;
+                PERSISTENCE_IF_UNLIKELY(!decoder.update(rest.data(), rest.size()) || !decoder.finish()) {
+                    if (decoder.sink_failed()) {
+                        context.fail("failed to store sequence of bytes");
+                    } else {
+                        context.fail("invalid Base64-encoding for sequence of bytes");
+                    }
+                    return false;
+                }
+                return true;
+            }
+
+            /** True if some of the string has been captured from the input source. */
+            bool captured = false;
+
+        private:
+            Base64Decoder decoder;
+            InputSource* source = nullptr;
+        };
+    }
+
     template<>
     struct JsonParser<byte_vector> : JsonParseHandler<JsonValueString>
     {
@@ -12,13 +77,26 @@ namespace persistence
         JsonParser(ReaderContext& context, byte_vector& ref)
             : JsonParseHandler(context)
             , ref(ref)
-        {}
+            , sink(ref)
+            , capture(sink)
+        {
+            if (context.source != nullptr) {
+                ref.clear();
+                capture.request(context);
+            }
+        }
 
         bool parse(const JsonValueString& s) override
         {
-            PERSISTENCE_IF_UNLIKELY(!base64_decode(s.literal, ref)) {
-                context.fail("invalid Base64-encoding for sequence of bytes");
-                return false;
+            if (capture.captured) {
+                PERSISTENCE_IF_UNLIKELY(!capture.finish(context, s.literal)) {
+                    return false;
+                }
+            } else {
+                PERSISTENCE_IF_UNLIKELY(!base64_decode(s.literal, ref)) {
+                    context.fail("invalid Base64-encoding for sequence of bytes");
+                    return false;
+                }
             }
 
             context.pop();
@@ -27,5 +105,91 @@ namespace persistence
 
     private:
         byte_vector& ref;
+        detail::ByteVectorSink sink;
+        detail::Base64Capture capture;
+    };
+
+    /**
+     * Parses a JSON array of Base64-encoded strings into a C++ `vector<byte_vector>`.
+     *
+     * When the input is read from a source, the array asks the source to capture each item in turn, before the
+     * reader reaches the item.
+     */
+    template<>
+    struct JsonArrayParser<byte_vector> : JsonParseHandler<JsonValueString, JsonArrayEnd>
+    {
+        JsonArrayParser(ReaderContext& context, std::vector<byte_vector>& container)
+            : JsonParseHandler(context)
+            , container(container)
+            , sink(item)
+            , capture(sink)
+        {
+            capture.request(context);
+        }
+
+        bool parse(const JsonArrayEnd&) override
+        {
+            context.pop();
+            return true;
+        }
+
+        bool parse(const JsonValueString& s) override
+        {
+            if (capture.captured) {
+                PERSISTENCE_IF_UNLIKELY(!capture.finish(context, s.literal)) {
+                    return false;
+                }
+                container.push_back(std::move(item));
+                item.clear();
+            } else {
+                PERSISTENCE_IF_UNLIKELY(!base64_decode(s.literal, container.emplace_back())) {
+                    context.fail("invalid Base64-encoding for sequence of bytes");
+                    return false;
+                }
+            }
+
+            capture.request(context);
+            return true;
+        }
+
+    private:
+        std::vector<byte_vector>& container;
+        byte_vector item;
+        detail::ByteVectorSink sink;
+        detail::Base64Capture capture;
     };
+
+    /**
+     * Parses a Base64-encoded JSON string into a user-defined byte sink, e.g. to store a large binary value in a file
+     * as it is parsed.
+     */
+    template<typename T>
+    struct JsonParser<T, std::enable_if_t<std::is_base_of_v<ByteSink, T>>> : JsonParseHandler<JsonValueString>
+    {
+        using json_type = JsonValueString;
+
+        JsonParser(ReaderContext& context, T& ref)
+            : JsonParseHandler(context)
+            , capture(ref)
+        {
+            capture.request(context);
+        }
+
+        bool parse(const JsonValueString& s) override
+        {
+            PERSISTENCE_IF_UNLIKELY(!capture.finish(context, s.literal)) {
+                return false;
+            }
+
+            context.pop();
+            return true;
+        }
+
+    private:
+        detail::Base64Capture capture;
+    };
+
+    template<typename Visited>
+    struct may_have_back_references<byte_vector, Visited> : std::false_type
+    {};
 }
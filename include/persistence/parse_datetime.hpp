@@ -1,7 +1,10 @@
 #pragma once
 #include "datetime.hpp"
 #include "parse_base.hpp"
+#include "number.hpp"
 #include "detail/unlikely.hpp"
+#include <cstdint>
+#include <limits>
 
 namespace persistence
 {
@@ -15,10 +18,21 @@ namespace persistence
             , ref(ref)
         {}
 
+        JsonParser(ReaderContext& context, timestamp& ref, TimeEncoding encoding)
+            : JsonParseHandler(context)
+            , ref(ref)
+            , encoding(encoding)
+        {}
+
         bool parse(const JsonValueString& s) override
         {
+            PERSISTENCE_IF_UNLIKELY(encoding != TimeEncoding::iso8601) {
+                context.fail("expected JSON token: number; got: " + std::string(JsonValueString::name));
+                return false;
+            }
+
             PERSISTENCE_IF_UNLIKELY(!parse_datetime(s.literal.data(), s.literal.size(), ref)) {
-                context.fail("invalid ISO-8601 date-time; expected: YYYY-MM-DDTHH:MM:SSZ, got: " + std::string(s.literal));
+                context.fail("invalid ISO-8601 date-time; expected: YYYY-MM-DDTHH:MM:SS[.fff](Z|+hh:mm), got: " + std::string(s.literal));
                 return false;
             }
 
@@ -26,7 +40,66 @@ namespace persistence
             return true;
         }
 
+        bool parse(const JsonValueInteger& n) override
+        {
+            return parse_epoch<JsonValueInteger>(n.value);
+        }
+
+        bool parse(const JsonValueUnsigned& n) override
+        {
+            return parse_epoch<JsonValueUnsigned>(n.value);
+        }
+
+        bool parse(const JsonValueInteger64& n) override
+        {
+            return parse_epoch<JsonValueInteger64>(n.value);
+        }
+
+        bool parse(const JsonValueUnsigned64& n) override
+        {
+            PERSISTENCE_IF_UNLIKELY(n.value > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) {
+                return fail_range();
+            }
+            return parse_epoch<JsonValueUnsigned64>(static_cast<std::int64_t>(n.value));
+        }
+
+        bool parse(const JsonValueNumber& n) override
+        {
+            PERSISTENCE_IF_UNLIKELY(encoding == TimeEncoding::iso8601) {
+                return fail<JsonValueNumber>();
+            }
+
+            std::int64_t count;
+            PERSISTENCE_IF_UNLIKELY(!parse_number(n.literal, count)) {
+                context.fail("expected an integer; got: " + std::string(n.literal));
+                return false;
+            }
+            return parse_epoch<JsonValueNumber>(count);
+        }
+
     private:
+        template<typename Token>
+        bool parse_epoch(std::int64_t count)
+        {
+            PERSISTENCE_IF_UNLIKELY(encoding == TimeEncoding::iso8601) {
+                return fail<Token>();
+            }
+
+            PERSISTENCE_IF_UNLIKELY(!detail::from_epoch(count, encoding, ref)) {
+                return fail_range();
+            }
+
+            context.pop();
+            return true;
+        }
+
+        bool fail_range()
+        {
+            context.fail("time point out of the range of the clock");
+            return false;
+        }
+
         timestamp& ref;
+        TimeEncoding encoding = TimeEncoding::iso8601;
     };
 }
@@ -0,0 +1,102 @@
+#pragma once
+#include "decimal.hpp"
+#include "parse_base.hpp"
+#include "detail/number_scanner.hpp"
+#include "detail/unlikely.hpp"
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace persistence
+{
+    /**
+     * Parses a JSON number into a decimal, directly from the number literal.
+     *
+     * RapidJSON passes integers as values, which are exact, and other numbers as `double`, in which case the literal
+     * is read back from the input the reader has just consumed. If the input is not available, e.g. when tokens are replayed,
+     * the shortest decimal that reads back as the same `double` is used instead.
+     */
+    template<>
+    struct JsonParser<decimal> : JsonParseHandler<JsonValueNumber>
+    {
+        using json_type = JsonValueNumber;
+
+        JsonParser(ReaderContext& context, decimal& ref)
+            : JsonParseHandler(context)
+            , ref(ref)
+        {}
+
+        bool parse(const JsonValueInteger& n) override
+        {
+            return parse_integer(n.value);
+        }
+
+        bool parse(const JsonValueUnsigned& n) override
+        {
+            return parse_integer(n.value);
+        }
+
+        bool parse(const JsonValueInteger64& n) override
+        {
+            return parse_integer(n.value);
+        }
+
+        bool parse(const JsonValueUnsigned64& n) override
+        {
+            PERSISTENCE_IF_UNLIKELY(n.value > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) {
+                context.fail("decimal out of range; got: " + std::to_string(n.value));
+                return false;
+            }
+            return parse_integer(static_cast<std::int64_t>(n.value));
+        }
+
+        bool parse(const JsonValueDouble& n) override
+        {
+            if (context.input != nullptr) {
+                return parse_literal(consumed_literal());
+            }
+
+            PERSISTENCE_IF_UNLIKELY(!detail::double_to_decimal(n.value, ref)) {
+                context.fail("decimal out of range; got: " + std::to_string(n.value));
+                return false;
+            }
+
+            context.pop();
+            return true;
+        }
+
+        bool parse(const JsonValueNumber& n) override
+        {
+            return parse_literal(n.literal);
+        }
+
+    private:
+        bool parse_integer(std::int64_t value)
+        {
+            ref = decimal(value);
+            context.pop();
+            return true;
+        }
+
+        bool parse_literal(const std::string_view& literal)
+        {
+            PERSISTENCE_IF_UNLIKELY(!parse_decimal(literal.data(), literal.size(), ref)) {
+                context.fail("decimal out of range; got: " + std::string(literal));
+                return false;
+            }
+
+            context.pop();
+            return true;
+        }
+
+        /** Finds the number literal that ends at the current position of the reader in the input. */
+        std::string_view consumed_literal() const
+        {
+            const char* last = context.input->position();
+            const char* first = detail::find_number_start(context.input->begin(), last);
+            return std::string_view(first, static_cast<std::size_t>(last - first));
+        }
+
+        decimal& ref;
+    };
+}
@@ -1,12 +1,12 @@
 #pragma once
 #include "enum.hpp"
+#include "number.hpp"
 #include "parse_base.hpp"
 #include "parse_fundamental.hpp"
 #include "detail/traits.hpp"
 #include "detail/unlikely.hpp"
-#include <charconv>
 #ifdef PERSISTENCE_BOOST_DESCRIBE
-#include <boost/describe/enum_from_string.hpp>
+#include "enum_utility.hpp"
 #endif
 
 namespace persistence
@@ -44,10 +44,7 @@ namespace persistence
         bool parse(const JsonValueNumber& n) override
         {
             std::underlying_type_t<T> value;
-            const char* last = n.literal.data() + n.literal.size();
-            auto result = std::from_chars(n.literal.data(), last, value);
-
-            PERSISTENCE_IF_UNLIKELY(result.ec != std::errc() || result.ptr != last) {
+            PERSISTENCE_IF_UNLIKELY(!parse_number(n.literal, value)) {
                 context.fail("expected an enumeration numeric value; got: " + std::string(n.literal));
                 return false;
             }
@@ -98,6 +95,7 @@ namespace persistence
                 return false;
             }
 
+            context.pop();
             return true;
         }
 
@@ -118,11 +116,12 @@ namespace persistence
 
         bool parse(const JsonValueString& s) override
         {
-            PERSISTENCE_IF_UNLIKELY(!::boost::describe::enum_from_string(s.literal.data(), ref)) {
+            PERSISTENCE_IF_UNLIKELY(!detail::described_enum_converter<T>.from_string(s.literal, ref)) {
                 context.fail("expected an enumeration string value; got: " + std::string(s.literal));
                 return false;
             }
 
+            context.pop();
             return true;
         }
 
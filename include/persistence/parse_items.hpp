@@ -1,12 +1,243 @@
 #pragma once
 #include "parse_base.hpp"
+#include "parse_fundamental.hpp"
+#include "detail/number_scanner.hpp"
+#include "detail/unlikely.hpp"
+#include <type_traits>
 
 namespace persistence
 {
-    /** Attempts to parse the JSON type associated with a given C++ type, or the end of array token. */
-    template<typename T>
+    /**
+     * Attempts to parse the JSON type associated with a given C++ type, or the end of array token.
+     *
+     * Tokens that may start an item are forwarded to `Derived::parse_item`.
+     */
+    template<typename T, typename Derived>
     struct JsonArrayItemParseHandler : JsonParseHandler<typename JsonParser<T>::json_type, JsonArrayEnd>
     {
         using JsonParseHandler<typename JsonParser<T>::json_type, JsonArrayEnd>::JsonParseHandler;
+
+        bool parse(const JsonValueNull& item) override
+        {
+            return parse_token(item);
+        }
+
+        bool parse(const JsonValueBoolean& item) override
+        {
+            return parse_token(item);
+        }
+
+        bool parse(const JsonValueInteger& item) override
+        {
+            return parse_token(item);
+        }
+
+        bool parse(const JsonValueUnsigned& item) override
+        {
+            return parse_token(item);
+        }
+
+        bool parse(const JsonValueInteger64& item) override
+        {
+            return parse_token(item);
+        }
+
+        bool parse(const JsonValueUnsigned64& item) override
+        {
+            return parse_token(item);
+        }
+
+        bool parse(const JsonValueDouble& item) override
+        {
+            return parse_token(item);
+        }
+
+        bool parse(const JsonValueNumber& item) override
+        {
+            return parse_token(item);
+        }
+
+        bool parse(const JsonValueString& item) override
+        {
+            return parse_token(item);
+        }
+
+        bool parse(const JsonObjectStart& item) override
+        {
+            return parse_token(item);
+        }
+
+        bool parse(const JsonArrayStart& item) override
+        {
+            return parse_token(item);
+        }
+
+    private:
+        template<typename Token>
+        bool parse_token(const Token& item)
+        {
+            if constexpr (is_json_type_v<typename JsonParser<T>::json_type, Token>) {
+                return static_cast<Derived*>(this)->parse_item(item);
+            } else {
+                return this->template fail<Token>();
+            }
+        }
+    };
+
+    /** True if items of a JSON array of numbers can be read into a C++ container with `JsonNumberItemParseHandler`. */
+    template<typename T>
+    constexpr bool is_scanned_number_v =
+        std::is_same_v<T, short> || std::is_same_v<T, unsigned short> ||
+        std::is_same_v<T, int> || std::is_same_v<T, unsigned int> ||
+        std::is_same_v<T, long> || std::is_same_v<T, unsigned long> ||
+        std::is_same_v<T, long long> || std::is_same_v<T, unsigned long long> ||
+        std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+    /**
+     * Parses the items of a JSON array of numbers efficiently.
+     *
+     * When the JSON input is available, items after the first are read with a dedicated number scanner, bypassing
+     * the reader and the per-token dispatch. An item that the scanner cannot convert with certainty is left to the
+     * reader, which passes it as a token, and scanning resumes after the item.
+     *
+     * Items are handed to `Derived::append`. Once `Derived::full` returns true, further items are rejected.
+     *
+     * @tparam T Integer or floating-point type.
+     */
+    template<typename T, typename Derived>
+    struct JsonNumberItemParseHandler : JsonParseHandler<JsonValueNumber, JsonArrayEnd>
+    {
+        static_assert(std::is_arithmetic_v<T>, "T must be an arithmetic type");
+
+        using JsonParseHandler<JsonValueNumber, JsonArrayEnd>::JsonParseHandler;
+
+        bool parse(const JsonValueInteger& n) override
+        {
+            return parse_number(n.value);
+        }
+
+        bool parse(const JsonValueUnsigned& n) override
+        {
+            return parse_number(n.value);
+        }
+
+        bool parse(const JsonValueInteger64& n) override
+        {
+            return parse_number(n.value);
+        }
+
+        bool parse(const JsonValueUnsigned64& n) override
+        {
+            return parse_number(n.value);
+        }
+
+        bool parse(const JsonValueDouble& n) override
+        {
+            if constexpr (std::is_floating_point_v<T>) {
+                // convert the literal the reader has just consumed the same way as items read by the scanner, rather
+                // than rounding the value the reader has produced a second time
+                if (context.input != nullptr) {
+                    const char* last = context.input->position();
+                    const char* first = detail::find_number_start(context.input->begin(), last);
+                    return parse(JsonValueNumber(first, static_cast<std::size_t>(last - first)));
+                }
+            }
+            return parse_number(n.value);
+        }
+
+        bool parse(const JsonValueNumber& n) override
+        {
+            T value;
+            PERSISTENCE_IF_UNLIKELY(!JsonNumberValueParser<T>::parse(context, n.literal, value)) {
+                return false;
+            }
+
+            return add_item(value);
+        }
+
+    private:
+        Derived& derived()
+        {
+            return *static_cast<Derived*>(this);
+        }
+
+        template<typename V>
+        bool parse_number(V value)
+        {
+            T item_value;
+            PERSISTENCE_IF_UNLIKELY(!JsonNumberValueParser<T>::parse(context, value, item_value)) {
+                return false;
+            }
+
+            return add_item(item_value);
+        }
+
+        /** Adds an item delivered by the reader, and reads the items that follow it from the input. */
+        bool add_item(T value)
+        {
+            PERSISTENCE_IF_UNLIKELY(derived().full()) {
+                context.fail("expected JSON token: " + std::string(JsonArrayEnd::name) + "; got: " + std::string(JsonValueNumber::name));
+                return false;
+            }
+
+            derived().append(value);
+            return scan();
+        }
+
+        /**
+         * Consumes the items that follow the current item directly from the JSON input, up to the end of the array
+         * or the first item that needs the reader, and leaves the input past the last item consumed.
+         */
+        bool scan()
+        {
+            if (context.input == nullptr) {
+                return true;
+            }
+
+            detail::StringInput& input = *context.input;
+            const char* p = input.position();
+            while (true) {
+                p = detail::skip_json_whitespace(p);
+                if (*p != ',') {
+                    // either the end of the array or a syntax error, which the reader reports
+                    input.advance(p);
+                    return true;
+                }
+                p = detail::skip_json_whitespace(p + 1);
+                if (!scan_item(p)) {
+                    // the reader continues from the comma
+                    return true;
+                }
+                input.advance(p);
+            }
+        }
+
+        /** Reads a single item, and advances past it on success. */
+        bool scan_item(const char*& p)
+        {
+            if (derived().full()) {
+                // the reader passes the surplus item, which is rejected
+                return false;
+            }
+
+            T value;
+            const char* last;
+            if constexpr (std::is_integral_v<T>) {
+                last = detail::scan_integer(p, value);
+                PERSISTENCE_IF_UNLIKELY(last == nullptr) {
+                    return false;
+                }
+            } else {
+                bool integral;
+                last = detail::scan_number(p, integral);
+                PERSISTENCE_IF_UNLIKELY(last == nullptr || !detail::convert_scanned_float(p, last, integral, value)) {
+                    return false;
+                }
+            }
+
+            derived().append(value);
+            p = last;
+            return true;
+        }
     };
 }
@@ -1,10 +1,31 @@
 #pragma once
+#include "dictionary.hpp"
 #include "parse_base.hpp"
+#include "detail/integer_key.hpp"
+#include "detail/unlikely.hpp"
 #include <map>
 #include <unordered_map>
 
 namespace persistence
 {
+    namespace detail
+    {
+        /** Converts a JSON object key into a dictionary key of a string or integer type. */
+        template<typename K>
+        bool parse_object_key(ReaderContext& context, const std::string_view& identifier, K& key)
+        {
+            if constexpr (is_integer_key_v<K>) {
+                PERSISTENCE_IF_UNLIKELY(!parse_integer_key(identifier, key)) {
+                    context.fail("expected an integer object key; got: " + std::string(identifier));
+                    return false;
+                }
+            } else {
+                key = K(identifier);
+            }
+            return true;
+        }
+    }
+
     template<typename C>
     struct JsonMapParser : JsonParseHandler<JsonObjectKey, JsonObjectEnd>
     {
@@ -21,9 +42,14 @@ namespace persistence
 
         bool parse(const JsonObjectKey& json_key) override
         {
+            using key_type = typename C::key_type;
             using value_type = typename C::mapped_type;
-            std::string_view key = json_key.identifier;
-            auto&& [iter, ins] = container.try_emplace(std::string(key));
+
+            key_type key;
+            PERSISTENCE_IF_UNLIKELY(!detail::parse_object_key(context, json_key.identifier, key)) {
+                return false;
+            }
+            auto&& [iter, ins] = container.try_emplace(std::move(key));
             value_type& item = iter->second;
             context.emplace<JsonParser<value_type>>(context, item);
             return true;
@@ -33,7 +59,82 @@ namespace persistence
         C& container;
     };
 
+    /**
+     * Parses a JSON object into a vector of key and value pairs, in the order the keys appear in the input.
+     */
+    template<typename C>
+    struct JsonDictParser : JsonParseHandler<JsonObjectKey, JsonObjectEnd>
+    {
+        JsonDictParser(ReaderContext& context, C& container)
+            : JsonParseHandler(context)
+            , container(container)
+        {
+            container.clear();
+        }
+
+        bool parse(const JsonObjectEnd&) override
+        {
+            context.pop();
+            return true;
+        }
+
+        bool parse(const JsonObjectKey& json_key) override
+        {
+            using value_type = typename C::value_type::second_type;
+
+            auto& item = container.emplace_back();
+            PERSISTENCE_IF_UNLIKELY(!detail::parse_object_key(context, json_key.identifier, item.first)) {
+                return false;
+            }
+            context.emplace<JsonParser<value_type>>(context, item.second);
+            return true;
+        }
+
+    private:
+        C& container;
+    };
+
+    /**
+     * Parses a JSON object into a sorted flat dictionary.
+     *
+     * Items are collected in the order the keys appear in the input, and sorted once the end of the object is reached.
+     */
     template<typename C>
+    struct JsonFlatMapParser : JsonParseHandler<JsonObjectKey, JsonObjectEnd>
+    {
+        JsonFlatMapParser(ReaderContext& context, C& container)
+            : JsonParseHandler(context)
+            , container(container)
+        {}
+
+        bool parse(const JsonObjectEnd&) override
+        {
+            PERSISTENCE_IF_UNLIKELY(!container.assign(std::move(items))) {
+                context.fail("duplicate key in JSON object");
+                return false;
+            }
+            context.pop();
+            return true;
+        }
+
+        bool parse(const JsonObjectKey& json_key) override
+        {
+            using value_type = typename C::mapped_type;
+
+            auto& item = items.emplace_back();
+            PERSISTENCE_IF_UNLIKELY(!detail::parse_object_key(context, json_key.identifier, item.first)) {
+                return false;
+            }
+            context.emplace<JsonParser<value_type>>(context, item.second);
+            return true;
+        }
+
+    private:
+        C& container;
+        typename C::container_type items;
+    };
+
+    template<typename C, typename ObjectParser = JsonMapParser<C>>
     struct JsonMappedTypeParser : JsonParseHandler<JsonObjectStart>
     {
         using json_type = JsonObjectStart;
@@ -45,7 +146,7 @@ namespace persistence
 
         bool parse(const JsonObjectStart&) override
         {
-            context.replace<JsonMapParser<C>>(context, container);
+            context.replace<ObjectParser>(context, container);
             return true;
         }
 
@@ -64,4 +165,44 @@ namespace persistence
     {
         using JsonMappedTypeParser<std::unordered_map<std::string, T>>::JsonMappedTypeParser;
     };
+
+    template<typename K, typename T>
+    struct JsonParser<std::map<K, T>, std::enable_if_t<detail::is_integer_key_v<K>>> : JsonMappedTypeParser<std::map<K, T>>
+    {
+        using JsonMappedTypeParser<std::map<K, T>>::JsonMappedTypeParser;
+    };
+
+    template<typename K, typename T>
+    struct JsonParser<std::unordered_map<K, T>, std::enable_if_t<detail::is_integer_key_v<K>>> : JsonMappedTypeParser<std::unordered_map<K, T>>
+    {
+        using JsonMappedTypeParser<std::unordered_map<K, T>>::JsonMappedTypeParser;
+    };
+
+    template<typename T>
+    struct JsonParser<string_dict<T>> : JsonMappedTypeParser<string_dict<T>, JsonDictParser<string_dict<T>>>
+    {
+        using JsonMappedTypeParser<string_dict<T>, JsonDictParser<string_dict<T>>>::JsonMappedTypeParser;
+    };
+
+    template<typename K, typename T, DuplicateKeys Duplicates>
+    struct JsonParser<flat_map<K, T, Duplicates>> : JsonMappedTypeParser<flat_map<K, T, Duplicates>, JsonFlatMapParser<flat_map<K, T, Duplicates>>>
+    {
+        using JsonMappedTypeParser<flat_map<K, T, Duplicates>, JsonFlatMapParser<flat_map<K, T, Duplicates>>>::JsonMappedTypeParser;
+    };
+
+    template<typename K, typename T, typename Visited>
+    struct may_have_back_references<std::map<K, T>, Visited> : may_have_back_references<T, Visited>
+    {};
+
+    template<typename K, typename T, typename Visited>
+    struct may_have_back_references<std::unordered_map<K, T>, Visited> : may_have_back_references<T, Visited>
+    {};
+
+    template<typename T, typename Visited>
+    struct may_have_back_references<string_dict<T>, Visited> : may_have_back_references<T, Visited>
+    {};
+
+    template<typename K, typename T, DuplicateKeys Duplicates, typename Visited>
+    struct may_have_back_references<flat_map<K, T, Duplicates>, Visited> : may_have_back_references<T, Visited>
+    {};
 }
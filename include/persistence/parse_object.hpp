@@ -3,11 +3,13 @@
 #include "object_members.hpp"
 #include "object_reflection.hpp"
 #include "parse_base.hpp"
+#include "detail/bitset.hpp"
 #include "detail/make_array.hpp"
 #include "detail/perfect_hash.hpp"
 #include "detail/traits.hpp"
 #include "detail/unlikely.hpp"
 #include <optional>
+#include <utility>
 
 namespace persistence
 {
@@ -78,11 +80,53 @@ namespace persistence
     template<typename T>
     struct JsonParser<std::optional<T>> : JsonParser<T>
     {
-        JsonParser(ReaderContext& context, std::optional<T>& ref)
-            : JsonParser<T>(context, ref.emplace())
+        template<typename... Args>
+        JsonParser(ReaderContext& context, std::optional<T>& ref, Args&&... args)
+            : JsonParser<T>(context, ref.emplace(), std::forward<Args>(args)...)
         {}
     };
 
+    namespace detail
+    {
+        /** Pushes a parser for the value of a member variable, in the encoding the member annotation specifies. */
+        template<typename Member, typename C>
+        void emplace_member_parser(ReaderContext& context, const Member& member, C& object)
+        {
+            using value_type = unqualified_t<decltype(member.ref(object))>;
+            using parser_type = JsonParser<value_type>;
+            if constexpr (is_time_encodable_member<value_type>::value) {
+                if (member.time_encoding() != TimeEncoding::iso8601) {
+                    context.emplace<parser_type>(context, member.ref(object), member.time_encoding());
+                    return;
+                }
+            }
+            context.emplace<parser_type>(context, member.ref(object));
+        }
+
+        /** True if a member variable must have a corresponding property in the JSON object, as with de-serialization. */
+        template<typename Member>
+        struct is_required_member : std::false_type
+        {};
+
+        template<typename T, class B, auto P, typename D>
+        struct is_required_member<member::variable<T, B, P, D>> : std::true_type
+        {};
+
+        template<typename T, class B, auto P, typename D>
+        struct is_required_member<member::variable<std::optional<T>, B, P, D>> : std::false_type
+        {};
+
+        template<typename Member>
+        constexpr bool is_required_member_v = is_required_member<Member>::value;
+
+        /** Fails parsing a JSON object that has no property for a required member variable. */
+        inline bool fail_missing_member(ReaderContext& context, std::string_view name)
+        {
+            context.fail("missing required property: " + std::string(name));
+            return false;
+        }
+    }
+
     template<typename C>
     struct JsonSoloObjectParser : JsonParseHandler<JsonObjectKey, JsonObjectEnd>
     {
@@ -96,6 +140,12 @@ namespace persistence
 
         bool parse(const JsonObjectEnd&) override
         {
+            if constexpr (detail::is_required_member_v<member_type>) {
+                PERSISTENCE_IF_UNLIKELY(!seen) {
+                    return detail::fail_missing_member(context, member_name);
+                }
+            }
+
             context.pop();
             return true;
         }
@@ -108,8 +158,8 @@ namespace persistence
                 return false;
             }
 
-            using parser_type = JsonParser<unqualified_t<decltype(member_type().ref(ref))>>;
-            context.emplace<parser_type>(context, member_type().ref(ref));
+            seen = true;
+            detail::emplace_member_parser(context, member_type(), ref);
             return true;
         }
 
@@ -117,6 +167,7 @@ namespace persistence
         using member_type = typename std::tuple_element<0, typename class_traits<C>::member_types>::type;
         constexpr static std::string_view member_name = member_type().name();
         C& ref;
+        bool seen = false;
     };
 
     template<typename C>
@@ -132,6 +183,17 @@ namespace persistence
 
         bool parse(const JsonObjectEnd&) override
         {
+            if constexpr (detail::is_required_member_v<first_member_type>) {
+                PERSISTENCE_IF_UNLIKELY(!first_seen) {
+                    return detail::fail_missing_member(context, first_member_name);
+                }
+            }
+            if constexpr (detail::is_required_member_v<second_member_type>) {
+                PERSISTENCE_IF_UNLIKELY(!second_seen) {
+                    return detail::fail_missing_member(context, second_member_name);
+                }
+            }
+
             context.pop();
             return true;
         }
@@ -140,12 +202,12 @@ namespace persistence
         {
             std::string_view identifier = json_key.identifier;
             if (identifier == first_member_name) {
-                using parser_type = JsonParser<unqualified_t<decltype(first_member_type().ref(ref))>>;
-                context.emplace<parser_type>(context, first_member_type().ref(ref));
+                first_seen = true;
+                detail::emplace_member_parser(context, first_member_type(), ref);
                 return true;
             } else if (identifier == second_member_name) {
-                using parser_type = JsonParser<unqualified_t<decltype(second_member_type().ref(ref))>>;
-                context.emplace<parser_type>(context, second_member_type().ref(ref));
+                second_seen = true;
+                detail::emplace_member_parser(context, second_member_type(), ref);
                 return true;
             } else {
                 context.fail("expected class member name; got: " + std::string(json_key.identifier));
@@ -159,6 +221,8 @@ namespace persistence
         using second_member_type = typename std::tuple_element<1, typename class_traits<C>::member_types>::type;
         constexpr static std::string_view second_member_name = second_member_type().name();
         C& ref;
+        bool first_seen = false;
+        bool second_seen = false;
     };
 
     template<typename C>
@@ -174,6 +238,14 @@ namespace persistence
 
         bool parse(const JsonObjectEnd&) override
         {
+            PERSISTENCE_IF_UNLIKELY(required_seen != required_count) {
+                for (std::size_t k = 0; k < names.size(); ++k) {
+                    if (required[k] && !seen.get(k)) {
+                        return detail::fail_missing_member(context, names[k]);
+                    }
+                }
+            }
+
             context.pop();
             return true;
         }
@@ -187,9 +259,13 @@ namespace persistence
                 return false;
             }
 
+            if (required[k] && !seen.get(k)) {
+                seen.set(k);
+                ++required_seen;
+            }
+
             visit_at(members, k, [&](auto&& member) {
-                using parser_type = JsonParser<unqualified_t<decltype(member.ref(ref))>>;
-                context.emplace<parser_type>(context, member.ref(ref));
+                detail::emplace_member_parser(context, member, ref);
             });
             return true;
         }
@@ -202,10 +278,21 @@ namespace persistence
             }, typename class_traits<C>::member_types());
         }
 
+        constexpr static auto required_members()
+        {
+            return std::apply([](auto&&... args) {
+                return make_array(detail::is_required_member_v<std::decay_t<decltype(args)>>...);
+            }, typename class_traits<C>::member_types());
+        }
+
         constexpr static auto members = typename class_traits<C>::member_types();
         inline static auto names = member_names();
         inline static auto hash_map = PerfectHash(names);
+        constexpr static auto required = required_members();
+        constexpr static std::size_t required_count = BitSet<required.size()>{ required }.count();
         C& ref;
+        BitSet<required.size()> seen;
+        std::size_t required_seen = 0;
     };
 
     template<typename T>
@@ -248,4 +335,29 @@ namespace persistence
     private:
         T& ref;
     };
+
+    template<typename T, typename Visited>
+    struct may_have_back_references<std::optional<T>, Visited> : may_have_back_references<T, Visited>
+    {};
+
+    namespace detail
+    {
+        template<typename Members, typename Visited>
+        struct members_have_back_references;
+
+        template<typename... Members, typename Visited>
+        struct members_have_back_references<std::tuple<Members...>, Visited>
+            : std::disjunction<may_have_back_references<typename Members::member_type, Visited>...>
+        {};
+    }
+
+    /** A class holds back-references if any of its members does; a class that contains itself adds nothing new. */
+    template<typename T, typename... Visited>
+    struct may_have_back_references<T, std::tuple<Visited...>, std::enable_if_t<has_custom_parser<T>::value>>
+        : std::conditional_t<
+            (std::is_same_v<T, Visited> || ...),
+            std::false_type,
+            detail::members_have_back_references<typename class_traits<T>::member_types, std::tuple<Visited..., T>>
+        >
+    {};
 }
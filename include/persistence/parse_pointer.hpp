@@ -1,6 +1,9 @@
 #pragma once
 #include "parse_base.hpp"
+#include "detail/unlikely.hpp"
 #include <memory>
+#include <string>
+#include <type_traits>
 
 namespace persistence
 {
@@ -25,8 +28,106 @@ namespace persistence
         }
     };
 
+    /** True if a type is parsed from a JSON object, which may take the form of a back-reference. */
     template<typename T>
-    struct JsonParser<std::shared_ptr<T>> : JsonParser<T>
+    constexpr bool is_object_parser_v = std::is_same_v<typename JsonParser<T>::json_type, JsonObjectStart>;
+
+    /**
+     * Parses a JSON back-reference `{"$ref": "/path/to/earlier/occurrence"}` into a C++ `shared_ptr<T>`.
+     *
+     * The `$ref` key has already been consumed when this parser is instantiated.
+     */
+    template<typename T>
+    struct JsonSharedReferenceParser : JsonParseHandler<JsonValueString, JsonObjectEnd>
+    {
+        JsonSharedReferenceParser(ReaderContext& context, std::shared_ptr<T>& ref)
+            : JsonParseHandler(context)
+            , ref(ref)
+        {}
+
+        bool parse(const JsonValueString& s) override
+        {
+            PERSISTENCE_IF_UNLIKELY(resolved) {
+                return fail<JsonValueString>();
+            }
+
+            auto object = context.get(std::string(s.literal));
+            PERSISTENCE_IF_UNLIKELY(!object) {
+                context.fail("unresolved back-reference: " + std::string(s.literal));
+                return false;
+            }
+
+            ref = std::reinterpret_pointer_cast<T>(*object);
+            resolved = true;
+            return true;
+        }
+
+        bool parse(const JsonObjectEnd&) override
+        {
+            PERSISTENCE_IF_UNLIKELY(!resolved) {
+                return fail<JsonObjectEnd>();
+            }
+
+            context.pop();
+            return true;
+        }
+
+    private:
+        std::shared_ptr<T>& ref;
+        bool resolved = false;
+    };
+
+    /**
+     * Parses a JSON object into a C++ `shared_ptr<T>` after the opening brace has been consumed.
+     *
+     * If the first key is `$ref`, the object is a back-reference to an earlier occurrence. Otherwise, a new
+     * instance is created, recorded by its location, and the tokens consumed so far are replayed to the parser of `T`.
+     */
+    template<typename T>
+    struct JsonSharedObjectParser : JsonParseHandler<JsonObjectKey, JsonObjectEnd>
+    {
+        JsonSharedObjectParser(ReaderContext& context, std::shared_ptr<T>& ref, std::string&& path)
+            : JsonParseHandler(context)
+            , ref(ref)
+            , path(std::move(path))
+        {}
+
+        bool parse(const JsonObjectKey& json_key) override
+        {
+            if (json_key.identifier == "$ref") {
+                context.replace<JsonSharedReferenceParser<T>>(context, ref);
+                return true;
+            }
+
+            ReaderContext& ctx = context;
+            create();
+            return ctx.dispatcher.handler->parse(JsonObjectStart()) && ctx.dispatcher.handler->parse(json_key);
+        }
+
+        bool parse(const JsonObjectEnd& json_end) override
+        {
+            ReaderContext& ctx = context;
+            create();
+            return ctx.dispatcher.handler->parse(JsonObjectStart()) && ctx.dispatcher.handler->parse(json_end);
+        }
+
+    private:
+        /** Creates a new instance, and hands over control to the parser of `T`; invalidates this object. */
+        void create()
+        {
+            ReaderContext& ctx = context;
+            std::shared_ptr<T>& target = ref;
+            target = std::make_shared<T>();
+            ctx.put(std::move(path), target);
+            ctx.replace<JsonParser<T>>(ctx, *target);
+        }
+
+        std::shared_ptr<T>& ref;
+        std::string path;
+    };
+
+    template<typename T>
+    struct JsonParser<std::shared_ptr<T>, std::enable_if_t<!is_object_parser_v<T>>> : JsonParser<T>
     {
         JsonParser(ReaderContext& context, std::shared_ptr<T>& ref)
             : JsonParser<T>(context, assign_shared(ref))
@@ -39,4 +140,37 @@ namespace persistence
             return *ref;
         }
     };
+
+    /**
+     * Parses a JSON object into a C++ `shared_ptr<T>`, resolving back-references to objects parsed earlier.
+     */
+    template<typename T>
+    struct JsonParser<std::shared_ptr<T>, std::enable_if_t<is_object_parser_v<T>>> : JsonParseHandler<JsonObjectStart>
+    {
+        using json_type = JsonObjectStart;
+
+        JsonParser(ReaderContext& context, std::shared_ptr<T>& ref)
+            : JsonParseHandler(context)
+            , ref(ref)
+        {}
+
+        bool parse(const JsonObjectStart&) override
+        {
+            context.replace<JsonSharedObjectParser<T>>(context, ref, context.path());
+            return true;
+        }
+
+    private:
+        std::shared_ptr<T>& ref;
+    };
+
+    template<typename T, typename Visited>
+    struct may_have_back_references<std::unique_ptr<T>, Visited> : may_have_back_references<T, Visited>
+    {};
+
+    /** An object held by a shared pointer is recorded by its location, and may be the target of a back-reference. */
+    template<typename T, typename Visited>
+    struct may_have_back_references<std::shared_ptr<T>, Visited>
+        : std::disjunction<std::bool_constant<is_object_parser_v<T>>, may_have_back_references<T, Visited>>
+    {};
 }
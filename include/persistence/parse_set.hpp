@@ -12,10 +12,10 @@ namespace persistence
      * Parses a JSON array of possibly composite values into a C++ `set<T>`.
      */
     template<typename T>
-    struct JsonSetParser : JsonArrayItemParseHandler<T>
+    struct JsonSetParser : JsonArrayItemParseHandler<T, JsonSetParser<T>>
     {
         JsonSetParser(ReaderContext& context, std::set<T>& container)
-            : JsonArrayItemParseHandler<T>(context)
+            : JsonArrayItemParseHandler<T, JsonSetParser<T>>(context)
             , container(container)
         {}
 
@@ -31,7 +31,8 @@ namespace persistence
             return true;
         }
 
-        bool parse(const typename JsonParser<T>::json_type& json_item) override
+        template<typename Token>
+        bool parse_item(const Token& json_item)
         {
             // use temporary storage for parsing, set elements are immutable
             storage.emplace_back();
@@ -249,4 +250,8 @@ namespace persistence
     private:
         std::set<T>& ref;
     };
+
+    template<typename T, typename Visited>
+    struct may_have_back_references<std::set<T>, Visited> : may_have_back_references<T, Visited>
+    {};
 }
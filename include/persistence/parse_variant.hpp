@@ -0,0 +1,675 @@
+#pragma once
+#include "variant.hpp"
+#include "parse_base.hpp"
+#include "detail/unlikely.hpp"
+#include <array>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace persistence
+{
+    namespace detail
+    {
+        /** Appends a type to a tuple of types unless the type is already present. */
+        template<typename Tuple, typename T>
+        struct tuple_append_unique;
+
+        template<typename... Ts, typename T>
+        struct tuple_append_unique<std::tuple<Ts...>, T>
+        {
+            using type = std::conditional_t<(std::is_same_v<T, Ts> || ...), std::tuple<Ts...>, std::tuple<Ts..., T>>;
+        };
+
+        /** Merges types into a tuple of unique types, expanding types that are themselves tuples. */
+        template<typename Tuple, typename... Ts>
+        struct tuple_merge_unique
+        {
+            using type = Tuple;
+        };
+
+        template<typename Tuple, typename T, typename... Ts>
+        struct tuple_merge_unique<Tuple, T, Ts...> : tuple_merge_unique<typename tuple_append_unique<Tuple, T>::type, Ts...>
+        {};
+
+        template<typename Tuple, typename... Us, typename... Ts>
+        struct tuple_merge_unique<Tuple, std::tuple<Us...>, Ts...> : tuple_merge_unique<Tuple, Us..., Ts...>
+        {};
+
+        /**
+         * Records JSON tokens for later replay, taking a copy of strings.
+         *
+         * Used when the C++ type to parse into cannot be decided from the first token alone. The location of the
+         * first token is recorded too, such that back-reference targets get their original location on replay.
+         */
+        struct JsonEventBuffer
+        {
+            /** Records the location of the first token, as tracked when the first token is delivered. */
+            void locate(const JsonPathTracker& location)
+            {
+                path = location;
+            }
+
+            template<typename Token>
+            void push(const Token& token)
+            {
+                events.push_back(Event{ token, 0, 0 });
+            }
+
+            void push(const JsonValueNumber& token)
+            {
+                push_text(JsonValueNumber(), token.literal);
+            }
+
+            void push(const JsonValueString& token)
+            {
+                push_text(JsonValueString(), token.literal);
+            }
+
+            void push(const JsonObjectKey& token)
+            {
+                push_text(JsonObjectKey(), token.identifier);
+            }
+
+            /** Feeds recorded tokens to the current handler of a context; stops at the first failure. */
+            bool replay(ReaderContext& context) const
+            {
+                // tokens are not at the reader position in the input, and the reader has moved past their location
+                detail::StringInput* input = context.input;
+                context.input = nullptr;
+                JsonPathTracker reader_path = std::move(context.dispatcher.path);
+                context.dispatcher.path = path;
+                bool result = replay_events(context);
+                context.dispatcher.path = std::move(reader_path);
+                context.input = input;
+                return result;
+            }
+
+        private:
+            /** Feeds recorded tokens to the current handler, tracking their location as the event dispatcher does. */
+            bool replay_events(ReaderContext& context) const
+            {
+                JsonPathTracker& location = context.dispatcher.path;
+                for (std::size_t k = 0; k < events.size(); ++k) {
+                    const Event& event = events[k];
+
+                    // the recorded location already accounts for the first token
+                    const bool advance = k > 0;
+                    bool result = std::visit([&](auto&& token) -> bool {
+                        using token_type = std::decay_t<decltype(token)>;
+                        if constexpr (std::is_same_v<token_type, JsonObjectKey>) {
+                            if (advance) {
+                                location.key(text.data() + event.offset, event.length);
+                            }
+                            return context.dispatcher.handler->parse(token_type(text.data() + event.offset, event.length));
+                        } else if constexpr (std::is_same_v<token_type, JsonValueString> || std::is_same_v<token_type, JsonValueNumber>) {
+                            if (advance) {
+                                location.value();
+                            }
+                            return context.dispatcher.handler->parse(token_type(text.data() + event.offset, event.length));
+                        } else if constexpr (std::is_same_v<token_type, JsonObjectStart> || std::is_same_v<token_type, JsonArrayStart>) {
+                            if (advance) {
+                                location.value();
+                            }
+                            bool started = context.dispatcher.handler->parse(token);
+                            if constexpr (std::is_same_v<token_type, JsonObjectStart>) {
+                                location.start_object();
+                            } else {
+                                location.start_array();
+                            }
+                            return started;
+                        } else if constexpr (std::is_same_v<token_type, JsonObjectEnd> || std::is_same_v<token_type, JsonArrayEnd>) {
+                            if (advance) {
+                                location.end();
+                            }
+                            return context.dispatcher.handler->parse(token);
+                        } else {
+                            if (advance) {
+                                location.value();
+                            }
+                            return context.dispatcher.handler->parse(token);
+                        }
+                    }, event.token);
+                    PERSISTENCE_IF_UNLIKELY(!result) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            template<typename Token>
+            void push_text(Token&& token, std::string_view str)
+            {
+                events.push_back(Event{ std::move(token), text.size(), str.size() });
+                text.append(str);
+            }
+
+            using token_type = std::variant<
+                JsonValueNull,
+                JsonValueBoolean,
+                JsonValueInteger,
+                JsonValueUnsigned,
+                JsonValueInteger64,
+                JsonValueUnsigned64,
+                JsonValueDouble,
+                JsonValueNumber,
+                JsonValueString,
+                JsonObjectStart,
+                JsonObjectKey,
+                JsonObjectEnd,
+                JsonArrayStart,
+                JsonArrayEnd
+            >;
+
+            struct Event
+            {
+                token_type token;
+                std::size_t offset;
+                std::size_t length;
+            };
+
+            std::vector<Event> events;
+            std::string text;
+            JsonPathTracker path;
+        };
+
+        /** Parses tokens into the variant alternatives in order, and keeps the first alternative that matches. */
+        template<typename... Ts>
+        struct JsonVariantMatcher
+        {
+            using variant_type = std::variant<Ts...>;
+
+            /** Indicates for each alternative whether it is a candidate given the first token of a value. */
+            template<typename Token>
+            constexpr static std::array<bool, sizeof...(Ts)> candidates()
+            {
+                return { is_json_type_v<typename JsonParser<Ts>::json_type, Token>... };
+            }
+
+            /** Number of candidate alternatives given the first token of a value. */
+            template<typename Token>
+            constexpr static std::size_t candidate_count()
+            {
+                return (std::size_t(0) + ... + std::size_t(is_json_type_v<typename JsonParser<Ts>::json_type, Token>));
+            }
+
+            /** Index of the first candidate alternative given the first token of a value. */
+            template<typename Token>
+            constexpr static std::size_t first_candidate()
+            {
+                constexpr auto mask = candidates<Token>();
+                for (std::size_t k = 0; k < mask.size(); ++k) {
+                    if (mask[k]) {
+                        return k;
+                    }
+                }
+                return mask.size();
+            }
+
+            /**
+             * Tries candidate alternatives in order until one of them consumes all tokens successfully.
+             *
+             * @param self The handler on top of the stack when tokens are fed to the candidate.
+             * @param feed Function that feeds all tokens of a value to the current handler of the context.
+             */
+            template<typename Token, typename F>
+            static bool match(ReaderContext& context, JsonParseEvent* self, variant_type& value, F&& feed)
+            {
+                return match_at<Token>(context, self, value, feed, std::index_sequence_for<Ts...>());
+            }
+
+        private:
+            template<typename Token, typename F, std::size_t... I>
+            static bool match_at(ReaderContext& context, JsonParseEvent* self, variant_type& value, F& feed, std::index_sequence<I...>)
+            {
+                constexpr auto mask = candidates<Token>();
+                return (... || (mask[I] && attempt<I>(context, self, value, feed)));
+            }
+
+            template<std::size_t I, typename F>
+            static bool attempt(ReaderContext& context, JsonParseEvent* self, variant_type& value, F& feed)
+            {
+                using alternative_type = std::variant_alternative_t<I, variant_type>;
+
+                auto& item = value.template emplace<I>();
+                std::size_t mark = context.begin_attempt();
+                context.emplace<JsonParser<alternative_type>>(context, item);
+                if (feed(context) && context.dispatcher.handler == self) {
+                    context.commit(mark);
+                    context.clear_error();
+                    return true;
+                }
+
+                // discard partial state left behind by the failed alternative, including objects it has recorded
+                while (context.dispatcher.handler != self) {
+                    context.pop();
+                }
+                context.rollback(mark);
+                return false;
+            }
+        };
+    }
+
+    /**
+     * Parses a JSON value that spans several tokens (an object or an array) into a C++ `variant<Ts...>` when there
+     * are multiple candidate alternatives.
+     *
+     * Tokens are buffered until the value is complete, and then replayed to each candidate in order.
+     */
+    template<typename Token, typename... Ts>
+    struct JsonVariantBufferParser : JsonParseEvent
+    {
+        JsonVariantBufferParser(ReaderContext& context, std::variant<Ts...>& ref, const Token& token)
+            : context(context)
+            , ref(ref)
+        {
+            buffer.locate(context.dispatcher.path);
+            buffer.push(token);
+        }
+
+        bool parse(const JsonValueNull& token) override
+        {
+            return record(token);
+        }
+
+        bool parse(const JsonValueBoolean& token) override
+        {
+            return record(token);
+        }
+
+        bool parse(const JsonValueInteger& token) override
+        {
+            return record(token);
+        }
+
+        bool parse(const JsonValueUnsigned& token) override
+        {
+            return record(token);
+        }
+
+        bool parse(const JsonValueInteger64& token) override
+        {
+            return record(token);
+        }
+
+        bool parse(const JsonValueUnsigned64& token) override
+        {
+            return record(token);
+        }
+
+        bool parse(const JsonValueDouble& token) override
+        {
+            return record(token);
+        }
+
+        bool parse(const JsonValueNumber& token) override
+        {
+            return record(token);
+        }
+
+        bool parse(const JsonValueString& token) override
+        {
+            return record(token);
+        }
+
+        bool parse(const JsonObjectStart& token) override
+        {
+            ++depth;
+            return record(token);
+        }
+
+        bool parse(const JsonObjectKey& token) override
+        {
+            return record(token);
+        }
+
+        bool parse(const JsonObjectEnd& token) override
+        {
+            --depth;
+            return record(token);
+        }
+
+        bool parse(const JsonArrayStart& token) override
+        {
+            ++depth;
+            return record(token);
+        }
+
+        bool parse(const JsonArrayEnd& token) override
+        {
+            --depth;
+            return record(token);
+        }
+
+    private:
+        template<typename T>
+        bool record(const T& token)
+        {
+            buffer.push(token);
+            if (depth > 0) {
+                return true;
+            }
+
+            bool result = detail::JsonVariantMatcher<Ts...>::template match<Token>(context, this, ref, [this](ReaderContext& ctx) {
+                return buffer.replay(ctx);
+            });
+            PERSISTENCE_IF_UNLIKELY(!result) {
+                context.fail("unable to match either of the variant types");
+                return false;
+            }
+
+            context.pop();
+            return true;
+        }
+
+        ReaderContext& context;
+        std::variant<Ts...>& ref;
+        detail::JsonEventBuffer buffer;
+        std::size_t depth = 1;
+    };
+
+    /**
+     * Parses a JSON value into a C++ `variant<Ts...>`, using the first alternative that matches.
+     *
+     * Candidate alternatives are narrowed down based on the first token of the JSON value. If a single candidate
+     * remains, the value is parsed directly by the parser of that alternative. Otherwise, candidates are tried in order.
+     */
+    template<typename... Ts>
+    struct JsonParser<std::variant<Ts...>, std::enable_if_t<!is_tagged_variant_v<Ts...>>> : JsonParseHandler<typename detail::tuple_merge_unique<std::tuple<>, typename JsonParser<Ts>::json_type...>::type>
+    {
+        using json_type = typename detail::tuple_merge_unique<std::tuple<>, typename JsonParser<Ts>::json_type...>::type;
+
+        JsonParser(ReaderContext& context, std::variant<Ts...>& ref)
+            : JsonParseHandler<json_type>(context)
+            , ref(ref)
+        {}
+
+        bool parse(const JsonValueNull& token) override
+        {
+            return parse_scalar(token);
+        }
+
+        bool parse(const JsonValueBoolean& token) override
+        {
+            return parse_scalar(token);
+        }
+
+        bool parse(const JsonValueInteger& token) override
+        {
+            return parse_scalar(token);
+        }
+
+        bool parse(const JsonValueUnsigned& token) override
+        {
+            return parse_scalar(token);
+        }
+
+        bool parse(const JsonValueInteger64& token) override
+        {
+            return parse_scalar(token);
+        }
+
+        bool parse(const JsonValueUnsigned64& token) override
+        {
+            return parse_scalar(token);
+        }
+
+        bool parse(const JsonValueDouble& token) override
+        {
+            return parse_scalar(token);
+        }
+
+        bool parse(const JsonValueNumber& token) override
+        {
+            return parse_scalar(token);
+        }
+
+        bool parse(const JsonValueString& token) override
+        {
+            return parse_scalar(token);
+        }
+
+        bool parse(const JsonObjectStart& token) override
+        {
+            return parse_composite(token);
+        }
+
+        bool parse(const JsonArrayStart& token) override
+        {
+            return parse_composite(token);
+        }
+
+    private:
+        using matcher_type = detail::JsonVariantMatcher<Ts...>;
+
+        /** Hands over parsing to the only candidate alternative. */
+        template<typename Token>
+        bool parse_single(const Token& token)
+        {
+            constexpr std::size_t index = matcher_type::template first_candidate<Token>();
+            using alternative_type = std::variant_alternative_t<index, std::variant<Ts...>>;
+
+            ReaderContext& ctx = this->context;
+            auto& item = ref.template emplace<index>();
+            ctx.template replace<JsonParser<alternative_type>>(ctx, item);
+            return ctx.dispatcher.handler->parse(token);
+        }
+
+        template<typename Token>
+        bool parse_scalar(const Token& token)
+        {
+            constexpr std::size_t count = matcher_type::template candidate_count<Token>();
+            if constexpr (count == 0) {
+                return this->template fail<Token>();
+            } else if constexpr (count == 1) {
+                return parse_single(token);
+            } else {
+                // a scalar value is complete in itself, no buffering is necessary
+                ReaderContext& ctx = this->context;
+                bool result = matcher_type::template match<Token>(ctx, this, ref, [&token](ReaderContext& c) {
+                    return c.dispatcher.handler->parse(token);
+                });
+                PERSISTENCE_IF_UNLIKELY(!result) {
+                    ctx.fail("unable to match either of the variant types");
+                    return false;
+                }
+
+                ctx.pop();
+                return true;
+            }
+        }
+
+        template<typename Token>
+        bool parse_composite(const Token& token)
+        {
+            constexpr std::size_t count = matcher_type::template candidate_count<Token>();
+            if constexpr (count == 0) {
+                return this->template fail<Token>();
+            } else if constexpr (count == 1) {
+                return parse_single(token);
+            } else {
+                ReaderContext& ctx = this->context;
+                ctx.template replace<JsonVariantBufferParser<Token, Ts...>>(ctx, ref, token);
+                return true;
+            }
+        }
+
+        std::variant<Ts...>& ref;
+    };
+
+    /**
+     * Parses the members of a JSON object into a C++ `variant<Ts...>` whose alternatives all declare a tag.
+     *
+     * The alternative is selected when the discriminator property is encountered. Members that precede the
+     * discriminator are buffered and replayed to the parser of the selected alternative; if the discriminator is
+     * the first property, no buffering takes place.
+     */
+    template<typename... Ts>
+    struct JsonTaggedVariantParser : JsonParseEvent
+    {
+        JsonTaggedVariantParser(ReaderContext& context, std::variant<Ts...>& ref)
+            : context(context)
+            , ref(ref)
+        {}
+
+        bool parse(const JsonValueNull& token) override
+        {
+            return record(token);
+        }
+
+        bool parse(const JsonValueBoolean& token) override
+        {
+            return record(token);
+        }
+
+        bool parse(const JsonValueInteger& token) override
+        {
+            return record(token);
+        }
+
+        bool parse(const JsonValueUnsigned& token) override
+        {
+            return record(token);
+        }
+
+        bool parse(const JsonValueInteger64& token) override
+        {
+            return record(token);
+        }
+
+        bool parse(const JsonValueUnsigned64& token) override
+        {
+            return record(token);
+        }
+
+        bool parse(const JsonValueDouble& token) override
+        {
+            return record(token);
+        }
+
+        bool parse(const JsonValueNumber& token) override
+        {
+            return record(token);
+        }
+
+        bool parse(const JsonValueString& token) override
+        {
+            if (expect_tag) {
+                return select(token.literal);
+            }
+            return record(token);
+        }
+
+        bool parse(const JsonObjectStart& token) override
+        {
+            ++depth;
+            return record(token);
+        }
+
+        bool parse(const JsonObjectKey& token) override
+        {
+            if (depth == 1 && token.identifier == tags_type::discriminator) {
+                expect_tag = true;
+                return true;
+            }
+            return record(token);
+        }
+
+        bool parse(const JsonObjectEnd& token) override
+        {
+            PERSISTENCE_IF_UNLIKELY(--depth == 0) {
+                context.fail("missing discriminator property: " + std::string(tags_type::discriminator));
+                return false;
+            }
+            return record(token);
+        }
+
+        bool parse(const JsonArrayStart& token) override
+        {
+            ++depth;
+            return record(token);
+        }
+
+        bool parse(const JsonArrayEnd& token) override
+        {
+            --depth;
+            return record(token);
+        }
+
+    private:
+        using tags_type = VariantTags<Ts...>;
+
+        template<typename Token>
+        bool record(const Token& token)
+        {
+            PERSISTENCE_IF_UNLIKELY(expect_tag) {
+                context.fail("expected JSON token: string; got: " + std::string(Token::name));
+                return false;
+            }
+            if (!recorded) {
+                buffer.locate(context.dispatcher.path);
+                recorded = true;
+            }
+            buffer.push(token);
+            return true;
+        }
+
+        /** Hands over parsing to the alternative identified by a tag, replaying members seen so far. */
+        bool select(const std::string_view& tag)
+        {
+            std::size_t index = tags_type::index(tag);
+            PERSISTENCE_IF_UNLIKELY(index == sizeof...(Ts)) {
+                context.fail("unrecognized variant tag: " + std::string(tag));
+                return false;
+            }
+
+            // parser is destroyed when replaced, keep state that is needed afterwards
+            ReaderContext& ctx = context;
+            detail::JsonEventBuffer members = std::move(buffer);
+            return tags_type::dispatch(index, [&](auto I) -> bool {
+                using alternative_type = std::variant_alternative_t<I, std::variant<Ts...>>;
+
+                auto& item = ref.template emplace<I>();
+                ctx.replace<JsonParser<alternative_type>>(ctx, item);
+                return ctx.dispatcher.handler->parse(JsonObjectStart()) && members.replay(ctx);
+            });
+        }
+
+        ReaderContext& context;
+        std::variant<Ts...>& ref;
+        detail::JsonEventBuffer buffer;
+        std::size_t depth = 1;
+        bool expect_tag = false;
+        bool recorded = false;
+    };
+
+    /**
+     * Parses a JSON object into a C++ `variant<Ts...>` whose alternatives all declare a tag.
+     */
+    template<typename... Ts>
+    struct JsonParser<std::variant<Ts...>, std::enable_if_t<is_tagged_variant_v<Ts...>>> : JsonParseHandler<JsonObjectStart>
+    {
+        using json_type = JsonObjectStart;
+
+        JsonParser(ReaderContext& context, std::variant<Ts...>& ref)
+            : JsonParseHandler(context)
+            , ref(ref)
+        {}
+
+        bool parse(const JsonObjectStart&) override
+        {
+            context.replace<JsonTaggedVariantParser<Ts...>>(context, ref);
+            return true;
+        }
+
+    private:
+        std::variant<Ts...>& ref;
+    };
+
+    template<typename... Ts, typename Visited>
+    struct may_have_back_references<std::variant<Ts...>, Visited> : std::disjunction<may_have_back_references<Ts, Visited>...>
+    {};
+}
@@ -2,7 +2,6 @@
 #include "parse_base.hpp"
 #include "parse_items.hpp"
 #include "parse_fundamental.hpp"
-#include "detail/unlikely.hpp"
 #include <vector>
 
 namespace persistence
@@ -11,10 +10,10 @@ namespace persistence
      * Parses a JSON array of possibly composite values into a C++ `vector<T>`.
      */
     template<typename T>
-    struct JsonArrayParser : JsonArrayItemParseHandler<T>
+    struct JsonArrayParser : JsonArrayItemParseHandler<T, JsonArrayParser<T>>
     {
         JsonArrayParser(ReaderContext& context, std::vector<T>& container)
-            : JsonArrayItemParseHandler<T>(context)
+            : JsonArrayItemParseHandler<T, JsonArrayParser<T>>(context)
             , container(container)
         {}
 
@@ -24,7 +23,8 @@ namespace persistence
             return true;
         }
 
-        bool parse(const typename JsonParser<T>::json_type& json_item) override
+        template<typename Token>
+        bool parse_item(const Token& json_item)
         {
             container.emplace_back();
             ReaderContext& ctx = this->context;
@@ -69,68 +69,29 @@ namespace persistence
      * @tparam Integer or floating-point type.
      */
     template<typename T>
-    struct JsonNumberArrayParser : JsonParseHandler<JsonValueNumber, JsonArrayEnd>
+    struct JsonNumberArrayParser : JsonNumberItemParseHandler<T, JsonNumberArrayParser<T>>
     {
-        static_assert(std::is_arithmetic_v<T>, "T must be an arithmetic type");
-
         JsonNumberArrayParser(ReaderContext& context, std::vector<T>& container)
-            : JsonParseHandler(context)
+            : JsonNumberItemParseHandler<T, JsonNumberArrayParser<T>>(context)
             , container(container)
         {}
 
         bool parse(const JsonArrayEnd&) override
         {
-            context.pop();
+            this->context.pop();
             return true;
         }
 
-        bool parse(const JsonValueInteger& n) override
-        {
-            return parse_number(n.value);
-        }
-
-        bool parse(const JsonValueUnsigned& n) override
-        {
-            return parse_number(n.value);
-        }
-
-        bool parse(const JsonValueInteger64& n) override
-        {
-            return parse_number(n.value);
-        }
-
-        bool parse(const JsonValueUnsigned64& n) override
-        {
-            return parse_number(n.value);
-        }
+        using JsonNumberItemParseHandler<T, JsonNumberArrayParser<T>>::parse;
 
-        bool parse(const JsonValueDouble& n) override
+        constexpr bool full() const
         {
-            return parse_number(n.value);
+            return false;
         }
 
-        bool parse(const JsonValueNumber& n) override
+        void append(T value)
         {
-            T value;
-            PERSISTENCE_IF_UNLIKELY(!JsonNumberValueParser<T>::parse(context, n.literal, value)) {
-                return false;
-            }
-
             container.push_back(value);
-            return true;
-        }
-
-    private:
-        template<typename V>
-        bool parse_number(V value)
-        {
-            T item_value;
-            PERSISTENCE_IF_UNLIKELY(!JsonNumberValueParser<T>::parse(context, value, item_value)) {
-                return false;
-            }
-
-            container.push_back(item_value);
-            return true;
         }
 
     private:
@@ -240,4 +201,8 @@ namespace persistence
     private:
         std::vector<T>& ref;
     };
+
+    template<typename T, typename Visited>
+    struct may_have_back_references<std::vector<T>, Visited> : may_have_back_references<T, Visited>
+    {};
 }
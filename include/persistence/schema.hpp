@@ -2,9 +2,11 @@
 #include "bytes.hpp"
 #include "enum.hpp"
 #include "datetime.hpp"
+#include "decimal.hpp"
 #include "dictionary.hpp"
 #include "object.hpp"
 #include "detail/defer.hpp"
+#include "detail/integer_key.hpp"
 #include "detail/traits.hpp"
 #include <set>
 
@@ -287,6 +289,15 @@ namespace persistence
         }
     };
 
+    template<>
+    struct JsonSchema<decimal>
+    {
+        static auto type()
+        {
+            return JsonSchemaFundamentalType("number");
+        }
+    };
+
     template<>
     struct JsonSchema<std::string>
     {
@@ -312,6 +323,14 @@ namespace persistence
         {
             return JsonSchemaFundamentalType(format::DateTime());
         }
+
+        static JsonSchemaType type(TimeEncoding encoding)
+        {
+            if (encoding != TimeEncoding::iso8601) {
+                return JsonSchemaSignedIntegerType(std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max());
+            }
+            return type();
+        }
     };
 
 #if __cplusplus >= 202002L
@@ -415,6 +434,17 @@ namespace persistence
         return std::make_unique<JsonSchemaType>(make_schema<T>(context));
     }
 
+    /** Creates the sub-schema of a member variable, in the encoding the member annotation specifies. */
+    template<typename T>
+    std::unique_ptr<JsonSchemaType> make_member_schema_ptr(JsonSchemaContext& context, TimeEncoding encoding)
+    {
+        if constexpr (detail::is_time_encodable_v<T>) {
+            return std::make_unique<JsonSchemaType>(JsonSchema<T>::type(encoding));
+        } else {
+            return make_schema_ptr<T>(context);
+        }
+    }
+
     template<typename C>
     struct JsonSchemaVisitor
     {
@@ -429,7 +459,7 @@ namespace persistence
         {
             static_assert(std::is_base_of_v<B, C>, "expected a member variable part of the class inheritance chain");
             properties.push_back(
-                std::make_pair(member.name(), make_schema_ptr<T>(context))
+                std::make_pair(member.name(), make_member_schema_ptr<T>(context, member.time_encoding()))
             );
             return *this;
         }
@@ -439,7 +469,7 @@ namespace persistence
         {
             static_assert(std::is_base_of_v<B, C>, "expected a member variable part of the class inheritance chain");
             properties.push_back(
-                std::make_pair(member.name(), make_schema_ptr<T>(context))
+                std::make_pair(member.name(), make_member_schema_ptr<T>(context, member.time_encoding()))
             );
             required.push_back(member.name());
             return *this;
@@ -567,7 +597,7 @@ namespace persistence
         static JsonSchemaObjectType type(JsonSchemaContext& context)
         {
             auto schema = JsonSchemaObjectType();
-            schema.additionalProperties = make_schema_ptr<typename MapType::mapped_type>(context);
+            schema.additionalProperties = make_schema_ptr<typename MapType::value_type::second_type>(context);
             return schema;
         }
     };
@@ -580,6 +610,22 @@ namespace persistence
     struct JsonSchema<std::unordered_map<std::string, T>> : JsonMapSchema<std::unordered_map<std::string, T>>
     {};
 
+    template<typename K, typename T>
+    struct JsonSchema<std::map<K, T>, std::enable_if_t<detail::is_integer_key_v<K>>> : JsonMapSchema<std::map<K, T>>
+    {};
+
+    template<typename K, typename T>
+    struct JsonSchema<std::unordered_map<K, T>, std::enable_if_t<detail::is_integer_key_v<K>>> : JsonMapSchema<std::unordered_map<K, T>>
+    {};
+
+    template<typename T>
+    struct JsonSchema<string_dict<T>> : JsonMapSchema<string_dict<T>>
+    {};
+
+    template<typename K, typename T, DuplicateKeys Duplicates>
+    struct JsonSchema<flat_map<K, T, Duplicates>> : JsonMapSchema<flat_map<K, T, Duplicates>>
+    {};
+
     template<typename Base>
     struct JsonSchemaDocument : Base
     {
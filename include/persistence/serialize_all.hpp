@@ -11,6 +11,7 @@
 #include "serialize_array.hpp"
 #include "serialize_bytes.hpp"
 #include "serialize_datetime.hpp"
+#include "serialize_decimal.hpp"
 #include "serialize_enum.hpp"
 #include "serialize_map.hpp"
 #include "serialize_set.hpp"
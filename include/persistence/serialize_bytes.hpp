@@ -14,12 +14,16 @@ namespace persistence
 
         bool operator()(const byte_vector& container, rapidjson::Value& json) const
         {
-            std::string str;
-            PERSISTENCE_IF_UNLIKELY(!base64_encode(container, str)) {
+            // encode straight into memory owned by the document
+            const std::size_t length = detail::base64_encoded_length(container.size());
+            char* str = static_cast<char*>(context.global().allocator().Malloc(length + 1));
+            PERSISTENCE_IF_UNLIKELY(str == nullptr) {
                 return false;
             }
+            detail::base64_encode(container.data(), container.size(), str);
+            str[length] = '\0';
 
-            json.SetString(str.data(), static_cast<rapidjson::SizeType>(str.size()), context.global().allocator());
+            json.SetString(rapidjson::StringRef(str, length));
             return true;
         }
     };
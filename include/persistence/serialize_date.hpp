@@ -16,7 +16,11 @@ namespace persistence
         bool operator()(std::chrono::year_month_day value, rapidjson::Value& json) const
         {
             auto dt = to_iso_date(std::chrono::sys_days(value));
-            json.SetString(dt.text, static_cast<rapidjson::SizeType>(iso_date::length()), context.global().allocator());
+            PERSISTENCE_IF_UNLIKELY(dt.size() == 0) {
+                // year out of the range of ISO 8601 without expansion
+                return false;
+            }
+            json.SetString(dt.text, static_cast<rapidjson::SizeType>(dt.size()), context.global().allocator());
             return true;
         }
     };
@@ -10,11 +10,28 @@ namespace persistence
     {
         using JsonContextAwareSerializer::JsonContextAwareSerializer;
 
+        JsonSerializer(SerializerContext& context, TimeEncoding encoding)
+            : JsonContextAwareSerializer(context)
+            , encoding(encoding)
+        {}
+
         bool operator()(timestamp value, rapidjson::Value& json) const
         {
+            if (encoding != TimeEncoding::iso8601) {
+                json.SetInt64(detail::to_epoch(value, encoding));
+                return true;
+            }
+
             auto dt = to_iso_datetime(value);
-            json.SetString(dt.text, static_cast<rapidjson::SizeType>(iso_datetime::length()), context.global().allocator());
+            PERSISTENCE_IF_UNLIKELY(dt.size() == 0) {
+                // year out of the range of ISO 8601 without expansion
+                return false;
+            }
+            json.SetString(dt.text, static_cast<rapidjson::SizeType>(dt.size()), context.global().allocator());
             return true;
         }
+
+    private:
+        TimeEncoding encoding = TimeEncoding::iso8601;
     };
 }
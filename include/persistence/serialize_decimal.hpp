@@ -0,0 +1,34 @@
+#pragma once
+#include "decimal.hpp"
+#include "serialize_base.hpp"
+#include "detail/unlikely.hpp"
+#include <cmath>
+
+namespace persistence
+{
+    /**
+     * Serializes a decimal into a JSON DOM number.
+     *
+     * The JSON DOM stores numbers in binary, and exact decimals are kept only for integers. Other values are stored
+     * as the nearest `double`, which keeps up to 15 significant digits exactly, and trailing zeros are not preserved.
+     * Use `write` to produce the exact literal.
+     */
+    template<>
+    struct JsonSerializer<decimal>
+    {
+        bool operator()(const decimal& value, rapidjson::Value& json) const
+        {
+            if (value.scale == 0) {
+                json.SetInt64(value.coefficient);
+                return true;
+            }
+
+            double d = detail::decimal_to_double(value);
+            PERSISTENCE_IF_UNLIKELY(!std::isfinite(d)) {
+                return false;
+            }
+            json.SetDouble(d);
+            return true;
+        }
+    };
+}
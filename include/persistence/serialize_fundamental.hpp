@@ -1,5 +1,6 @@
 #pragma once
 #include "serialize_base.hpp"
+#include "detail/float_formatter.hpp"
 #include "detail/unlikely.hpp"
 #include <cmath>
 
@@ -122,6 +123,12 @@ namespace persistence
     {
         static_assert(std::is_floating_point_v<T>, "T must be a floating point type");
 
+        JsonFloatSerializer() = default;
+
+        explicit JsonFloatSerializer(const NumberFormat& format)
+            : format(format)
+        {}
+
         bool operator()(T value, rapidjson::Value& json) const
         {
             PERSISTENCE_IF_UNLIKELY(!std::isfinite(value)) {
@@ -129,16 +136,33 @@ namespace persistence
                 return false;
             }
 
-            json.SetDouble(value);
+            if constexpr (std::is_same_v<T, double>) {
+                if (!format) {
+                    json.SetDouble(value);
+                    return true;
+                }
+            }
+
+            // store the `double` nearest to the decimal to write such that it is written as such
+            detail::DecimalLiteral decimal = detail::to_decimal(value);
+            detail::round_decimal(decimal, format);
+            json.SetDouble(detail::to_float<double>(decimal.negative, detail::compute_float<double>(decimal.exponent, decimal.mantissa)));
             return true;
         }
+
+    private:
+        NumberFormat format;
     };
 
     template<>
     struct JsonSerializer<float> : JsonFloatSerializer<float>
-    {};
+    {
+        using JsonFloatSerializer<float>::JsonFloatSerializer;
+    };
 
     template<>
     struct JsonSerializer<double> : JsonFloatSerializer<double>
-    {};
+    {
+        using JsonFloatSerializer<double>::JsonFloatSerializer;
+    };
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include "dictionary.hpp"
 #include "serialize_base.hpp"
+#include "detail/integer_key.hpp"
 #include "detail/serialize_aware.hpp"
 #include "detail/unlikely.hpp"
 #include <map>
@@ -31,6 +32,35 @@ namespace persistence
         }
     };
 
+    /**
+     * Serializes a dictionary with integer keys as a JSON object, formatting each key in decimal on the stack.
+     */
+    template<typename C>
+    struct JsonIntegerKeyDictionarySerializer : JsonContextAwareSerializer
+    {
+        using JsonContextAwareSerializer::JsonContextAwareSerializer;
+
+        bool operator()(const C& container, rapidjson::Value& json) const
+        {
+            json.SetObject();
+            for (auto&& [key, value] : container) {
+                const detail::IntegerKey key_text(key);
+                const std::string_view key_view = key_text.view();
+
+                rapidjson::Value value_json;
+                SerializerContext value_context(context, Segment(key_view));
+                PERSISTENCE_IF_UNLIKELY(!serialize<typename C::mapped_type>(value, value_json, value_context)) {
+                    return false;
+                }
+
+                rapidjson::Value key_json;
+                key_json.SetString(key_view.data(), static_cast<rapidjson::SizeType>(key_view.size()), context.global().allocator());
+                json.AddMember(key_json, value_json, context.global().allocator());  // ownership of key and value is transferred
+            }
+            return true;
+        }
+    };
+
     template<typename T>
     struct JsonSerializer<literal_dict<T>> : JsonDictionarySerializer<literal_dict<T>>
     {
@@ -66,4 +96,28 @@ namespace persistence
     {
         using JsonDictionarySerializer<string_unordered_map<T>>::JsonDictionarySerializer;
     };
+
+    template<typename K, typename T>
+    struct JsonSerializer<std::map<K, T>, std::enable_if_t<detail::is_integer_key_v<K>>> : JsonIntegerKeyDictionarySerializer<std::map<K, T>>
+    {
+        using JsonIntegerKeyDictionarySerializer<std::map<K, T>>::JsonIntegerKeyDictionarySerializer;
+    };
+
+    template<typename K, typename T>
+    struct JsonSerializer<std::unordered_map<K, T>, std::enable_if_t<detail::is_integer_key_v<K>>> : JsonIntegerKeyDictionarySerializer<std::unordered_map<K, T>>
+    {
+        using JsonIntegerKeyDictionarySerializer<std::unordered_map<K, T>>::JsonIntegerKeyDictionarySerializer;
+    };
+
+    template<typename T, DuplicateKeys Duplicates>
+    struct JsonSerializer<flat_map<std::string, T, Duplicates>> : JsonDictionarySerializer<flat_map<std::string, T, Duplicates>>
+    {
+        using JsonDictionarySerializer<flat_map<std::string, T, Duplicates>>::JsonDictionarySerializer;
+    };
+
+    template<typename K, typename T, DuplicateKeys Duplicates>
+    struct JsonSerializer<flat_map<K, T, Duplicates>, std::enable_if_t<detail::is_integer_key_v<K>>> : JsonIntegerKeyDictionarySerializer<flat_map<K, T, Duplicates>>
+    {
+        using JsonIntegerKeyDictionarySerializer<flat_map<K, T, Duplicates>>::JsonIntegerKeyDictionarySerializer;
+    };
 }
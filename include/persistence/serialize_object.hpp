@@ -2,6 +2,7 @@
 #include "object.hpp"
 #include "object_reflection.hpp"
 #include "serialize_base.hpp"
+#include "serialize_fundamental.hpp"
 #include "detail/serialize_aware.hpp"
 #include "detail/unlikely.hpp"
 #include <optional>
@@ -22,7 +23,7 @@ namespace persistence
         {
             static_assert(std::is_base_of_v<B, C>, "expected a member variable part of the class inheritance chain");
             if (member.ref(object).has_value()) {
-                return write(member.name(), member.ref(object).value());
+                return write(member.name(), member.ref(object).value(), member.format(), member.time_encoding());
             } else {
                 return *this;
             }
@@ -32,14 +33,14 @@ namespace persistence
         JsonObjectSerializer& operator&(const member::variable<T, B, P, D>& member)
         {
             static_assert(std::is_base_of_v<B, C>, "expected a member variable part of the class inheritance chain");
-            return write(member.name(), member.ref(object));
+            return write(member.name(), member.ref(object), member.format(), member.time_encoding());
         }
 
         template<typename T, class B, auto P, typename D>
         JsonObjectSerializer& operator&(const member::variable_default<T, B, P, D>& member)
         {
             static_assert(std::is_base_of_v<B, C>, "expected a member variable part of the class inheritance chain");
-            return write(member.name(), member.ref(object));
+            return write(member.name(), member.ref(object), member.format(), member.time_encoding());
         }
 
         operator bool() const
@@ -54,7 +55,7 @@ namespace persistence
 
     private:
         template<typename T>
-        JsonObjectSerializer& write(const std::string_view& name, const T& ref)
+        JsonObjectSerializer& write(const std::string_view& name, const T& ref, const NumberFormat& format, TimeEncoding encoding)
         {
             PERSISTENCE_IF_UNLIKELY(!result) {
                 return *this;
@@ -62,7 +63,7 @@ namespace persistence
 
             rapidjson::Value member_json;
             SerializerContext member_context(context, Segment(name));
-            PERSISTENCE_IF_UNLIKELY(!serialize(ref, member_json, member_context)) {
+            PERSISTENCE_IF_UNLIKELY(!serialize_member(ref, format, encoding, member_json, member_context)) {
                 return *this;
             }
 
@@ -71,6 +72,21 @@ namespace persistence
             return *this;
         }
 
+        template<typename T>
+        static bool serialize_member(const T& ref, const NumberFormat& format, TimeEncoding encoding, rapidjson::Value& json, SerializerContext& context)
+        {
+            if constexpr (std::is_floating_point_v<T>) {
+                if (format) {
+                    return JsonSerializer<T>(format)(ref, json);
+                }
+            } else if constexpr (detail::is_time_encodable_v<T>) {
+                if (encoding != TimeEncoding::iso8601) {
+                    return JsonSerializer<T>(context, encoding)(ref, json);
+                }
+            }
+            return serialize(ref, json, context);
+        }
+
     private:
         /** The C++ object from which data is read. */
         const C& object;
@@ -2,7 +2,6 @@
 #include "serialize_base.hpp"
 #include "detail/serialize_aware.hpp"
 #include "detail/unlikely.hpp"
-#include "detail/path.hpp"
 #include <memory>
 
 namespace persistence
@@ -37,13 +36,11 @@ namespace persistence
 
         bool operator()(const std::shared_ptr<T>& pointer, rapidjson::Value& json) const
         {
-            auto segments = context.get(pointer);
-            if (segments) {
-                std::string ref = Path(std::move(*segments)).str();
-
+            auto ref = context.get(pointer.get());
+            if (ref) {
                 // create a JSON string "/path/to/earlier/occurrence"
                 rapidjson::Value ref_json;
-                ref_json.SetString(ref.data(), static_cast<rapidjson::SizeType>(ref.size()), context.global().allocator());
+                ref_json.SetString(ref->data(), static_cast<rapidjson::SizeType>(ref->size()), context.global().allocator());
 
                 // create a {"$ref": "/path/to/earlier/occurrence"}
                 json.SetObject();
@@ -56,7 +53,7 @@ namespace persistence
                 }
 
                 // assign a "/path/to/this/occurrence"
-                context.put(pointer);
+                context.put(pointer.get());
             }
             return true;
         }
@@ -1,5 +1,7 @@
 #pragma once
+#include "variant.hpp"
 #include "serialize_base.hpp"
+#include "serialize_object.hpp"
 #include "detail/serialize_aware.hpp"
 #include <variant>
 
@@ -12,12 +14,42 @@ namespace persistence
 
         bool operator()(const std::variant<Ts...>& value, rapidjson::Value& json) const
         {
-            return std::visit(
-                [&](auto&& arg) -> bool {
-                    return serialize(arg, json, context);
-                },
-                value
+            if constexpr (is_tagged_variant_v<Ts...>) {
+                return std::visit(
+                    [&](auto&& arg) -> bool {
+                        return serialize_tagged(arg, json);
+                    },
+                    value
+                );
+            } else {
+                return std::visit(
+                    [&](auto&& arg) -> bool {
+                        return serialize(arg, json, context);
+                    },
+                    value
+                );
+            }
+        }
+
+    private:
+        /** Serializes an alternative as a JSON object with the tag as its first property. */
+        template<typename T>
+        bool serialize_tagged(const T& value, rapidjson::Value& json) const
+        {
+            static_assert(has_custom_serializer<T>::value, "expected a class type with a `persist` function for a tagged variant alternative");
+
+            constexpr std::string_view discriminator = VariantTags<Ts...>::discriminator;
+            constexpr std::string_view tag = variant_traits<T>::tag;
+            JsonObjectSerializer<T> serializer(context, value, json);
+
+            json.SetObject();
+            json.AddMember(
+                rapidjson::StringRef(discriminator.data(), discriminator.size()),
+                rapidjson::StringRef(tag.data(), tag.size()),
+                context.global().allocator()
             );
+            const_cast<T&>(value).persist(serializer);
+            return static_cast<bool>(serializer);
         }
     };
 }
@@ -0,0 +1,47 @@
+#pragma once
+#include "detail/utf8_simd.hpp"
+#include <rapidjson/error/error.h>
+#include <rapidjson/reader.h>
+#include <string>
+#include <string_view>
+
+namespace persistence
+{
+    /**
+     * Checks whether a string is well-formed UTF-8.
+     *
+     * Uses SSSE3 or AVX2 instructions selected at run time based on processor support, and portable code otherwise.
+     */
+    inline bool is_valid_utf8(const std::string_view& str)
+    {
+        return detail::utf8_validate(str.data(), str.size());
+    }
+
+    namespace detail
+    {
+        /**
+         * RapidJSON parse flags with encoding validation removed.
+         *
+         * `rapidjson::kParseValidateEncodingFlag` requests validation of UTF-8 by this library, which is much faster
+         * than the byte-by-byte validation built into RapidJSON.
+         */
+        template<unsigned ParseFlags>
+        inline constexpr unsigned reader_flags = ParseFlags & ~static_cast<unsigned>(rapidjson::kParseValidateEncodingFlag);
+
+        template<unsigned ParseFlags>
+        inline constexpr bool validate_utf8 = (ParseFlags & rapidjson::kParseValidateEncodingFlag) != 0;
+
+        /**
+         * Validates an entire JSON string as UTF-8 before it is parsed.
+         *
+         * @return An error result with the offset of the first ill-formed byte sequence, or a success result.
+         */
+        inline rapidjson::ParseResult check_utf8(const std::string& str)
+        {
+            if (utf8_validate(str.data(), str.size())) {
+                return rapidjson::ParseResult();
+            }
+            return rapidjson::ParseResult(rapidjson::kParseErrorStringInvalidEncoding, utf8_error_offset(str.data(), str.size()));
+        }
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include "detail/perfect_hash.hpp"
+#include "detail/traits.hpp"
+#include <array>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace persistence
+{
+    namespace detail
+    {
+        /** True if no two strings in an array are equal. */
+        template<std::size_t N>
+        constexpr bool is_unique(const std::array<std::string_view, N>& items)
+        {
+            for (std::size_t i = 0; i < N; ++i) {
+                for (std::size_t j = i + 1; j < N; ++j) {
+                    if (items[i] == items[j]) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+    }
+
+    /**
+    * Generic template for variant alternative traits.
+    *
+    * Define template specializations with members `discriminator` and `tag` to identify a class type with a
+    * tag property when the class type is an alternative of a variant type:
+    * ```
+    * constexpr static std::string_view discriminator = "type";
+    * constexpr static std::string_view tag = "Circle";
+    * ```
+    *
+    * If all alternatives of a variant type define a tag, the variant is written as a JSON object whose first
+    * property is the tag, and the alternative to read is selected by the tag rather than by trial and error.
+    *
+    * @tparam T A class type that is an alternative of a variant type.
+    */
+    template<typename T, typename Enable = void>
+    struct variant_traits
+    {};
+
+    template<typename T>
+    using variant_tag_member = decltype(variant_traits<T>::tag);
+
+    /** True if all alternatives of a variant type declare a tag. */
+    template<typename... Ts>
+    constexpr bool is_tagged_variant_v = (sizeof...(Ts) > 0) && (... && detect<Ts, variant_tag_member>::value);
+
+    /**
+     * Maps tags of a variant type whose alternatives all declare a tag to alternative indices.
+     *
+     * @tparam Ts Alternatives of a variant type.
+     */
+    template<typename... Ts>
+    struct VariantTags
+    {
+        static_assert(is_tagged_variant_v<Ts...>, "expected a tag for each variant alternative");
+
+        /** The name of the JSON object property that identifies the alternative. */
+        constexpr static std::string_view discriminator = variant_traits<std::tuple_element_t<0, std::tuple<Ts...>>>::discriminator;
+
+        static_assert((... && (variant_traits<Ts>::discriminator == discriminator)), "expected the same discriminator for all variant alternatives");
+
+        /** Tags of the variant alternatives in declaration order. */
+        constexpr static std::array<std::string_view, sizeof...(Ts)> tags = { variant_traits<Ts>::tag... };
+
+        static_assert(detail::is_unique(tags), "expected a distinct tag for each variant alternative");
+
+        /** Returns the index of the alternative with the given tag, or the number of alternatives if there is none. */
+        static std::size_t index(const std::string_view& tag)
+        {
+            std::size_t k = hash_map.index(tag);
+            return tags[k] == tag ? k : sizeof...(Ts);
+        }
+
+        /**
+         * Evaluates a function with the compile-time index of an alternative given its run-time index.
+         *
+         * @param index The zero-based index of the alternative, less than the number of alternatives.
+         * @param fun A function that takes an `std::integral_constant<std::size_t, I>` and returns `bool`.
+         */
+        template<typename F>
+        static bool dispatch(std::size_t index, F&& fun)
+        {
+            return dispatch_impl(index, fun, std::index_sequence_for<Ts...>());
+        }
+
+    private:
+        template<typename F, std::size_t... I>
+        static bool dispatch_impl(std::size_t index, F& fun, std::index_sequence<I...>)
+        {
+            bool result = false;
+            (void)(... || (index == I && (result = fun(std::integral_constant<std::size_t, I>()), true)));
+            return result;
+        }
+
+        constexpr static PerfectHash<sizeof...(Ts)> hash_map = PerfectHash<sizeof...(Ts)>(tags);
+    };
+}
@@ -36,20 +36,114 @@ namespace persistence
     }
 
     /**
-     * Produces the JSON string representation of an object.
+     * Writes the JSON string representation of an object to an output sink.
+     *
+     * @return False if the object cannot be represented in JSON, or the sink has failed, e.g. because the output has
+     * not fit into a fixed-size buffer.
      */
     template<typename T>
-    bool write_to_string(const T& obj, std::string& str)
+    bool write_to_sink(const T& obj, OutputSink& sink)
     {
-        rapidjson::StringBuffer buffer;
-        StringWriter writer(buffer);
+        StringWriter writer(sink);
         bool result = write_to_string(obj, writer);
-        if (result) {
-            str.assign(buffer.GetString(), buffer.GetString() + buffer.GetSize());
-            return true;
-        } else {
+        sink.Flush();
+        return result && sink.good();
+    }
+
+    /**
+     * Computes the exact number of characters in the JSON string representation of an object, e.g. to send a
+     * `Content-Length` header before streaming the object.
+     *
+     * The object is traversed with the same writers that produce the output, which accounts for escaping, number
+     * formatting and Base64 encoding, but the output itself is discarded.
+     *
+     * @return False if the object cannot be represented in JSON.
+     */
+    template<typename T>
+    bool json_size(const T& obj, std::size_t& size)
+    {
+        CountingSink sink;
+        if (!write_to_sink(obj, sink)) {
             return false;
         }
+        size = sink.size();
+        return true;
+    }
+
+    /**
+     * Computes the exact number of characters in the JSON string representation of an object.
+     */
+    template<typename T>
+    std::size_t json_size(const T& obj)
+    {
+        std::size_t size;
+        if (!json_size(obj, size)) {
+            throw JsonSerializationError();
+        }
+        return size;
+    }
+
+    /**
+     * Writes the JSON string representation of an object to a file or socket, passing output on whenever the
+     * buffer of the sink reaches its watermark. Memory use stays bounded no matter how large the output is.
+     *
+     * @return False if the object cannot be represented in JSON, or the destination has reported an error, e.g.
+     * because the disk is full.
+     */
+    template<typename T>
+    bool write_to_stream(const T& obj, BufferedSink& sink)
+    {
+        return write_to_sink(obj, sink);
+    }
+
+    /**
+     * Writes the JSON string representation of an object to a C standard library file stream.
+     *
+     * @param watermark Number of characters buffered before output is passed on to the file stream.
+     */
+    template<typename T>
+    void write_to_stream(const T& obj, std::FILE* file, std::size_t watermark = BufferedSink::default_watermark)
+    {
+        FileSink sink(file, watermark);
+        if (!write_to_stream(obj, sink)) {
+            throw JsonSerializationError();
+        }
+    }
+
+    /**
+     * Writes the JSON string representation of an object to a C++ output stream.
+     *
+     * @param watermark Number of characters buffered before output is passed on to the output stream.
+     */
+    template<typename T>
+    void write_to_stream(const T& obj, std::ostream& stream, std::size_t watermark = BufferedSink::default_watermark)
+    {
+        OutputStreamSink sink(stream, watermark);
+        if (!write_to_stream(obj, sink)) {
+            throw JsonSerializationError();
+        }
+    }
+
+    /**
+     * Produces the JSON string representation of an object.
+     *
+     * The output is written straight into the string, with no intermediate buffer, reusing the capacity of the
+     * string, e.g. when a response is built in the same string repeatedly. If writing fails, the string is left
+     * empty.
+     */
+    template<typename T>
+    bool write_to_string(const T& obj, std::string& str)
+    {
+        str.clear();
+        bool result;
+        {
+            StringSink sink(str);
+            result = write_to_sink(obj, sink);
+        }
+        if (!result) {
+            str.clear();
+        }
+        return result;
     }
 
     /**
@@ -58,10 +152,12 @@ namespace persistence
     template<typename T>
     std::string write_to_string(const T& obj)
     {
-        std::string str;
-        if (!write_to_string(obj, str)) {
+        // a new string has no capacity to reuse, and growing a memory block that can be remapped, followed by a
+        // single copy, is faster than growing the string in place
+        MemorySink sink;
+        if (!write_to_sink(obj, sink)) {
             throw JsonSerializationError();
         }
-        return str;
+        return std::string(sink.data(), sink.size());
     }
 }
@@ -11,6 +11,7 @@
 #include "write_array.hpp"
 #include "write_bytes.hpp"
 #include "write_datetime.hpp"
+#include "write_decimal.hpp"
 #include "write_enum.hpp"
 #include "write_map.hpp"
 #include "write_set.hpp"
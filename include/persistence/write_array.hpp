@@ -1,5 +1,6 @@
 #pragma once
 #include "write_base.hpp"
+#include "write_fundamental.hpp"
 #include "detail/write_aware.hpp"
 #include "detail/unlikely.hpp"
 #include <array>
@@ -13,6 +14,10 @@ namespace persistence
 
         bool operator()(const std::array<T, N>& container, StringWriter& writer) const
         {
+            if constexpr (is_bulk_number_v<T>) {
+                return JsonNumberArrayWriter<T>::write(container.data(), container.data() + container.size(), writer);
+            }
+
             writer.StartArray();
             std::size_t idx = 0;
             for (const auto& item : container) {
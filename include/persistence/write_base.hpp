@@ -3,7 +3,9 @@
 #include "detail/defer.hpp"
 #include "detail/write_context.hpp"
 #include "detail/config.hpp"
+#include "output_sink.hpp"
 #include <rapidjson/writer.h>
+#include <cstring>
 
 namespace persistence
 {
@@ -18,7 +20,38 @@ namespace persistence
         static_assert(detail::fail<T>, "expected a type that can be serialized to JSON");
     };
 
-    using StringWriter = rapidjson::Writer<rapidjson::StringBuffer>;
+    /**
+     * Writes JSON to an output sink, such as a string, a caller-supplied buffer or a file.
+     */
+    using StringWriter = rapidjson::Writer<OutputSink>;
+
+    namespace detail
+    {
+        /** Grants access to the internal state of a writer. */
+        struct WriterAccess : StringWriter
+        {
+            /** The output stream of a writer. */
+            static OutputSink& stream(StringWriter& writer)
+            {
+                return *(writer.*(&WriterAccess::os_));
+            }
+
+            /**
+             * Writes an object key already in its JSON form and preceded by a separator, as in `,"name"`, and
+             * advances the state of the writer as `Key` would. The separator is omitted for the first member.
+             */
+            static void key(StringWriter& writer, const char* str, std::size_t length)
+            {
+                Level* level = (writer.*(&WriterAccess::level_stack_)).template Top<Level>();
+                if (level->valueCount == 0) {
+                    ++str;
+                    --length;
+                }
+                ++level->valueCount;
+                std::memcpy(stream(writer).Push(length), str, length);
+            }
+        };
+    }
 
     template<typename T>
     bool serialize(const T& obj, StringWriter& writer, WriterContext& context);
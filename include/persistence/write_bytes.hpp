@@ -1,21 +1,36 @@
 #pragma once
 #include "base64.hpp"
 #include "write_base.hpp"
-#include "detail/unlikely.hpp"
-#include <string>
+#include <algorithm>
 
 namespace persistence
 {
+    /**
+     * Writes a sequence of bytes as a Base64-encoded string.
+     *
+     * Base64 characters never need escaping, hence bytes are encoded straight into the output buffer between the
+     * quotes, in chunks that keep the space requested from the output sink bounded.
+     */
     template<>
     struct JsonWriter<byte_vector>
     {
         bool operator()(const byte_vector& container, StringWriter& writer) const
         {
-            std::string str;
-            PERSISTENCE_IF_UNLIKELY(!base64_encode(container, str)) {
-                return false;
+            constexpr std::size_t chunk_size = 3 * 16384;
+
+            // let the writer emit any separator and the opening quote
+            writer.RawValue("\"", 1, rapidjson::kStringType);
+
+            OutputSink& stream = detail::WriterAccess::stream(writer);
+            const std::byte* p = container.data();
+            std::size_t remaining = container.size();
+            while (remaining > 0) {
+                const std::size_t count = std::min(chunk_size, remaining);
+                detail::base64_encode(p, count, stream.Push(detail::base64_encoded_length(count)));
+                p += count;
+                remaining -= count;
             }
-            writer.String(str.data(), static_cast<rapidjson::SizeType>(str.size()), true);
+            stream.Put('"');
             return true;
         }
     };
@@ -13,7 +13,11 @@ namespace persistence
         bool operator()(std::chrono::year_month_day value, StringWriter& writer) const
         {
             auto dt = to_iso_date(std::chrono::sys_days(value));
-            writer.String(dt.text, static_cast<rapidjson::SizeType>(iso_date::length()), true);
+            PERSISTENCE_IF_UNLIKELY(dt.size() == 0) {
+                // year out of the range of ISO 8601 without expansion
+                return false;
+            }
+            writer.String(dt.text, static_cast<rapidjson::SizeType>(dt.size()), true);
             return true;
         }
     };
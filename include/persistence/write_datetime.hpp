@@ -7,11 +7,29 @@ namespace persistence
     template<>
     struct JsonWriter<timestamp>
     {
+        JsonWriter() = default;
+
+        explicit JsonWriter(TimeEncoding encoding)
+            : encoding(encoding)
+        {}
+
         bool operator()(timestamp value, StringWriter& writer) const
         {
+            if (encoding != TimeEncoding::iso8601) {
+                writer.Int64(detail::to_epoch(value, encoding));
+                return true;
+            }
+
             auto dt = to_iso_datetime(value);
-            writer.String(dt.text, static_cast<rapidjson::SizeType>(iso_datetime::length()), true);
+            PERSISTENCE_IF_UNLIKELY(dt.size() == 0) {
+                // year out of the range of ISO 8601 without expansion
+                return false;
+            }
+            writer.String(dt.text, static_cast<rapidjson::SizeType>(dt.size()), true);
             return true;
         }
+
+    private:
+        TimeEncoding encoding = TimeEncoding::iso8601;
     };
 }
@@ -0,0 +1,18 @@
+#pragma once
+#include "decimal.hpp"
+#include "write_base.hpp"
+
+namespace persistence
+{
+    template<>
+    struct JsonWriter<decimal>
+    {
+        bool operator()(const decimal& value, StringWriter& writer) const
+        {
+            char buf[detail::max_decimal_length];
+            const char* end = detail::format_decimal(value, buf);
+            writer.RawValue(buf, static_cast<std::size_t>(end - buf), rapidjson::kNumberType);
+            return true;
+        }
+    };
+}
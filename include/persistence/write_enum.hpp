@@ -4,7 +4,7 @@
 #include "write_string.hpp"
 #include "detail/traits.hpp"
 #ifdef PERSISTENCE_BOOST_DESCRIBE
-#include <boost/describe/enum_to_string.hpp>
+#include "enum_utility.hpp"
 #endif
 
 namespace persistence
@@ -41,7 +41,7 @@ namespace persistence
         bool operator()(T value, StringWriter& writer) const
         {
             JsonWriter<std::string_view> string_writer;
-            return string_writer(::boost::describe::enum_to_string(value, ""), writer);
+            return string_writer(detail::described_enum_converter<T>.to_string(value), writer);
         }
     };
 #endif
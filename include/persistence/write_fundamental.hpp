@@ -1,6 +1,9 @@
 #pragma once
 #include "write_base.hpp"
+#include "detail/float_formatter.hpp"
+#include "detail/integer_formatter.hpp"
 #include "detail/unlikely.hpp"
+#include <algorithm>
 #include <cmath>
 
 namespace persistence
@@ -122,6 +125,12 @@ namespace persistence
     {
         static_assert(std::is_floating_point_v<T>, "T must be a floating point type");
 
+        JsonFloatWriter() = default;
+
+        explicit JsonFloatWriter(const NumberFormat& format)
+            : format(format)
+        {}
+
         bool operator()(T value, StringWriter& writer) const
         {
             PERSISTENCE_IF_UNLIKELY(!std::isfinite(value)) {
@@ -129,16 +138,121 @@ namespace persistence
                 return false;
             }
 
-            writer.Double(value);
+            // shortest representation in the precision of the type, not that of `double`
+            char buffer[detail::max_float_length];
+            char* end = format ? detail::format_float(value, format, buffer) : detail::format_float(value, buffer);
+            writer.RawValue(buffer, static_cast<std::size_t>(end - buffer), rapidjson::kNumberType);
             return true;
         }
+
+    private:
+        NumberFormat format;
     };
 
     template<>
     struct JsonWriter<float> : JsonFloatWriter<float>
-    {};
+    {
+        using JsonFloatWriter<float>::JsonFloatWriter;
+    };
 
     template<>
     struct JsonWriter<double> : JsonFloatWriter<double>
-    {};
+    {
+        using JsonFloatWriter<double>::JsonFloatWriter;
+    };
+
+    /**
+     * True if a sequence of values of the type can be written with `JsonNumberArrayWriter`.
+     *
+     * Wide character types are not numbers, and have no writer of their own.
+     */
+    template<typename T>
+    constexpr bool is_bulk_number_v =
+        std::is_arithmetic_v<T> &&
+        !std::is_same_v<T, bool> &&
+        !std::is_same_v<T, wchar_t> &&
+#if defined(__cpp_char8_t)
+        !std::is_same_v<T, char8_t> &&
+#endif
+        !std::is_same_v<T, char16_t> &&
+        !std::is_same_v<T, char32_t> &&
+        !std::is_same_v<T, long double>;
+
+    /**
+     * Writes a contiguous sequence of numbers as the items of a JSON array.
+     *
+     * Items are formatted in a tight loop straight into the output buffer of the writer. Items in a chunk are
+     * written into space the output sink has available for the longest representation of each, and the unused
+     * part is released afterwards. When not even a single item fits, the item is formatted separately, and the
+     * sink is asked to make room only for the characters actually used.
+     *
+     * @tparam T Integer or floating-point type.
+     */
+    template<typename T>
+    struct JsonNumberArrayWriter
+    {
+        static_assert(is_bulk_number_v<T>, "T must be an integer or floating point type");
+
+        static bool write(const T* first, const T* last, StringWriter& writer)
+        {
+            constexpr std::size_t chunk_size = 1024;
+
+            writer.StartArray();
+            if (first != last) {
+                OutputSink& stream = detail::WriterAccess::stream(writer);
+                while (first != last) {
+                    const std::size_t count = std::min({ chunk_size, stream.available() / item_length, static_cast<std::size_t>(last - first) });
+                    if (count == 0) {
+                        char item[item_length];
+                        char* out = format_item(*first++, item);
+                        PERSISTENCE_IF_UNLIKELY(out == nullptr) {
+                            return false;
+                        }
+                        const std::size_t length = static_cast<std::size_t>(out - item);
+                        std::memcpy(stream.Push(length), item, length);
+                        continue;
+                    }
+
+                    const T* chunk_last = first + count;
+                    char* begin = stream.PushUnsafe(count * item_length);
+                    char* out = begin;
+                    for (; first != chunk_last; ++first) {
+                        out = format_item(*first, out);
+                        PERSISTENCE_IF_UNLIKELY(out == nullptr) {
+                            stream.Pop(count * item_length);
+                            return false;
+                        }
+                    }
+                    stream.Pop(count * item_length - static_cast<std::size_t>(out - begin));
+                }
+
+                // drop the separator after the last item
+                stream.Pop(1);
+            }
+            writer.EndArray();
+            return true;
+        }
+
+    private:
+        constexpr static std::size_t item_length = (std::is_floating_point_v<T> ? detail::max_float_length : detail::max_integer_length) + 1;
+
+        /**
+         * Writes an item followed by a separator.
+         *
+         * @return The position past the separator, or null if the item cannot be represented in JSON.
+         */
+        static char* format_item(T value, char* out)
+        {
+            if constexpr (std::is_floating_point_v<T>) {
+                PERSISTENCE_IF_UNLIKELY(!std::isfinite(value)) {
+                    return nullptr;
+                }
+                out = detail::format_float(value, out);
+            } else {
+                out = detail::format_integer(value, out);
+            }
+            *out++ = ',';
+            return out;
+        }
+    };
 }
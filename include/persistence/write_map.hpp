@@ -1,6 +1,7 @@
 #pragma once
 #include "dictionary.hpp"
 #include "write_base.hpp"
+#include "detail/integer_key.hpp"
 #include "detail/write_aware.hpp"
 #include "detail/unlikely.hpp"
 #include <map>
@@ -29,6 +30,32 @@ namespace persistence
         }
     };
 
+    /**
+     * Writes a dictionary with integer keys as a JSON object, formatting each key in decimal on the stack.
+     */
+    template<typename C>
+    struct JsonIntegerKeyDictionaryWriter : JsonContextAwareWriter
+    {
+        using JsonContextAwareWriter::JsonContextAwareWriter;
+
+        bool operator()(const C& container, StringWriter& writer) const
+        {
+            writer.StartObject();
+            for (auto&& [key, value] : container) {
+                const detail::IntegerKey key_text(key);
+                const std::string_view key_view = key_text.view();
+                writer.Key(key_view.data(), static_cast<rapidjson::SizeType>(key_view.size()), true);
+
+                WriterContext value_context(context, Segment(key_view));
+                PERSISTENCE_IF_UNLIKELY(!serialize<typename C::mapped_type>(value, writer, value_context)) {
+                    return false;
+                }
+            }
+            writer.EndObject();
+            return true;
+        }
+    };
+
     template<typename T>
     struct JsonWriter<literal_dict<T>> : JsonDictionaryWriter<literal_dict<T>>
     {
@@ -64,4 +91,28 @@ namespace persistence
     {
         using JsonDictionaryWriter<string_unordered_map<T>>::JsonDictionaryWriter;
     };
+
+    template<typename K, typename T>
+    struct JsonWriter<std::map<K, T>, std::enable_if_t<detail::is_integer_key_v<K>>> : JsonIntegerKeyDictionaryWriter<std::map<K, T>>
+    {
+        using JsonIntegerKeyDictionaryWriter<std::map<K, T>>::JsonIntegerKeyDictionaryWriter;
+    };
+
+    template<typename K, typename T>
+    struct JsonWriter<std::unordered_map<K, T>, std::enable_if_t<detail::is_integer_key_v<K>>> : JsonIntegerKeyDictionaryWriter<std::unordered_map<K, T>>
+    {
+        using JsonIntegerKeyDictionaryWriter<std::unordered_map<K, T>>::JsonIntegerKeyDictionaryWriter;
+    };
+
+    template<typename T, DuplicateKeys Duplicates>
+    struct JsonWriter<flat_map<std::string, T, Duplicates>> : JsonDictionaryWriter<flat_map<std::string, T, Duplicates>>
+    {
+        using JsonDictionaryWriter<flat_map<std::string, T, Duplicates>>::JsonDictionaryWriter;
+    };
+
+    template<typename K, typename T, DuplicateKeys Duplicates>
+    struct JsonWriter<flat_map<K, T, Duplicates>, std::enable_if_t<detail::is_integer_key_v<K>>> : JsonIntegerKeyDictionaryWriter<flat_map<K, T, Duplicates>>
+    {
+        using JsonIntegerKeyDictionaryWriter<flat_map<K, T, Duplicates>>::JsonIntegerKeyDictionaryWriter;
+    };
 }
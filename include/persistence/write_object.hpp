@@ -2,6 +2,8 @@
 #include "object.hpp"
 #include "object_reflection.hpp"
 #include "write_base.hpp"
+#include "write_fundamental.hpp"
+#include "detail/escaped_key.hpp"
 #include "detail/write_aware.hpp"
 #include "detail/unlikely.hpp"
 #include "detail/traits.hpp"
@@ -23,7 +25,7 @@ namespace persistence
         {
             static_assert(std::is_base_of_v<B, C>, "expected a member variable part of the class inheritance chain");
             if (member.ref(object).has_value()) {
-                return write(member.name(), member.ref(object).value());
+                return write<D>(member.ref(object).value(), member.format(), member.time_encoding());
             } else {
                 return *this;
             }
@@ -33,14 +35,14 @@ namespace persistence
         JsonObjectWriter& operator&(const member::variable<T, B, P, D>& member)
         {
             static_assert(std::is_base_of_v<B, C>, "expected a member variable part of the class inheritance chain");
-            return write(member.name(), member.ref(object));
+            return write<D>(member.ref(object), member.format(), member.time_encoding());
         }
 
         template<typename T, class B, auto P, typename D>
         JsonObjectWriter& operator&(const member::variable_default<T, B, P, D>& member)
         {
             static_assert(std::is_base_of_v<B, C>, "expected a member variable part of the class inheritance chain");
-            return write(member.name(), member.ref(object));
+            return write<D>(member.ref(object), member.format(), member.time_encoding());
         }
 
         operator bool() const
@@ -54,20 +56,39 @@ namespace persistence
         }
 
     private:
-        template<typename T>
-        JsonObjectWriter& write(const std::string_view& name, const T& ref)
+        /**
+         * Writes a member, copying its key from a fragment escaped at compile time straight into the output.
+         */
+        template<typename D, typename T>
+        JsonObjectWriter& write(const T& ref, const NumberFormat& format, TimeEncoding encoding)
         {
             PERSISTENCE_IF_UNLIKELY(!result) {
                 return *this;
             }
 
-            writer.Key(name.data(), static_cast<rapidjson::SizeType>(name.size()), false);
+            using key_type = detail::escaped_key<D>;
+            detail::WriterAccess::key(writer, key_type::value.data(), key_type::size);
 
-            WriterContext member_context(context, Segment(name));
-            result = result && serialize(ref, writer, member_context);
+            WriterContext member_context(context, Segment(std::string_view(D::name())));
+            result = result && write_member(ref, format, encoding, writer, member_context);
             return *this;
         }
 
+        template<typename T>
+        static bool write_member(const T& ref, const NumberFormat& format, TimeEncoding encoding, StringWriter& writer, WriterContext& context)
+        {
+            if constexpr (std::is_floating_point_v<T>) {
+                if (format) {
+                    return JsonWriter<T>(format)(ref, writer);
+                }
+            } else if constexpr (detail::is_time_encodable_v<T>) {
+                if (encoding != TimeEncoding::iso8601) {
+                    return JsonWriter<T>(encoding)(ref, writer);
+                }
+            }
+            return serialize(ref, writer, context);
+        }
+
     private:
         /** The C++ object from which data is read. */
         const C& object;
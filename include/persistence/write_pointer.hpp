@@ -2,7 +2,6 @@
 #include "write_base.hpp"
 #include "detail/write_aware.hpp"
 #include "detail/unlikely.hpp"
-#include "detail/path.hpp"
 #include <memory>
 
 namespace persistence
@@ -37,14 +36,12 @@ namespace persistence
 
         bool operator()(const std::shared_ptr<T>& pointer, StringWriter& writer) const
         {
-            auto segments = context.get(pointer);
-            if (segments) {
-                std::string ref = Path(std::move(*segments)).str();
-
+            auto ref = context.get(pointer.get());
+            if (ref) {
                 // create a {"$ref": "/path/to/earlier/occurrence"}
                 writer.StartObject();
                 writer.Key("$ref");
-                writer.String(ref.data(), static_cast<rapidjson::SizeType>(ref.size()), true);
+                writer.String(ref->data(), static_cast<rapidjson::SizeType>(ref->size()), true);
                 writer.EndObject();
 
             } else {
@@ -53,7 +50,7 @@ namespace persistence
                 }
 
                 // assign a "/path/to/this/occurrence"
-                context.put(pointer);
+                context.put(pointer.get());
             }
             return true;
         }
@@ -1,5 +1,7 @@
 #pragma once
+#include "variant.hpp"
 #include "write_base.hpp"
+#include "write_object.hpp"
 #include "detail/write_aware.hpp"
 #include <variant>
 
@@ -12,12 +14,43 @@ namespace persistence
 
         bool operator()(const std::variant<Ts...>& value, StringWriter& writer) const
         {
-            return std::visit(
-                [&](auto&& arg) -> bool {
-                    return serialize(arg, writer, context);
-                },
-                value
-            );
+            if constexpr (is_tagged_variant_v<Ts...>) {
+                return std::visit(
+                    [&](auto&& arg) -> bool {
+                        return write_tagged(arg, writer);
+                    },
+                    value
+                );
+            } else {
+                return std::visit(
+                    [&](auto&& arg) -> bool {
+                        return serialize(arg, writer, context);
+                    },
+                    value
+                );
+            }
+        }
+
+    private:
+        /** Writes an alternative as a JSON object with the tag as its first property. */
+        template<typename T>
+        bool write_tagged(const T& value, StringWriter& writer) const
+        {
+            static_assert(has_custom_writer<T>::value, "expected a class type with a `persist` function for a tagged variant alternative");
+
+            constexpr std::string_view discriminator = VariantTags<Ts...>::discriminator;
+            constexpr std::string_view tag = variant_traits<T>::tag;
+            JsonObjectWriter serializer(context, value, writer);
+
+            writer.StartObject();
+            writer.Key(discriminator.data(), static_cast<rapidjson::SizeType>(discriminator.size()), false);
+            writer.String(tag.data(), static_cast<rapidjson::SizeType>(tag.size()), false);
+            const_cast<T&>(value).persist(serializer);
+            if (!serializer) {
+                return false;
+            }
+            writer.EndObject();
+            return true;
         }
     };
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include "write_base.hpp"
+#include "write_fundamental.hpp"
 #include "detail/write_aware.hpp"
 #include "detail/unlikely.hpp"
 #include <vector>
@@ -13,6 +14,10 @@ namespace persistence
 
         bool operator()(const std::vector<T>& container, StringWriter& writer) const
         {
+            if constexpr (is_bulk_number_v<T>) {
+                return JsonNumberArrayWriter<T>::write(container.data(), container.data() + container.size(), writer);
+            }
+
             writer.StartArray();
             std::size_t k = 0;
             for (const auto& item : container) {
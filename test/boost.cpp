@@ -12,6 +12,7 @@
 #include "persistence/deserialize.hpp"
 #include "test_deserialize.hpp"
 
+#include "example_numerous_enum.hpp"
 #include <boost/describe.hpp>
 
 namespace
@@ -34,6 +35,12 @@ namespace
     BOOST_DESCRIBE_ENUM(Suit, Diamonds, Hearts, Clubs, Spades)
 }
 
+// `BOOST_DESCRIBE_ENUM` takes a limited number of arguments, so describe each enumerator of a large enumeration
+#define TEST_NUMEROUS_ENTRY(e) BOOST_DESCRIBE_ENUM_ENTRY(Numerous, e)
+BOOST_DESCRIBE_ENUM_BEGIN(Numerous)
+TEST_FOR_EACH_300(TEST_NUMEROUS_ENTRY)
+BOOST_DESCRIBE_ENUM_END(Numerous)
+
 using namespace test;
 
 TEST(Serialization, BoostEnumTypes)
@@ -45,6 +52,10 @@ TEST(Serialization, BoostEnumTypes)
     EXPECT_TRUE(test_serialize(Suit::Hearts, "\"Hearts\""));
     EXPECT_TRUE(test_serialize(Suit::Clubs, "\"Clubs\""));
     EXPECT_TRUE(test_serialize(Suit::Spades, "\"Spades\""));
+
+    for (std::size_t k = 0; k < 300; ++k) {
+        EXPECT_TRUE(test_serialize(static_cast<Numerous>(k), "\"" + numerous_name(k) + "\""));
+    }
 }
 
 TEST(Deserialization, BoostEnumTypes)
@@ -60,5 +71,10 @@ TEST(Deserialization, BoostEnumTypes)
     EXPECT_TRUE(test_deserialize("\"Spades\"", Suit::Spades));
     EXPECT_TRUE(test_no_deserialize<Suit>("0"));
     EXPECT_TRUE(test_no_deserialize<Suit>("3"));
+
+    for (std::size_t k = 0; k < 300; ++k) {
+        EXPECT_TRUE(test_deserialize("\"" + numerous_name(k) + "\"", static_cast<Numerous>(k)));
+    }
+    EXPECT_TRUE(test_no_deserialize<Numerous>("\"d00\""));
 }
 #endif
@@ -53,6 +53,57 @@ TEST(Deserialization, Vector)
     EXPECT_TRUE(test_no_deserialize<std::vector<int>>("{}"));
 }
 
+TEST(Deserialization, NumberVector)
+{
+    EXPECT_TRUE(test_deserialize("[ ]", std::vector<int>()));
+    EXPECT_TRUE(test_deserialize(" [\n\t1 ,2\r\n, 3 ] ", std::vector<int> { 1, 2, 3 }));
+    EXPECT_TRUE(test_deserialize("[-128, 0, 127]", std::vector<short> { -128, 0, 127 }));
+    EXPECT_TRUE(test_deserialize("[0, 18446744073709551615]", std::vector<unsigned long long> { 0, 18446744073709551615ull }));
+    EXPECT_TRUE(test_deserialize("[0, 1, -1.5, 2.5e-3, 1E2]", std::vector<double> { 0.0, 1.0, -1.5, 2.5e-3, 100.0 }));
+
+    // a single item, which the reader delivers as a token, and is read back from the input
+    EXPECT_TRUE(test_deserialize("[1.5]", std::vector<float> { 1.5f }));
+    EXPECT_TRUE(test_deserialize("[ 0.25 ]", std::vector<double> { 0.25 }));
+
+    // items the scanner leaves to the reader
+    EXPECT_TRUE(test_deserialize("[1, 12345678, 3]", std::vector<float> { 1.0f, 12345678.0f, 3.0f }));
+    EXPECT_TRUE(test_deserialize("[1, 1234567890123456, 3]", std::vector<double> { 1.0, 1234567890123456.0, 3.0 }));
+
+    // the first item, read by the reader, is rounded directly to float like the items that follow
+    std::vector<float> halfway;
+    EXPECT_TRUE(persistence::parse("[1.00000005960464477550, 1.00000005960464477550]", halfway));
+    EXPECT_EQ(halfway, (std::vector<float> { 0x1.000002p0f, 0x1.000002p0f }));
+
+    EXPECT_TRUE(test_deserialize(
+        "[[1.5, 2.5], [], [ 3 ]]",
+        std::vector<std::vector<double>> { { 1.5, 2.5 }, {}, { 3.0 } }
+    ));
+
+    EXPECT_TRUE(test_no_deserialize<std::vector<int>>("[1, 2.5]"));
+    EXPECT_TRUE(test_no_deserialize<std::vector<int>>("[1, null]"));
+    EXPECT_TRUE(test_no_deserialize<std::vector<int>>("[1, [2]]"));
+    EXPECT_TRUE(test_no_deserialize<std::vector<int>>("[1, 2147483648]"));
+    EXPECT_TRUE(test_no_deserialize<std::vector<unsigned int>>("[1, -1]"));
+
+    std::vector<int> items;
+    EXPECT_FALSE(persistence::parse("[1, 2,]", items));
+    EXPECT_FALSE(persistence::parse("[1 2]", items));
+    EXPECT_FALSE(persistence::parse("[1, 2", items));
+    EXPECT_FALSE(persistence::parse("[1, 01]", items));
+    EXPECT_FALSE(persistence::parse("[1, -]", items));
+
+    std::vector<double> values;
+    EXPECT_FALSE(persistence::parse("[1, 2.]", values));
+    EXPECT_FALSE(persistence::parse("[1, 2e]", values));
+    EXPECT_FALSE(persistence::parse("[1, 1e400]", values));
+
+    std::vector<float> floats;
+    EXPECT_FALSE(persistence::parse("[1, 3.5e38]", floats));
+
+    EXPECT_THROW(persistence::parse<std::vector<int>>("[1, 2, 2.5]"), persistence::JsonParseError);
+    EXPECT_FALSE(persistence::parse("[1, 2, true]", items));
+}
+
 TEST(Deserialization, Set)
 {
     EXPECT_TRUE(test_deserialize("[]", std::set<int>()));
@@ -153,3 +204,84 @@ TEST(Deserialization, UnorderedMap)
     EXPECT_TRUE(test_no_deserialize<map_type>("[]"));
     EXPECT_TRUE(test_no_deserialize<map_type>("[1]"));
 }
+
+TEST(Deserialization, IntegerKeyMap)
+{
+    using map_type = std::map<int, std::string>;
+
+    EXPECT_TRUE(test_deserialize("{}", map_type()));
+    EXPECT_TRUE(test_deserialize(
+        "{\"-2147483648\": \"min\", \"-1\": \"a\", \"0\": \"b\", \"23\": \"c\", \"2147483647\": \"max\"}",
+        map_type {
+            { -2147483647 - 1, "min" }, { -1, "a" }, { 0, "b" }, { 23, "c" }, { 2147483647, "max" }
+        }
+    ));
+    EXPECT_TRUE(test_deserialize(
+        "{\"1\": [1, 2], \"18446744073709551615\": [4, 8]}",
+        std::unordered_map<std::uint64_t, std::vector<int>> {
+            { 1, {1, 2} }, { 18446744073709551615u, {4, 8} }
+        }
+    ));
+
+    std::map<short, TestValue> obj_map;
+    obj_map.insert(std::make_pair(short(-5), TestValue("a")));
+    EXPECT_TRUE(test_deserialize("{\"-5\":{\"value\":\"a\"}}", obj_map));
+
+    EXPECT_TRUE(test_no_deserialize<map_type>("{\"\": \"a\"}"));
+    EXPECT_TRUE(test_no_deserialize<map_type>("{\"key\": \"a\"}"));
+    EXPECT_TRUE(test_no_deserialize<map_type>("{\"1.5\": \"a\"}"));
+    EXPECT_TRUE(test_no_deserialize<map_type>("{\"+1\": \"a\"}"));
+    EXPECT_TRUE(test_no_deserialize<map_type>("{\" 1\": \"a\"}"));
+    EXPECT_TRUE(test_no_deserialize<map_type>("{\"2147483648\": \"a\"}"));
+    EXPECT_TRUE(test_no_deserialize<map_type>("{\"1\": 1}"));
+    EXPECT_TRUE((test_no_deserialize<std::map<unsigned, int>>("{\"-1\": 1}")));
+    EXPECT_TRUE(test_no_deserialize<map_type>("[]"));
+
+    try {
+        persistence::deserialize<map_type>("{\"1\": \"a\", \"x\": \"b\"}");
+        FAIL();
+    } catch (persistence::JsonDeserializationError& e) {
+        EXPECT_EQ(e.path, "/x");
+    }
+}
+
+TEST(Deserialization, FlatMap)
+{
+    using map_type = persistence::string_flat_map<std::vector<int>>;
+    using unique_map_type = persistence::string_flat_map<int, persistence::DuplicateKeys::reject>;
+
+    EXPECT_TRUE(test_deserialize("{}", map_type()));
+    EXPECT_TRUE(test_deserialize(
+        "{\"key3\": [3], \"key1\": [], \"key2\": [2, 2]}",
+        map_type {
+            { "key1", {} }, { "key2", {2, 2} }, { "key3", {3} }
+        }
+    ));
+    EXPECT_TRUE(test_deserialize(
+        "{\"23\": \"c\", \"-1\": \"a\", \"0\": \"b\"}",
+        persistence::flat_map<int, std::string> {
+            { -1, "a" }, { 0, "b" }, { 23, "c" }
+        }
+    ));
+
+    // the last of several values with the same key takes effect, unless duplicates are rejected
+    EXPECT_TRUE(test_deserialize(
+        "{\"b\": [1], \"a\": [2], \"b\": [3], \"a\": [4], \"c\": [5]}",
+        map_type {
+            { "a", {4} }, { "b", {3} }, { "c", {5} }
+        }
+    ));
+    EXPECT_TRUE(test_deserialize("{\"b\": 1, \"a\": 2}", unique_map_type { { "a", 2 }, { "b", 1 } }));
+    EXPECT_TRUE(test_no_deserialize<unique_map_type>("{\"b\": 1, \"a\": 2, \"b\": 3}"));
+    EXPECT_TRUE(test_no_deserialize<unique_map_type>("{\"a\": 1, \"a\": 1}"));
+
+    EXPECT_TRUE(test_no_deserialize<map_type>("[]"));
+    EXPECT_TRUE(test_no_deserialize<map_type>("{\"a\": 1}"));
+    EXPECT_TRUE((test_no_deserialize<persistence::flat_map<int, std::string>>("{\"a\": \"a\"}")));
+
+    // items keep the order in the input
+    using dict_type = persistence::string_dict<int>;
+    EXPECT_TRUE(test_deserialize("{}", dict_type()));
+    EXPECT_TRUE(test_deserialize("{\"b\": 1, \"a\": 2, \"b\": 3}", dict_type { { "b", 1 }, { "a", 2 }, { "b", 3 } }));
+    EXPECT_TRUE(test_no_deserialize<dict_type>("[[\"a\", 1]]"));
+}
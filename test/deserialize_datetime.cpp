@@ -1,12 +1,15 @@
 #include <gtest/gtest.h>
 #include "persistence/parse_datetime.hpp"
 #include "persistence/deserialize_datetime.hpp"
+#include "persistence/parse_object.hpp"
+#include "persistence/deserialize_object.hpp"
 #if __cplusplus >= 202002L
 #include "persistence/parse_date.hpp"
 #include "persistence/deserialize_date.hpp"
 #endif
 #include "persistence/parse.hpp"
 #include "persistence/deserialize.hpp"
+#include "example_classes.hpp"
 #include "test_deserialize.hpp"
 
 using namespace test;
@@ -24,9 +27,46 @@ TEST(Deserialization, DateTimeTypes)
     // space instead of 'T'
     EXPECT_TRUE(test_deserialize("\"2022-02-01 23:02:01Z\"", make_datetime(2022, 2, 1, 23, 2, 1)));
 
+    // fraction of a second
+    EXPECT_TRUE(test_deserialize("\"2022-02-01T23:02:01.5Z\"", make_datetime(2022, 2, 1, 23, 2, 1, 500000000)));
+    EXPECT_TRUE(test_deserialize("\"2022-02-01T23:02:01.250Z\"", make_datetime(2022, 2, 1, 23, 2, 1, 250000000)));
+    EXPECT_TRUE(test_deserialize("\"2022-02-01T23:02:01.000250Z\"", make_datetime(2022, 2, 1, 23, 2, 1, 250000)));
+    EXPECT_TRUE(test_deserialize("\"2022-02-01T23:02:01.123456789Z\"", make_datetime(2022, 2, 1, 23, 2, 1, 123456789)));
+
+    // offset from UTC
+    EXPECT_TRUE(test_deserialize("\"2022-02-01T23:02:01+01:00\"", make_datetime(2022, 2, 1, 22, 2, 1)));
+    EXPECT_TRUE(test_deserialize("\"2022-02-01T23:02:01-05:30\"", make_datetime(2022, 2, 2, 4, 32, 1)));
+    EXPECT_TRUE(test_deserialize("\"2022-02-01T23:02:01.250+00:00\"", make_datetime(2022, 2, 1, 23, 2, 1, 250000000)));
+    EXPECT_TRUE(test_deserialize("\"2000-01-01T00:30:00+01:00\"", make_datetime(1999, 12, 31, 23, 30, 0)));
+
+    // dates before the epoch and far in the future
+    EXPECT_TRUE(test_deserialize("\"1900-03-01T12:00:00Z\"", make_datetime(1900, 3, 1, 12, 0, 0)));
+    EXPECT_TRUE(test_deserialize("\"1700-01-01T00:00:00Z\"", make_datetime(1700, 1, 1, 0, 0, 0)));
+    EXPECT_TRUE(test_deserialize("\"2199-12-31T23:59:59Z\"", make_datetime(2199, 12, 31, 23, 59, 59)));
+
+    // out of the range of the clock, which spans fewer than 600 years with nanosecond precision
+    if (std::chrono::duration_cast<std::chrono::hours>(timestamp::duration::max()).count() < 8000ll * 366 * 24) {
+        EXPECT_TRUE(test_no_deserialize<timestamp>("\"9999-12-31T23:59:59Z\""));
+        EXPECT_TRUE(test_no_deserialize<timestamp>("\"0001-01-01T00:00:00Z\""));
+    }
+
     // two-digit year
     EXPECT_TRUE(test_no_deserialize<timestamp>("\"22-02-01T23:02:01Z\""));
 
+    // invalid fraction of a second
+    EXPECT_TRUE(test_no_deserialize<timestamp>("\"2022-02-01T23:02:01.Z\""));
+    EXPECT_TRUE(test_no_deserialize<timestamp>("\"2022-02-01T23:02:01.\""));
+    EXPECT_TRUE(test_no_deserialize<timestamp>("\"2022-02-01T23:02:01.1234567890Z\""));
+    EXPECT_TRUE(test_no_deserialize<timestamp>("\"2022-02-01T23:02:01,5Z\""));
+
+    // invalid offset from UTC
+    EXPECT_TRUE(test_no_deserialize<timestamp>("\"2022-02-01T23:02:01+01\""));
+    EXPECT_TRUE(test_no_deserialize<timestamp>("\"2022-02-01T23:02:01+0100\""));
+    EXPECT_TRUE(test_no_deserialize<timestamp>("\"2022-02-01T23:02:01+24:00\""));
+    EXPECT_TRUE(test_no_deserialize<timestamp>("\"2022-02-01T23:02:01+01:60\""));
+    EXPECT_TRUE(test_no_deserialize<timestamp>("\"2022-02-01T23:02:01+01:00Z\""));
+    EXPECT_TRUE(test_no_deserialize<timestamp>("\"2022-02-01T23:02:01ZZ\""));
+
     // missing or wrong time zone
     EXPECT_TRUE(test_no_deserialize<timestamp>("\"2022-02-01T23:02:01\""));
     EXPECT_TRUE(test_no_deserialize<timestamp>("\"2022-02-01T23:02:01A\""));
@@ -94,3 +134,30 @@ TEST(Deserialization, DateTimeTypes)
     EXPECT_TRUE(test_no_deserialize<year_month_day>("{}"));
 #endif
 }
+
+TEST(Deserialization, TimeEncoding)
+{
+    using persistence::make_datetime;
+
+    TestTimeEncoding obj;
+    obj.created = make_datetime(2022, 2, 1, 23, 2, 1, 250000000);
+    obj.expires = make_datetime(1969, 12, 31, 23, 59, 59, 999999999);
+    obj.logged = make_datetime(2022, 2, 1, 23, 2, 1);
+    EXPECT_TRUE(test_deserialize("{\"created\": 1643756521250, \"expires\": -1, \"logged\": \"2022-02-01T23:02:01Z\"}", obj));
+
+    obj.updated = make_datetime(2022, 2, 1, 23, 2, 1);
+    EXPECT_TRUE(test_deserialize("{\"logged\": \"2022-02-01T23:02:01Z\", \"updated\": 1643756521, \"expires\": -1, \"created\": 1643756521250}", obj));
+
+    TestTimeEncodingSolo solo;
+    solo.time = make_datetime(1970, 1, 1, 0, 0, 1, 2000);
+    EXPECT_TRUE(test_deserialize("{\"time\": 1000002}", solo));
+
+    // wrong representation
+    EXPECT_TRUE(test_no_deserialize<TestTimeEncodingSolo>("{\"time\": \"1970-01-01T00:00:01Z\"}"));
+    EXPECT_TRUE(test_no_deserialize<TestTimeEncodingSolo>("{\"time\": 1.5}"));
+    EXPECT_TRUE(test_no_deserialize<TestTimeEncoding>("{\"created\": 0, \"expires\": 0, \"logged\": 0}"));
+
+    // out of the range of the clock
+    EXPECT_TRUE(test_no_deserialize<TestTimeEncoding>("{\"created\": 0, \"updated\": 9223372036854775807, \"expires\": 0, \"logged\": \"2022-02-01T23:02:01Z\"}"));
+    EXPECT_TRUE(test_no_deserialize<TestTimeEncodingSolo>("{\"time\": 18446744073709551615}"));
+}
@@ -2,8 +2,10 @@
 #include "example_enums.hpp"
 #include "example_enum_traits.hpp"
 #include "persistence/parse_enum.hpp"
+#include "persistence/parse_vector.hpp"
 #include "persistence/parse.hpp"
 #include "persistence/deserialize_enum.hpp"
+#include "persistence/deserialize_vector.hpp"
 #include "persistence/deserialize.hpp"
 #include "test_deserialize.hpp"
 
@@ -35,4 +37,5 @@ TEST(Deserialization, EnumTypes)
     EXPECT_TRUE(test_no_deserialize<Esper>("1"));
     EXPECT_TRUE(test_no_deserialize<Esper>("\"\""));
     EXPECT_TRUE(test_no_deserialize<Esper>("\"NaN\""));
+    EXPECT_TRUE(test_deserialize("[\"Tri\", \"Unu\", \"Ok\"]", std::vector<Esper>({ Esper::Tri, Esper::Unu, Esper::Ok })));
 }
@@ -1,9 +1,16 @@
 #include <gtest/gtest.h>
+#include "persistence/parse_decimal.hpp"
 #include "persistence/parse_fundamental.hpp"
+#include "persistence/parse_map.hpp"
+#include "persistence/parse_string.hpp"
+#include "persistence/parse_vector.hpp"
 #include "persistence/parse.hpp"
+#include "persistence/deserialize_decimal.hpp"
 #include "persistence/deserialize_fundamental.hpp"
 #include "persistence/deserialize.hpp"
 #include "test_deserialize.hpp"
+#include <map>
+#include <vector>
 
 using namespace test;
 
@@ -38,8 +45,19 @@ testing::AssertionResult test_deserialize_integer_type()
     EXPECT_TRUE(test_deserialize(std::to_string(std::numeric_limits<T>::min()), std::numeric_limits<T>::min(), outcome));
     EXPECT_TRUE(test_deserialize(std::to_string(std::numeric_limits<T>::max()), std::numeric_limits<T>::max(), outcome));
 
+    // last digit of the smallest and largest value is never 9
+    std::string above_max = std::to_string(std::numeric_limits<T>::max());
+    ++above_max.back();
+    EXPECT_TRUE(test_no_deserialize<T>(above_max, outcome));
+    if constexpr (std::is_signed_v<T>) {
+        std::string below_min = std::to_string(std::numeric_limits<T>::min());
+        ++below_min.back();
+        EXPECT_TRUE(test_no_deserialize<T>(below_min, outcome));
+    }
+
     EXPECT_TRUE(test_no_deserialize<T>("1.0", outcome));
     EXPECT_TRUE(test_no_deserialize<T>("-1.0", outcome));
+    EXPECT_TRUE(test_no_deserialize<T>("1e2", outcome));
     EXPECT_TRUE(test_no_deserialize<T>("true", outcome));
     EXPECT_TRUE(test_no_deserialize<T>("\"string\"", outcome));
     EXPECT_TRUE(test_no_deserialize<T>("[]", outcome));
@@ -106,3 +124,58 @@ TEST(Deserialization, NumericTypes)
     EXPECT_TRUE(test_deserialize_float_type<float>());
     EXPECT_TRUE(test_deserialize_float_type<double>());
 }
+
+TEST(Deserialization, Decimal)
+{
+    using persistence::decimal;
+    using persistence::parse;
+
+    EXPECT_TRUE(test_deserialize("0", decimal(0)));
+    EXPECT_TRUE(test_deserialize("-42", decimal(-42)));
+    EXPECT_TRUE(test_deserialize("19.99", decimal(1999, 2)));
+    EXPECT_TRUE(test_deserialize("19.90", decimal(199, 1)));
+    EXPECT_TRUE(test_deserialize("-0.005", decimal(-5, 3)));
+    EXPECT_TRUE(test_deserialize("1.5e3", decimal(1500)));
+    EXPECT_TRUE(test_deserialize("9223372036854775807", decimal(std::numeric_limits<std::int64_t>::max())));
+    EXPECT_TRUE(test_deserialize("-9223372036854775808", decimal(std::numeric_limits<std::int64_t>::min())));
+
+    // digits of the literal are kept, including trailing zeros
+    auto expect_literal = [](const std::string& str, std::int64_t coefficient, std::int32_t scale) {
+        decimal value = parse<decimal>(str);
+        EXPECT_EQ(value.coefficient, coefficient);
+        EXPECT_EQ(value.scale, scale);
+    };
+    expect_literal("19.90", 1990, 2);
+    expect_literal("0.00", 0, 2);
+    expect_literal("-0.1", -1, 1);
+    expect_literal("1.234567890123456789", 1234567890123456789, 18);
+    expect_literal("25E-12", 25, 12);
+    expect_literal("15e+3", 15, -3);
+    expect_literal(" 0.30 ", 30, 2);
+
+    // literals nested in objects and arrays, read back from the input in the default mode
+    auto prices = parse<std::map<std::string, decimal>>("{\"price\":19.99, \"tax\": 0.10}");
+    EXPECT_EQ(prices["price"].coefficient, 1999);
+    EXPECT_EQ(prices["tax"].coefficient, 10);
+    EXPECT_EQ(prices["tax"].scale, 2);
+    auto amounts = parse<std::vector<decimal>>("[0.5,-2.25 ,3]");
+    EXPECT_EQ(amounts, (std::vector<decimal> { decimal(5, 1), decimal(-225, 2), decimal(3) }));
+
+    EXPECT_TRUE(test_no_deserialize<decimal>("\"19.99\""));
+    EXPECT_TRUE(test_no_deserialize<decimal>("null"));
+    EXPECT_TRUE(test_no_deserialize<decimal>("[1]"));
+
+    // the JSON DOM keeps up to 15 significant digits exactly, parsing keeps all digits
+    EXPECT_TRUE(test_deserialize("123456789012.345", decimal(123456789012345, 3)));
+    decimal long_value = parse<decimal>("12345678901234.567");
+    EXPECT_EQ(long_value.coefficient, 12345678901234567);
+    EXPECT_EQ(long_value.scale, 3);
+    long_value = persistence::deserialize<decimal>("12345678901234.567");
+    EXPECT_EQ(long_value.coefficient, 12345678901234566);
+    EXPECT_EQ(long_value.scale, 3);
+
+    // more significant digits than the coefficient holds
+    decimal value;
+    EXPECT_FALSE(parse("9223372036854775808", value));
+    EXPECT_FALSE(parse("12345678901234567890.1", value));
+}
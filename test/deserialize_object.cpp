@@ -1,8 +1,10 @@
 #include <gtest/gtest.h>
+#include "persistence/parse_map.hpp"
 #include "persistence/parse_object.hpp"
 #include "persistence/parse_pointer.hpp"
 #include "persistence/parse_fundamental.hpp"
 #include "persistence/parse_string.hpp"
+#include "persistence/parse_variant.hpp"
 #include "persistence/parse_vector.hpp"
 #include "persistence/parse.hpp"
 #include "persistence/deserialize_object.hpp"
@@ -35,6 +37,12 @@ TEST(Deserialization, Object)
     EXPECT_TRUE(test_deserialize("{\"value\":\"base\",\"member\":\"derived\"}", TestDerived("base", "derived")));
     EXPECT_TRUE(test_deserialize("{\"first\":1,\"second\":2}", TestPair()));
 
+    // required members must be present
+    EXPECT_TRUE(test_no_deserialize<TestValue>("{}"));
+    EXPECT_TRUE(test_no_deserialize<TestPair>("{\"first\":1}"));
+    EXPECT_TRUE(test_no_deserialize<TestDerived>("{\"member\":\"derived\"}"));
+    EXPECT_TRUE(test_no_deserialize<TestDataTransferObject>("{\"bool_value\":true,\"int_value\":42}"));
+
     const char* json =
         "{"
         "\"bool_value\":true,"
@@ -71,6 +79,42 @@ TEST(Deserialization, Optional)
     EXPECT_TRUE(test_deserialize("{\"optional_value\": 42}", TestOptionalObjectMember(42)));
 }
 
+TEST(Deserialization, EscapedMemberNames)
+{
+    TestEscapedMemberNames obj;
+    obj.quote = 1;
+    obj.control = 2;
+    EXPECT_TRUE(test_deserialize("{\"\\\"quote\\\" \\\\ back\":1,\"tab\\tline\\n\\u0001\":2}", obj));
+}
+
+TEST(Deserialization, MemberFailure)
+{
+    // a failing member makes the object fail, and later members are still deserialized
+    const std::string pair_json = "{\"first\":\"x\",\"second\":5}";
+    rapidjson::Document doc = persistence::string_to_document(pair_json);
+    TestPair pair;
+    EXPECT_FALSE(persistence::deserialize(doc, pair));
+    EXPECT_EQ(pair.second, 5);
+
+    const std::string optional_json = "{\"first\":\"x\",\"\\\"quote\\\" \\\\ back\":1,\"tab\\tline\\n\\u0001\":2}";
+    doc = persistence::string_to_document(optional_json);
+    TestEscapedMemberNames obj;
+    EXPECT_FALSE(persistence::deserialize(doc, obj));
+    EXPECT_EQ(obj.quote, 1);
+    EXPECT_EQ(obj.control, 2);
+}
+
+TEST(Deserialization, NumberFormat)
+{
+    // number formats apply when writing only
+    TestNumberFormat obj;
+    obj.price = 19.989999999;
+    obj.reading = 1234.5678f;
+    obj.discount = 0.04;
+    obj.exact = 0.125;
+    EXPECT_TRUE(test_deserialize("{\"price\": 19.989999999, \"reading\": 1234.5678, \"discount\": 0.04, \"exact\": 0.125}", obj));
+}
+
 TEST(Deserialization, BackReferenceArray)
 {
     std::string json =
@@ -81,10 +125,21 @@ TEST(Deserialization, BackReferenceArray)
             "{\"$ref\":\"/values/1\"}"
         "]}";
 
-    auto val = persistence::deserialize<TestBackReferenceArray>(std::move(json));
+    auto val = persistence::deserialize<TestBackReferenceArray>(json);
     EXPECT_NE(val.values[0], val.values[1]);
     EXPECT_EQ(val.values[1], val.values[2]);
     EXPECT_EQ(val.values[2], val.values[3]);
+
+    auto res = persistence::parse<TestBackReferenceArray>(json);
+    ASSERT_EQ(res.values.size(), 4u);
+    EXPECT_NE(res.values[0], res.values[1]);
+    EXPECT_EQ(res.values[1], res.values[2]);
+    EXPECT_EQ(res.values[2], res.values[3]);
+    EXPECT_EQ(*res.values[0], TestValue("string"));
+
+    TestBackReferenceArray unresolved;
+    EXPECT_FALSE(persistence::parse("{\"values\":[{\"$ref\":\"/values/0\"}]}", unresolved));
+    EXPECT_FALSE(persistence::parse("{\"values\":[{\"value\":\"string\"},{\"$ref\":\"/values/0\",\"value\":\"string\"}]}", unresolved));
 }
 
 TEST(Deserialization, BackReferenceObject)
@@ -102,6 +157,79 @@ TEST(Deserialization, BackReferenceObject)
     EXPECT_EQ(obj.outer, obj.inner[0]);
     EXPECT_EQ(obj.outer, obj.inner[1]);
 
-    // back-references are not supported by the parser
-    EXPECT_THROW(persistence::parse<TestBackReferenceObject>(json), persistence::JsonParseError);
+    auto res = persistence::parse<TestBackReferenceObject>(json);
+    ASSERT_EQ(res.inner.size(), 2u);
+    EXPECT_EQ(res.outer, res.inner[0]);
+    EXPECT_EQ(res.outer, res.inner[1]);
+}
+
+TEST(Deserialization, BackReferenceTracking)
+{
+    using persistence::may_have_back_references_v;
+
+    // locations are tracked only for types that may hold shared objects
+    static_assert(may_have_back_references_v<TestBackReferenceArray>);
+    static_assert(may_have_back_references_v<TestBackReferenceObject>);
+    static_assert(may_have_back_references_v<TestBackReferenceTree>);
+    static_assert(may_have_back_references_v<std::vector<std::optional<std::shared_ptr<TestValue>>>>);
+    static_assert(!may_have_back_references_v<TestDataTransferObject>);
+    static_assert(!may_have_back_references_v<std::vector<std::unique_ptr<TestValue>>>);
+    static_assert(!may_have_back_references_v<std::shared_ptr<int>>);
+
+    std::string json =
+        "{"
+            "\"children\": ["
+                "{\"children\": [], \"value\": {\"value\": \"string\"}},"
+                "{\"children\": [], \"value\": {\"$ref\": \"/children/0/value\"}}"
+            "],"
+            "\"value\": {\"$ref\": \"/children/0/value\"}"
+        "}";
+    auto tree = persistence::parse<TestBackReferenceTree>(json);
+    ASSERT_EQ(tree.children.size(), 2u);
+    EXPECT_EQ(*tree.children[0].value, TestValue("string"));
+    EXPECT_EQ(tree.children[1].value, tree.children[0].value);
+    EXPECT_EQ(tree.value, tree.children[0].value);
+}
+
+TEST(Deserialization, BackReferenceVariant)
+{
+    // the map alternative fails on the nested objects, and tokens are replayed to the next alternative at the location
+    // they were read from
+    std::string json =
+        "{"
+            "\"items\": ["
+                "{\"outer\": {\"value\": \"first\"}, \"inner\": []},"
+                "{\"outer\": {\"value\": \"second\"}, \"inner\": [{\"$ref\": \"/items/1/outer\"}, {\"$ref\": \"/items/0/outer\"}]}"
+            "],"
+            "\"last\": {\"$ref\": \"/items/1/outer\"}"
+        "}";
+    auto res = persistence::parse<TestBackReferenceVariant>(json);
+    ASSERT_EQ(res.items.size(), 2u);
+    ASSERT_EQ(res.items[0].index(), 1u);
+    ASSERT_EQ(res.items[1].index(), 1u);
+    const auto& first = std::get<1>(res.items[0]);
+    const auto& second = std::get<1>(res.items[1]);
+    EXPECT_EQ(*first.outer, TestValue("first"));
+    EXPECT_EQ(*second.outer, TestValue("second"));
+    ASSERT_EQ(second.inner.size(), 2u);
+    EXPECT_EQ(second.inner[0], second.outer);
+    EXPECT_EQ(second.inner[1], first.outer);
+    EXPECT_EQ(res.last, second.outer);
+
+    // replayed objects are not recorded at the location of the enclosing value
+    TestBackReferenceVariant unresolved;
+    EXPECT_FALSE(persistence::parse("{\"items\": [{\"outer\": {\"value\": \"first\"}, \"inner\": []}], \"last\": {\"$ref\": \"/items/0\"}}", unresolved));
+}
+
+TEST(Deserialization, BackReferenceDiscardedAlternative)
+{
+    // the first alternative records the shared object before it fails on the next member; the back-reference
+    // resolves to the object of the alternative that matches
+    std::string json = "{\"item\": {\"shared\": {\"value\": \"string\"}, \"number\": \"text\"}, \"last\": {\"$ref\": \"/item/shared\"}}";
+    auto res = persistence::parse<TestBackReferenceAlternatives>(json);
+    ASSERT_EQ(res.item.index(), 1u);
+    const auto& item = std::get<1>(res.item);
+    EXPECT_EQ(*item.shared, TestValue("string"));
+    EXPECT_EQ(item.number, "text");
+    EXPECT_EQ(res.last, item.shared);
 }
@@ -1,10 +1,15 @@
 #include <gtest/gtest.h>
+#include "persistence/parse_map.hpp"
 #include "persistence/parse_string.hpp"
+#include "persistence/parse_vector.hpp"
 #include "persistence/parse.hpp"
 #include "persistence/deserialize_string.hpp"
+#include "persistence/deserialize_vector.hpp"
 #include "persistence/deserialize.hpp"
 #include "string.hpp"
 #include "test_deserialize.hpp"
+#include <map>
+#include <vector>
 
 using namespace test;
 
@@ -24,3 +29,36 @@ TEST(Deserialization, StringTypes)
     EXPECT_TRUE(test_no_deserialize<std::string>("[]"));
     EXPECT_TRUE(test_no_deserialize<std::string>("{}"));
 }
+
+TEST(Deserialization, Utf8Validation)
+{
+    using persistence::JsonParseError;
+    constexpr unsigned validate = rapidjson::kParseValidateEncodingFlag;
+
+    const std::string valid = "[\"árvíztűrő tükörfúrógép\", \"\xF0\x9F\x98\x80\"]";
+    const std::string invalid = "[\"valid\", \"overlong \xC0\xAF in a string value\"]";
+    const std::vector<std::string> expected = { "árvíztűrő tükörfúrógép", "\xF0\x9F\x98\x80" };
+
+    // ill-formed UTF-8 is accepted unless validation is requested
+    std::vector<std::string> value;
+    EXPECT_TRUE(persistence::parse(invalid, value));
+
+    EXPECT_EQ((persistence::parse<std::vector<std::string>, validate>(valid)), expected);
+    EXPECT_FALSE((persistence::parse<std::vector<std::string>, validate>(invalid, value)));
+    try {
+        persistence::parse<std::vector<std::string>, validate>(invalid);
+        FAIL();
+    } catch (JsonParseError& e) {
+        EXPECT_EQ(e.offset, invalid.find('\xC0'));
+    }
+
+    EXPECT_EQ((persistence::deserialize<std::vector<std::string>, validate>(valid)), expected);
+    EXPECT_FALSE((persistence::deserialize<std::vector<std::string>, validate>(invalid, value)));
+    EXPECT_FALSE((persistence::deserialize<std::vector<std::string>, validate>(std::string(invalid), value)));
+    EXPECT_THROW((persistence::deserialize<std::vector<std::string>, validate>(invalid)), JsonParseError);
+    EXPECT_THROW((persistence::deserialize<std::vector<std::string>, validate>(std::string(invalid))), JsonParseError);
+
+    // object keys are validated too
+    std::map<std::string, int> map;
+    EXPECT_FALSE((persistence::parse<std::map<std::string, int>, validate>("{\"\xED\xA0\x80\": 1}", map)));
+}
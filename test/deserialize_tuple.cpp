@@ -19,6 +19,10 @@ TEST(Deserialization, Array)
 {
     EXPECT_TRUE(test_deserialize("[]", std::array<int, 0> {}));
     EXPECT_TRUE(test_deserialize("[1, 2, 3]", std::array<int, 3> { 1, 2, 3 }));
+    EXPECT_TRUE(test_deserialize("[ -1 ,2,\n 3 , 4 ]", std::array<long long, 4> { -1, 2, 3, 4 }));
+    EXPECT_TRUE(test_deserialize("[18446744073709551615, 0]", std::array<unsigned long long, 2> { 18446744073709551615ull, 0 }));
+    EXPECT_TRUE(test_deserialize("[1.5, -2, 3e2, 0.1]", std::array<double, 4> { 1.5, -2.0, 300.0, 0.1 }));
+    EXPECT_TRUE(test_deserialize("[0.25, 2]", std::array<float, 2> { 0.25f, 2.0f }));
     EXPECT_TRUE(test_deserialize("[\"one\", \"two\"]", std::array<std::string, 2> { "one", "two" }));
     EXPECT_TRUE(test_deserialize(
         "[{\"value\":\"a\"},{\"value\":\"b\"},{\"value\":\"c\"}]",
@@ -30,6 +34,12 @@ TEST(Deserialization, Array)
     EXPECT_TRUE(test_no_deserialize<int_array_type>("[]"));
     EXPECT_TRUE(test_no_deserialize<int_array_type>("[1]"));
     EXPECT_TRUE(test_no_deserialize<int_array_type>("[1,2,3]"));
+    EXPECT_TRUE(test_no_deserialize<int_array_type>("[1, 2, 3, 4]"));
+    EXPECT_TRUE(test_no_deserialize<int_array_type>("[1, 2.5]"));
+    EXPECT_TRUE(test_no_deserialize<int_array_type>("[1, 4294967296]"));
+    EXPECT_TRUE(test_no_deserialize<int_array_type>("[1, \"two\"]"));
+    EXPECT_TRUE(test_no_deserialize<int_array_type>("[1, 2"));
+    EXPECT_TRUE(test_no_deserialize<std::array<int, 0>>("[1]"));
     EXPECT_TRUE(test_no_deserialize<string_array_type>("[1,2]"));
     EXPECT_TRUE(test_no_deserialize<int_array_type>("[\"one\",\"two\"]"));
     EXPECT_TRUE(test_no_deserialize<int_array_type>("true"));
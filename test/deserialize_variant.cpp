@@ -3,8 +3,16 @@
 #include "persistence/deserialize_fundamental.hpp"
 #include "persistence/deserialize_object.hpp"
 #include "persistence/deserialize_string.hpp"
+#include "persistence/deserialize_vector.hpp"
 #include "persistence/deserialize.hpp"
+#include "persistence/parse_variant.hpp"
+#include "persistence/parse_fundamental.hpp"
+#include "persistence/parse_object.hpp"
+#include "persistence/parse_string.hpp"
+#include "persistence/parse_vector.hpp"
+#include "persistence/parse.hpp"
 #include "example_classes.hpp"
+#include "example_variant_traits.hpp"
 #include "test_deserialize.hpp"
 
 using namespace test;
@@ -32,4 +40,65 @@ TEST(Deserialization, Variant)
     using complex_variant_type = std::variant<TestValue, TestNonCopyable>;
     EXPECT_EQ(deserialize<complex_variant_type>("{\"value\": \"string\"}"), complex_variant_type(TestValue("string")));
     EXPECT_EQ(deserialize<complex_variant_type>("{\"member\":{\"value\": \"string\"}}"), complex_variant_type(TestNonCopyable("string")));
+
+    EXPECT_TRUE(test_deserialize("\"value\"", simple_variant_type(std::string("value"))));
+    EXPECT_TRUE(test_deserialize("23", simple_variant_type(23)));
+    EXPECT_TRUE(test_no_deserialize<simple_variant_type>("null"));
+    EXPECT_TRUE(test_no_deserialize<simple_variant_type>("true"));
+    EXPECT_TRUE(test_no_deserialize<simple_variant_type>("4.5"));
+    EXPECT_TRUE(test_no_deserialize<simple_variant_type>("[23]"));
+    EXPECT_TRUE(test_no_deserialize<simple_variant_type>("{}"));
+
+    using numeric_variant_type = std::variant<int, double>;
+    EXPECT_TRUE(test_deserialize("23", numeric_variant_type(23)));
+    EXPECT_TRUE(test_deserialize("4.5", numeric_variant_type(4.5)));
+
+    EXPECT_TRUE(test_deserialize("\"value\"", mixed_variant_type(std::string("value"))));
+    EXPECT_TRUE(test_deserialize("{\"value\": \"string\"}", mixed_variant_type(TestValue("string"))));
+
+    EXPECT_TRUE(test_deserialize("{\"value\": \"string\"}", complex_variant_type(TestValue("string"))));
+    EXPECT_TRUE(test_no_deserialize<complex_variant_type>("{\"member\":{\"value\": 23}}"));
+    EXPECT_TRUE(test_no_deserialize<complex_variant_type>("{\"unknown\": \"string\"}"));
+
+    complex_variant_type value;
+    EXPECT_TRUE(persistence::parse("{\"member\":{\"value\": \"string\"}}", value));
+    EXPECT_EQ(value, complex_variant_type(TestNonCopyable("string")));
+
+    // an object without the required members of an earlier alternative matches a later alternative
+    using partial_variant_type = std::variant<TestDerived, TestValue>;
+    EXPECT_TRUE(test_deserialize("{\"value\": \"base\", \"member\": \"derived\"}", partial_variant_type(TestDerived("base", "derived"))));
+    EXPECT_TRUE(test_deserialize("{\"value\": \"string\"}", partial_variant_type(TestValue("string"))));
+    using default_variant_type = std::variant<TestValue, TestDefault>;
+    EXPECT_TRUE(test_deserialize("{}", default_variant_type(TestDefault())));
+    EXPECT_TRUE(test_no_deserialize<std::variant<TestValue, TestPair>>("{}"));
+
+    using vector_variant_type = std::vector<std::variant<int, std::string, TestValue>>;
+    vector_variant_type items;
+    items.emplace_back(1);
+    items.emplace_back(std::string("value"));
+    items.emplace_back(TestValue("string"));
+    EXPECT_TRUE(test_deserialize("[1, \"value\", {\"value\": \"string\"}]", items));
+    EXPECT_TRUE(test_no_deserialize<vector_variant_type>("[1, true]"));
+
+    using nested_variant_type = std::vector<complex_variant_type>;
+    nested_variant_type values;
+    values.emplace_back(TestValue("first"));
+    values.emplace_back(TestValue("second"));
+    EXPECT_TRUE(test_deserialize("[{\"value\": \"first\"}, {\"value\": \"second\"}]", values));
+
+    using vector_alternative_type = std::variant<std::vector<int>, std::vector<std::string>>;
+    EXPECT_TRUE(test_deserialize("[1, 2, 3]", vector_alternative_type(std::vector<int> { 1, 2, 3 })));
+    EXPECT_TRUE(test_deserialize("[\"a\", \"b\"]", vector_alternative_type(std::vector<std::string> { "a", "b" })));
+    EXPECT_TRUE(test_no_deserialize<vector_alternative_type>("[1, \"b\"]"));
+
+    using tagged_variant_type = std::variant<TestCircle, TestRectangle, TestLabel>;
+    EXPECT_TRUE(test_deserialize("{\"type\": \"circle\", \"radius\": 1.5}", tagged_variant_type(TestCircle(1.5))));
+    EXPECT_TRUE(test_deserialize("{\"type\": \"rectangle\", \"width\": 2, \"height\": 0.5}", tagged_variant_type(TestRectangle(2.0, 0.5))));
+    EXPECT_TRUE(test_deserialize("{\"type\": \"label\", \"text\": \"text\"}", tagged_variant_type(TestLabel("text"))));
+    EXPECT_TRUE(test_deserialize("{\"width\": 2, \"height\": 0.5, \"type\": \"rectangle\"}", tagged_variant_type(TestRectangle(2.0, 0.5))));
+    EXPECT_TRUE(test_no_deserialize<tagged_variant_type>("{\"radius\": 1.5}"));
+    EXPECT_TRUE(test_no_deserialize<tagged_variant_type>("{\"type\": \"triangle\"}"));
+    EXPECT_TRUE(test_no_deserialize<tagged_variant_type>("{\"type\": 1, \"radius\": 1.5}"));
+    EXPECT_TRUE(test_no_deserialize<tagged_variant_type>("{\"type\": \"circle\", \"text\": \"text\"}"));
+    EXPECT_TRUE(test_no_deserialize<tagged_variant_type>("[]"));
 }
@@ -1,13 +1,31 @@
 #include <gtest/gtest.h>
+#include "persistence/detail/float_formatter.hpp"
 #include "persistence/detail/numeric_traits.hpp"
+#include "persistence/detail/path_tree.hpp"
 #include "persistence/detail/perfect_hash.hpp"
 #include "persistence/detail/polymorphic_stack.hpp"
+#include "persistence/detail/references.hpp"
+#include "persistence/detail/string_input.hpp"
 #include "persistence/base64.hpp"
+#include "persistence/datetime.hpp"
+#include "persistence/dictionary.hpp"
+#include "persistence/enum_utility.hpp"
+#include "persistence/number.hpp"
 #include "persistence/object_members.hpp"
 #include "persistence/object_reflection.hpp"
+#include "persistence/utf8.hpp"
 #include "example_classes.hpp"
+#include "example_numerous_enum.hpp"
+#include "example_enum_traits.hpp"
 #include "capture.hpp"
 #include "measure.hpp"
+#include "random.hpp"
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <rapidjson/reader.h>
 
 using namespace persistence;
 using namespace test;
@@ -240,6 +258,217 @@ TEST(Utility, Base64)
     EXPECT_FALSE(test_base64_decode("OOOO.AAA"));
 }
 
+/** Encodes bytes one bit at a time, as a reference for optimized encoders. */
+std::string base64_reference(const byte_vector& vec)
+{
+    constexpr std::string_view alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    unsigned value = 0;
+    int bits = 0;
+    for (std::byte b : vec) {
+        value = (value << 8) | std::to_integer<unsigned>(b);
+        bits += 8;
+        while (bits >= 6) {
+            bits -= 6;
+            out.push_back(alphabet[(value >> bits) & 0x3F]);
+        }
+    }
+    if (bits > 0) {
+        out.push_back(alphabet[(value << (6 - bits)) & 0x3F]);
+    }
+    while (out.size() % 4 != 0) {
+        out.push_back('=');
+    }
+    return out;
+}
+
+TEST(Utility, Base64Vectorized)
+{
+    std::mt19937_64 engine;
+    for (std::size_t size = 0; size < 300; ++size) {
+        byte_vector vec;
+        for (std::size_t k = 0; k < size; ++k) {
+            vec.push_back(std::byte(engine() % 256));
+        }
+        const std::string ref = base64_reference(vec);
+
+        std::string enc;
+        EXPECT_TRUE(base64_encode(vec, enc));
+        EXPECT_EQ(enc, ref);
+        byte_vector dec;
+        EXPECT_TRUE(base64_decode(enc, dec));
+        EXPECT_EQ(dec, vec);
+
+        // invalid characters anywhere in the string, including positions processed with vector instructions
+        for (std::size_t k = 0; k < enc.size(); k += 7) {
+            for (char c : { '.', '=', '\0', '\x80', '\xFF' }) {
+                std::string invalid = enc;
+                invalid[k] = c;
+                if (c == '=' && k + 2 >= invalid.size()) {
+                    continue;  // may form valid padding
+                }
+                EXPECT_FALSE(base64_decode(invalid, dec)) << "invalid character at position " << k;
+            }
+        }
+    }
+
+#if defined(PERSISTENCE_X86_SIMD)
+    // exercise each kernel supported by the processor, regardless of which one is selected at run time
+    byte_vector vec;
+    for (std::size_t k = 0; k < 1000; ++k) {
+        vec.push_back(std::byte(engine() % 256));
+    }
+    const std::string ref = base64_reference(vec);
+    const detail::simd_level level = detail::supported_simd_level();
+    if (level >= detail::simd_level::ssse3) {
+        std::string enc(ref.size(), '\0');
+        const std::size_t consumed = detail::base64_encode_ssse3(vec.data(), vec.size(), enc.data());
+        EXPECT_GT(consumed, 900u);
+        EXPECT_EQ(enc.substr(0, consumed / 3 * 4), ref.substr(0, consumed / 3 * 4));
+
+        byte_vector dec(ref.size() / 4 * 3);
+        const std::size_t decoded = detail::base64_decode_ssse3(ref.data(), ref.size(), dec.data());
+        EXPECT_GT(decoded, 1200u);
+        EXPECT_TRUE(std::equal(dec.begin(), dec.begin() + decoded / 4 * 3, vec.begin()));
+    }
+    if (level >= detail::simd_level::avx2) {
+        std::string enc(ref.size(), '\0');
+        const std::size_t consumed = detail::base64_encode_avx2(vec.data(), vec.size(), enc.data());
+        EXPECT_GT(consumed, 900u);
+        EXPECT_EQ(enc.substr(0, consumed / 3 * 4), ref.substr(0, consumed / 3 * 4));
+
+        byte_vector dec(ref.size() / 4 * 3);
+        const std::size_t decoded = detail::base64_decode_avx2(ref.data(), ref.size(), dec.data());
+        EXPECT_GT(decoded, 1200u);
+        EXPECT_TRUE(std::equal(dec.begin(), dec.begin() + decoded / 4 * 3, vec.begin()));
+    }
+#endif
+}
+
+/** Validates UTF-8 with each implementation supported by the processor, and checks that they agree. */
+bool utf8_validate_all(const std::string& str)
+{
+    const bool valid = detail::utf8_error_offset(str.data(), str.size()) == str.size();
+#if defined(PERSISTENCE_X86_SIMD)
+    const detail::simd_level level = detail::supported_simd_level();
+    if (level >= detail::simd_level::ssse3 && detail::utf8_validate_ssse3(str.data(), str.size()) != valid) {
+        ADD_FAILURE() << "SSSE3 validation disagrees on a string of " << str.size() << " bytes";
+    }
+    if (level >= detail::simd_level::avx2 && detail::utf8_validate_avx2(str.data(), str.size()) != valid) {
+        ADD_FAILURE() << "AVX2 validation disagrees on a string of " << str.size() << " bytes";
+    }
+#endif
+    return valid;
+}
+
+TEST(Utility, Utf8)
+{
+    const std::vector<std::string> valid = {
+        "", "ASCII", "árvíztűrő tükörfúrógép", "\xE2\x82\xAC", "\xF0\x9F\x98\x80",
+        "\xC2\x80", "\xDF\xBF", "\xE0\xA0\x80", "\xED\x9F\xBF", "\xEE\x80\x80", "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF"
+    };
+    const std::vector<std::string> invalid = {
+        "\x80", "\xBF", "\xC0\x80", "\xC1\xBF", "\xE0\x9F\xBF", "\xED\xA0\x80", "\xED\xBF\xBF",
+        "\xF0\x8F\xBF\xBF", "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xF8", "\xFF",
+        "\xC3", "\xE2\x82", "\xF0\x9F\x98", "\xC3\xA9\xA9", "\xE2\x82\xAC\x80", "\xC3" "A", "\xE2" "A\xAC"
+    };
+
+    // sequences at every position relative to the boundaries of vector blocks, and at the end of the input
+    for (std::size_t offset = 0; offset < 70; ++offset) {
+        for (std::size_t length : { offset + 4, std::size_t(100) }) {
+            for (const std::string& sequence : valid) {
+                std::string str(length, 'x');
+                str.replace(offset, sequence.size(), sequence);
+                EXPECT_TRUE(utf8_validate_all(str)) << "offset " << offset;
+                EXPECT_TRUE(is_valid_utf8(str));
+            }
+            for (const std::string& sequence : invalid) {
+                std::string str(length, 'x');
+                str.replace(offset, sequence.size(), sequence);
+                EXPECT_FALSE(utf8_validate_all(str)) << "offset " << offset;
+                EXPECT_FALSE(is_valid_utf8(str));
+                const std::size_t error_offset = detail::utf8_error_offset(str.data(), str.size());
+                EXPECT_GE(error_offset, offset);
+                EXPECT_LT(error_offset, offset + sequence.size());
+            }
+        }
+    }
+
+    // all two-byte sequences, and three- and four-byte sequences with significant trailing bytes, across block boundaries
+    const unsigned char trailing[] = { 0x7F, 0x80, 0x8F, 0x90, 0xA0, 0xBF, 0xC0 };
+    {
+        const std::size_t offset = 31;
+        std::string str(64, 'x');
+        for (unsigned a = 0x80; a <= 0xFF; ++a) {
+            for (unsigned b = 0; b <= 0xFF; ++b) {
+                str[offset] = static_cast<char>(a);
+                str[offset + 1] = static_cast<char>(b);
+                str[offset + 2] = 'x';
+                str[offset + 3] = 'x';
+                utf8_validate_all(str);
+                for (unsigned char c : trailing) {
+                    str[offset + 2] = static_cast<char>(c);
+                    utf8_validate_all(str);
+                    for (unsigned char d : trailing) {
+                        str[offset + 3] = static_cast<char>(d);
+                        utf8_validate_all(str);
+                    }
+                }
+            }
+        }
+    }
+
+    // text with a mix of one- to four-byte characters
+    std::mt19937_64 engine;
+    const char* characters[] = { "a", "\xC3\xA1", "\xE2\x82\xAC", "\xF0\x9F\x98\x80" };
+    for (std::size_t size = 0; size < 300; ++size) {
+        std::string str;
+        while (str.size() < size) {
+            str += characters[engine() % 4];
+        }
+        EXPECT_TRUE(utf8_validate_all(str));
+
+        // truncate the text, which might cut a character short
+        const std::size_t cut = str.empty() ? 0 : static_cast<std::size_t>(engine() % str.size());
+        const std::string prefix = str.substr(0, cut);
+        utf8_validate_all(prefix);
+    }
+}
+
+/** Records what is left of the input whenever the reader delivers a number or a string. */
+struct InputPositionRecorder
+{
+    const persistence::detail::StringInput& input;
+    std::vector<std::string> rest;
+
+    bool record() { rest.emplace_back(input.position()); return true; }
+
+    bool Null() { return true; }
+    bool Bool(bool) { return true; }
+    bool Int(int) { return record(); }
+    bool Uint(unsigned) { return record(); }
+    bool Int64(std::int64_t) { return record(); }
+    bool Uint64(std::uint64_t) { return record(); }
+    bool Double(double) { return record(); }
+    bool RawNumber(const char*, rapidjson::SizeType, bool) { return record(); }
+    bool String(const char*, rapidjson::SizeType, bool) { return record(); }
+    bool StartObject() { return true; }
+    bool Key(const char*, rapidjson::SizeType, bool) { return true; }
+    bool EndObject(rapidjson::SizeType) { return true; }
+    bool StartArray() { return true; }
+    bool EndArray(rapidjson::SizeType) { return true; }
+};
+
+TEST(Utility, StringInput)
+{
+    // the reader works on the input in place, and is past the token when the token is delivered
+    detail::StringInput input("[1.5, 23, \"abc\"]");
+    InputPositionRecorder recorder{ input, {} };
+    rapidjson::Reader reader;
+    EXPECT_FALSE(reader.Parse(input, recorder).IsError());
+    EXPECT_EQ(recorder.rest, (std::vector<std::string> { ", 23, \"abc\"]", ", \"abc\"]", "]" }));
+}
+
 TEST(Utility, PerfectHash)
 {
     constexpr std::string_view items_single[] = { "a" };
@@ -257,6 +486,411 @@ TEST(Utility, PerfectHash)
     constexpr auto map_conflict = PerfectHash(items_conflict);
     EXPECT_EQ(map_conflict.index("creamwove"), 1u);
     EXPECT_EQ(map_conflict.index("quists"), 2u);
+
+    // words that agree in the low bits of every character share a slot for every seed unless high bits are mixed in
+    constexpr std::string_view items_low_bits[] = { "created", "updated", "expires", "logged" };
+    constexpr auto map_low_bits = PerfectHash(items_low_bits);
+    for (std::size_t k = 0; k < std::size(items_low_bits); ++k) {
+        EXPECT_EQ(map_low_bits.index(items_low_bits[k]), k);
+    }
+}
+
+TEST(Utility, Hash)
+{
+    // the seed search of a perfect hash relies on some seed sending each key into a distinct slot of a small table
+    const std::string_view keys[] = { "created", "updated", "expires", "logged" };
+    bool scattered = false;
+    for (detail::hash_t seed = 1; seed <= 64 && !scattered; ++seed) {
+        bool slots[4] = {};
+        scattered = true;
+        for (auto&& key : keys) {
+            bool& slot = slots[detail::hash(seed, key) % 4];
+            scattered = scattered && !slot;
+            slot = true;
+        }
+    }
+    EXPECT_TRUE(scattered);
+    EXPECT_NE(detail::hash(0, "created"), detail::hash(0, "updated"));
+}
+
+namespace test
+{
+    enum class Signal : short { Abort = -6, Interrupt = 2, Kill = 9, Stop = 19, Terminate = 15 };
+
+    inline constexpr auto signal_converter = make_enum_converter({
+        make_enum(Signal::Terminate, "SIGTERM"),
+        make_enum(Signal::Kill, "SIGKILL"),
+        make_enum(Signal::Abort, "SIGABRT"),
+        make_enum(Signal::Interrupt, "SIGINT"),
+        make_enum(Signal::Stop, "SIGSTOP"),
+        make_enum(Signal::Abort, "SIGIOT")
+    });
+
+    enum class Code : unsigned {};
+
+#define TEST_NUMEROUS_ITEM(e) make_enum(Numerous::e, #e),
+    inline constexpr auto numerous_converter = make_enum_converter({ TEST_FOR_EACH_300(TEST_NUMEROUS_ITEM) });
+}
+
+TEST(Utility, EnumConverter)
+{
+    // consecutive values, lookup tables built at compile time
+    constexpr auto& esper = enum_traits<Esper>::converter;
+    static_assert(esper.to_string(Esper::Tri) == "Tri");
+    static_assert(esper.to_string(static_cast<Esper>(10)).empty());
+    Esper esper_value = Esper::Unu;
+    EXPECT_TRUE(esper.from_string("Naux", esper_value));
+    EXPECT_EQ(esper_value, Esper::Naux);
+    EXPECT_FALSE(esper.from_string("Nau", esper_value));
+    EXPECT_FALSE(esper.from_string("", esper_value));
+    EXPECT_EQ(esper_value, Esper::Naux);
+
+    // sparse and negative values, and a value with an alias
+    EXPECT_EQ(signal_converter.to_string(Signal::Abort), "SIGABRT");
+    EXPECT_EQ(signal_converter.to_string(Signal::Interrupt), "SIGINT");
+    EXPECT_EQ(signal_converter.to_string(Signal::Stop), "SIGSTOP");
+    EXPECT_TRUE(signal_converter.to_string(static_cast<Signal>(0)).empty());
+    EXPECT_TRUE(signal_converter.to_string(static_cast<Signal>(20)).empty());
+    EXPECT_TRUE(signal_converter.to_string(static_cast<Signal>(-7)).empty());
+    Signal signal_value = Signal::Kill;
+    EXPECT_TRUE(signal_converter.from_string("SIGIOT", signal_value));
+    EXPECT_EQ(signal_value, Signal::Abort);
+    EXPECT_TRUE(signal_converter.from_string("SIGTERM", signal_value));
+    EXPECT_EQ(signal_value, Signal::Terminate);
+    EXPECT_FALSE(signal_converter.from_string("SIGHUP", signal_value));
+
+    // many names, built at compile time
+    static_assert(numerous_converter.to_string(Numerous::b42) == "b42");
+    for (std::size_t k = 0; k < 300; ++k) {
+        Numerous numerous;
+        ASSERT_TRUE(numerous_converter.from_string(numerous_name(k), numerous));
+        EXPECT_EQ(numerous, static_cast<Numerous>(k));
+        EXPECT_EQ(numerous_converter.to_string(static_cast<Numerous>(k)), numerous_name(k));
+    }
+    Numerous numerous = Numerous::a00;
+    EXPECT_FALSE(numerous_converter.from_string("d00", numerous));
+    EXPECT_FALSE(numerous_converter.from_string("a0", numerous));
+    EXPECT_TRUE(numerous_converter.to_string(static_cast<Numerous>(300)).empty());
+
+    // many names, built at run time
+    std::vector<std::string> names;
+    std::array<std::pair<Code, std::string_view>, 1000> items;
+    for (std::size_t k = 0; k < items.size(); ++k) {
+        names.push_back("code_" + std::to_string(k * 7));
+    }
+    for (std::size_t k = 0; k < items.size(); ++k) {
+        items[k] = make_enum(static_cast<Code>(k * 7), names[k]);
+    }
+    const auto codes = make_enum_converter(items);
+    for (std::size_t k = 0; k < items.size(); ++k) {
+        Code code;
+        ASSERT_TRUE(codes.from_string(names[k], code));
+        EXPECT_EQ(code, static_cast<Code>(k * 7));
+        EXPECT_EQ(codes.to_string(static_cast<Code>(k * 7)), names[k]);
+        EXPECT_TRUE(codes.to_string(static_cast<Code>(k * 7 + 1)).empty());
+    }
+
+    // names must be distinct
+    items[1].second = items[0].second;
+    EXPECT_THROW(make_enum_converter(items), std::invalid_argument);
+
+    // an enumeration with no values
+    constexpr auto none = make_enum_converter(std::array<std::pair<Code, std::string_view>, 0>{});
+    Code code;
+    EXPECT_FALSE(none.from_string("first", code));
+    EXPECT_TRUE(none.to_string(static_cast<Code>(0)).empty());
+}
+
+TEST(Utility, FlatMap)
+{
+    string_flat_map<int> map = { { "c", 3 }, { "a", 1 }, { "b", 2 }, { "a", 4 } };
+    ASSERT_EQ(map.size(), 3u);
+    EXPECT_EQ(map.begin()->first, "a");
+    EXPECT_EQ(map.at("a"), 4);
+    EXPECT_EQ(map.at(std::string_view("c")), 3);
+    EXPECT_TRUE(map.contains("b"));
+    EXPECT_FALSE(map.contains("d"));
+    EXPECT_FALSE(map.contains(""));
+    EXPECT_EQ(map.find("d"), map.end());
+    EXPECT_THROW(map.at("d"), std::out_of_range);
+
+    // insertion keeps the items sorted
+    map["bb"] = 5;
+    map["0"] = 6;
+    map["b"] = 7;
+    std::vector<std::string> keys;
+    for (auto&& [key, value] : map) {
+        keys.push_back(key);
+    }
+    EXPECT_EQ(keys, std::vector<std::string>({ "0", "a", "b", "bb", "c" }));
+    EXPECT_EQ(map.at("b"), 7);
+
+    // values can be modified through iterators but keys cannot
+    static_assert(std::is_same_v<decltype(map.begin()->first), const std::string&>);
+    static_assert(std::is_same_v<decltype((*map.begin()).first), const std::string&>);
+    map.find("a")->second = 8;
+    for (auto&& [key, value] : map) {
+        value += 10;
+    }
+    EXPECT_EQ(map.at("a"), 18);
+    EXPECT_EQ(map.at("0"), 16);
+
+    // replacing the contents
+    EXPECT_TRUE(map.assign({ { "y", 1 }, { "x", 2 }, { "y", 3 } }));
+    EXPECT_EQ(map, string_flat_map<int>({ { "x", 2 }, { "y", 3 } }));
+
+    flat_map<int, int, DuplicateKeys::reject> unique_map;
+    EXPECT_TRUE(unique_map.assign({ { 2, 1 }, { 1, 2 } }));
+    EXPECT_EQ(unique_map.size(), 2u);
+    EXPECT_FALSE(unique_map.assign({ { 2, 1 }, { 1, 2 }, { 2, 3 } }));
+    EXPECT_TRUE(unique_map.empty());
+}
+
+TEST(Utility, PathTree)
+{
+    PathTree tree;
+    EXPECT_EQ(tree.str(PathTree::root), "/");
+
+    auto values = tree.add(PathTree::root, Segment("values"));
+    auto first = tree.add(values, Segment(0));
+    auto second = tree.add(values, Segment(1));
+    auto member = tree.add(second, Segment("value"));
+    EXPECT_EQ(tree.str(values), "/values");
+    EXPECT_EQ(tree.str(first), "/values/0");
+    EXPECT_EQ(tree.str(second), "/values/1");
+    EXPECT_EQ(tree.str(member), "/values/1/value");
+}
+
+TEST(Utility, ReferenceTable)
+{
+    std::vector<int> items(1000);
+
+    ReferenceTable<std::size_t> table;
+    EXPECT_EQ(table.get(&items[0]), nullptr);
+    for (std::size_t k = 0; k < items.size(); ++k) {
+        table.put(&items[k], k);
+    }
+    EXPECT_EQ(table.size(), items.size());
+
+    // first occurrence is retained
+    table.put(&items[0], 42);
+    EXPECT_EQ(table.size(), items.size());
+
+    for (std::size_t k = 0; k < items.size(); ++k) {
+        auto value = table.get(&items[k]);
+        ASSERT_NE(value, nullptr);
+        EXPECT_EQ(*value, k);
+    }
+
+    int other = 0;
+    EXPECT_EQ(table.get(&other), nullptr);
+
+    ReferenceTable<std::size_t> reserved;
+    reserved.reserve(items.size());
+    for (std::size_t k = 0; k < items.size(); ++k) {
+        reserved.put(&items[k], k);
+    }
+    EXPECT_EQ(reserved.size(), items.size());
+    EXPECT_EQ(*reserved.get(&items[items.size() - 1]), items.size() - 1);
+}
+
+TEST(Utility, FloatParser)
+{
+    auto parse_double = [](const std::string_view& str) {
+        double value = std::nan("");
+        return parse_number(str, value) ? std::optional<double>(value) : std::nullopt;
+    };
+    auto parse_float = [](const std::string_view& str) {
+        float value = std::nanf("");
+        return parse_number(str, value) ? std::optional<float>(value) : std::nullopt;
+    };
+
+    EXPECT_EQ(parse_double("0"), 0.0);
+    EXPECT_TRUE(std::signbit(*parse_double("-0")));
+    EXPECT_EQ(parse_double("1"), 1.0);
+    EXPECT_EQ(parse_double("-1.5"), -1.5);
+    EXPECT_EQ(parse_double("0.1"), 0.1);
+    EXPECT_EQ(parse_double("3.141592653589793"), 3.141592653589793);
+    EXPECT_EQ(parse_double("1e308"), 1e308);
+    EXPECT_EQ(parse_double("1.7976931348623157e308"), std::numeric_limits<double>::max());
+    EXPECT_EQ(parse_double("2.2250738585072014e-308"), std::numeric_limits<double>::min());
+    EXPECT_EQ(parse_double("4.9406564584124654e-324"), std::numeric_limits<double>::denorm_min());
+    EXPECT_EQ(parse_double("2.4703282292062327e-324"), 0.0);
+    EXPECT_EQ(parse_double("2.4703282292062328e-324"), std::numeric_limits<double>::denorm_min());
+    EXPECT_EQ(parse_double("1e-400"), 0.0);
+    EXPECT_EQ(parse_double("9007199254740993"), 9007199254740992.0);
+    EXPECT_EQ(parse_double("9007199254740993.0000000000000000001"), 9007199254740994.0);
+    EXPECT_EQ(parse_double("123456789012345678901234567890"), 123456789012345678901234567890.0);
+    EXPECT_EQ(parse_double("0.000000000000000000000000000000000000000000000000001"), 1e-51);
+    EXPECT_EQ(parse_double("1E+2"), 100.0);
+    EXPECT_EQ(parse_double(std::string_view("1.25e3xyz", 6)), 1250.0);
+    EXPECT_EQ(parse_double("1e400"), std::nullopt);
+    EXPECT_EQ(parse_double(""), std::nullopt);
+    EXPECT_EQ(parse_double("-"), std::nullopt);
+    EXPECT_EQ(parse_double("."), std::nullopt);
+    EXPECT_EQ(parse_double("1e"), std::nullopt);
+    EXPECT_EQ(parse_double("1e+"), std::nullopt);
+    EXPECT_EQ(parse_double("1.2.3"), std::nullopt);
+    EXPECT_EQ(parse_double(" 1"), std::nullopt);
+    EXPECT_EQ(parse_double("inf"), std::nullopt);
+    EXPECT_EQ(parse_double("nan"), std::nullopt);
+    EXPECT_EQ(parse_double("0x10"), std::nullopt);
+
+    EXPECT_EQ(parse_float("0.1"), 0.1f);
+    EXPECT_EQ(parse_float("3.4028234664e38"), std::numeric_limits<float>::max());
+    EXPECT_EQ(parse_float("1.17549435e-38"), std::numeric_limits<float>::min());
+    EXPECT_EQ(parse_float("1.40129846e-45"), std::numeric_limits<float>::denorm_min());
+    EXPECT_EQ(parse_float("16777217"), 16777216.0f);
+    EXPECT_EQ(parse_float("1e39"), std::nullopt);
+
+    // compare against the standard library on random bit patterns printed with various precisions
+    std::mt19937_64 engine;
+    char buf[64];
+    for (std::size_t k = 0; k < 100000; ++k) {
+        std::uint64_t bits = engine();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        if (!std::isfinite(value)) {
+            continue;
+        }
+
+        int precision = static_cast<int>(k % 17) + 1;
+        std::snprintf(buf, sizeof(buf), "%.*g", precision, value);
+        double reference = std::strtod(buf, nullptr);
+        EXPECT_EQ(parse_double(buf), std::isinf(reference) ? std::nullopt : std::optional<double>(reference)) << buf;
+
+        float single = static_cast<float>(value);
+        if (std::isfinite(single)) {
+            std::snprintf(buf, sizeof(buf), "%.*g", precision % 9 + 1, single);
+            float single_reference = std::strtof(buf, nullptr);
+            EXPECT_EQ(parse_float(buf), std::isinf(single_reference) ? std::nullopt : std::optional<float>(single_reference)) << buf;
+        }
+    }
+}
+
+TEST(Utility, FloatFormatter)
+{
+    auto format = [](auto value) {
+        char buf[detail::max_float_length];
+        char* end = detail::format_float(value, buf);
+        return std::string(buf, end);
+    };
+
+    EXPECT_EQ(format(0.0), "0.0");
+    EXPECT_EQ(format(-0.0), "-0.0");
+    EXPECT_EQ(format(1.0), "1.0");
+    EXPECT_EQ(format(-1.5), "-1.5");
+    EXPECT_EQ(format(0.1), "0.1");
+    EXPECT_EQ(format(100.0), "100.0");
+    EXPECT_EQ(format(123456.789), "123456.789");
+    EXPECT_EQ(format(0.001234), "0.001234");
+    EXPECT_EQ(format(1e-7), "1e-7");
+    EXPECT_EQ(format(1.5e-7), "1.5e-7");
+    EXPECT_EQ(format(1e21), "1e21");
+    EXPECT_EQ(format(1e20), "100000000000000000000.0");
+    EXPECT_EQ(format(1e23), "1e23");
+    EXPECT_EQ(format(9007199254740993.0), "9007199254740992.0");
+    EXPECT_EQ(format(std::numeric_limits<double>::max()), "1.7976931348623157e308");
+    EXPECT_EQ(format(std::numeric_limits<double>::min()), "2.2250738585072014e-308");
+    EXPECT_EQ(format(std::numeric_limits<double>::denorm_min()), "5e-324");
+
+    EXPECT_EQ(format(0.1f), "0.1");
+    EXPECT_EQ(format(0.3f), "0.3");
+    EXPECT_EQ(format(-2.75f), "-2.75");
+    EXPECT_EQ(format(16777216.0f), "16777216.0");
+    EXPECT_EQ(format(1e10f), "10000000000.0");
+    EXPECT_EQ(format(std::numeric_limits<float>::max()), "3.4028235e38");
+    EXPECT_EQ(format(std::numeric_limits<float>::min()), "1.1754944e-38");
+    EXPECT_EQ(format(std::numeric_limits<float>::denorm_min()), "1e-45");
+
+    // output reads back as the same value, and has as many digits as the shortest representation
+    auto shortest = [](auto value) {
+        detail::DecimalLiteral decimal;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        char buf[64];
+        char* end = std::to_chars(buf, buf + sizeof(buf), value, std::chars_format::scientific).ptr;
+        detail::parse_decimal(buf, end, decimal);
+        detail::remove_trailing_zeros(decimal);
+#else
+        decimal = detail::to_decimal(value);
+#endif
+        return std::make_pair(decimal.mantissa, decimal.exponent);
+    };
+
+    std::mt19937_64 engine;
+    for (std::size_t k = 0; k < 100000; ++k) {
+        std::uint64_t bits = engine();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        if (std::isfinite(value) && value != 0.0) {
+            std::string str = format(value);
+            EXPECT_EQ(std::strtod(str.c_str(), nullptr), value) << str;
+            detail::DecimalLiteral decimal = detail::to_decimal(value);
+            EXPECT_EQ(std::make_pair(decimal.mantissa, decimal.exponent), shortest(value)) << str;
+        }
+
+        std::uint32_t single_bits = static_cast<std::uint32_t>(bits);
+        float single;
+        std::memcpy(&single, &single_bits, sizeof(single));
+        if (std::isfinite(single) && single != 0.0f) {
+            std::string str = format(single);
+            EXPECT_EQ(std::strtof(str.c_str(), nullptr), single) << str;
+            detail::DecimalLiteral decimal = detail::to_decimal(single);
+            EXPECT_EQ(std::make_pair(decimal.mantissa, decimal.exponent), shortest(single)) << str;
+        }
+    }
+}
+
+TEST(Utility, CivilCalendar)
+{
+    static_assert(detail::days_from_civil(1970, 1, 1) == 0);
+    static_assert(detail::days_from_civil(2000, 3, 1) == 11017);
+    static_assert(detail::days_from_civil(1969, 12, 31) == -1);
+
+    // every day from year 0 to 9999 in turn, including leap days
+    std::int64_t days = detail::days_from_civil(0, 1, 1);
+    for (unsigned year = 0; year < 10000; ++year) {
+        for (unsigned month = 1; month <= 12; ++month) {
+            for (unsigned day = 1; is_valid_date(year, month, day); ++day) {
+                ASSERT_EQ(detail::days_from_civil(year, month, day), days);
+                detail::civil_date date = detail::civil_from_days(days);
+                ASSERT_EQ(date.year, year);
+                ASSERT_EQ(date.month, month);
+                ASSERT_EQ(date.day, day);
+                ++days;
+            }
+        }
+    }
+
+    // time points round-trip through ISO 8601 strings
+    std::mt19937_64 engine;
+    // the range of the clock may be narrower than years 0001 to 9999, e.g. with nanosecond precision
+    const std::int64_t min_seconds = std::chrono::ceil<std::chrono::seconds>(timestamp::duration::min()).count() + 1;
+    const std::int64_t max_seconds = std::chrono::floor<std::chrono::seconds>(timestamp::duration::max()).count() - 1;
+    std::uniform_int_distribution<std::int64_t> seconds(std::max<std::int64_t>(min_seconds, -62135596800), std::min<std::int64_t>(max_seconds, 253402300799));
+    std::uniform_int_distribution<unsigned> nanoseconds(0, 999999999);
+    for (std::size_t k = 0; k < 100000; ++k) {
+        timestamp value = timestamp(std::chrono::seconds(seconds(engine))) + std::chrono::nanoseconds(k % 2 == 0 ? 0 : nanoseconds(engine));
+        iso_datetime dt = to_iso_datetime(value);
+        timestamp result;
+        ASSERT_TRUE(parse_datetime(dt.text, dt.size(), result)) << dt.text;
+        EXPECT_EQ(result, value) << dt.text;
+    }
+
+    // string lengths
+    static_assert(iso_date::length() == 10);
+    static_assert(iso_datetime::length() == 20);
+    EXPECT_EQ(to_iso_date(make_datetime(1982, 10, 23, 1, 20, 40)).size(), iso_date::length());
+    EXPECT_EQ(to_iso_datetime(make_datetime(1982, 10, 23, 1, 20, 40)).size(), iso_datetime::length());
+    EXPECT_EQ(to_iso_datetime(make_datetime(1982, 10, 23, 1, 20, 40, 250000000)).size(), 24u);
+    EXPECT_STREQ(to_iso_datetime(make_datetime(1982, 10, 23, 1, 20, 40, 250000000)).text, "1982-10-23T01:20:40.250Z");
+
+    // years that need more than four digits
+    char text[11] = {};
+    EXPECT_TRUE(detail::format_iso_date(detail::civil_date{ 9999, 12, 31 }, text));
+    EXPECT_STREQ(text, "9999-12-31");
+    EXPECT_FALSE(detail::format_iso_date(detail::civil_date{ 10000, 1, 1 }, text));
+    EXPECT_FALSE(detail::format_iso_date(detail::civil_date{ -1, 12, 31 }, text));
 }
 
 #ifndef _DEBUG
@@ -276,4 +910,89 @@ TEST(Performance, Base64)
         base64_decode(enc, raw);
     });
 }
+
+TEST(Performance, Float)
+{
+    // coordinates with 7 decimal digits (centimeter accuracy), and shortest round-trip representations
+    std::mt19937_64 engine;
+    std::uniform_real_distribution<double> latitude(-90.0, 90.0);
+    std::uniform_real_distribution<double> longitude(-180.0, 180.0);
+    std::vector<std::string> coordinates;
+    std::vector<std::string> doubles;
+    char buf[64];
+    for (std::size_t k = 0; k < 2000000; ++k) {
+        std::snprintf(buf, sizeof(buf), "%.7f", latitude(engine));
+        coordinates.push_back(buf);
+        std::snprintf(buf, sizeof(buf), "%.7f", longitude(engine));
+        coordinates.push_back(buf);
+        std::snprintf(buf, sizeof(buf), "%.17g", longitude(engine));
+        doubles.push_back(buf);
+        doubles.push_back(buf);
+    }
+
+    double reference_sum = measure("parse coordinates with strtod", [&] {
+        double sum = 0.0;
+        for (auto&& str : coordinates) {
+            sum += std::strtod(str.c_str(), nullptr);
+        }
+        return sum;
+    });
+    double sum = measure("parse coordinates with parse_number", [&] {
+        double sum = 0.0;
+        for (auto&& str : coordinates) {
+            double value = 0.0;
+            parse_number(str, value);
+            sum += value;
+        }
+        return sum;
+    });
+    EXPECT_EQ(sum, reference_sum);
+
+    reference_sum = measure("parse 17-digit doubles with strtod", [&] {
+        double sum = 0.0;
+        for (auto&& str : doubles) {
+            sum += std::strtod(str.c_str(), nullptr);
+        }
+        return sum;
+    });
+    sum = measure("parse 17-digit doubles with parse_number", [&] {
+        double sum = 0.0;
+        for (auto&& str : doubles) {
+            double value = 0.0;
+            parse_number(str, value);
+            sum += value;
+        }
+        return sum;
+    });
+    EXPECT_EQ(sum, reference_sum);
+}
+
+TEST(Performance, Integer)
+{
+    std::mt19937_64 engine;
+    std::vector<std::string> integers;
+    for (std::size_t k = 0; k < 4000000; ++k) {
+        integers.push_back(std::to_string(random_integer<int>(engine)));
+    }
+
+    long long reference_sum = measure("parse integers with from_chars", [&] {
+        long long sum = 0;
+        for (auto&& str : integers) {
+            int value = 0;
+            std::from_chars(str.data(), str.data() + str.size(), value);
+            sum += value;
+        }
+        return sum;
+    });
+    long long sum = measure("parse integers with parse_number", [&] {
+        long long sum = 0;
+        for (auto&& str : integers) {
+            int value = 0;
+            parse_number(str, value);
+            sum += value;
+        }
+        return sum;
+    });
+    EXPECT_EQ(sum, reference_sum);
+}
 #endif
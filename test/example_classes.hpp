@@ -1,8 +1,11 @@
 #pragma once
+#include "persistence/datetime.hpp"
 #include "persistence/object.hpp"
+#include <map>
 #include <memory>
 #include <optional>
 #include <string>
+#include <variant>
 #include <vector>
 
 struct TestValue
@@ -211,6 +214,117 @@ struct TestOptionalObjectMember
     }
 };
 
+struct TestNumberFormat
+{
+    double price = 0.0;
+    float reading = 0.0f;
+    std::optional<double> discount;
+    double exact = 0.0;
+
+    template <typename Archive>
+    constexpr auto persist(Archive& ar)
+    {
+        return ar
+            & persistence::decimal_places<2>(MEMBER_VARIABLE(price))
+            & persistence::significant_digits<4>(MEMBER_VARIABLE(reading))
+            & persistence::decimal_places<1>(MEMBER_VARIABLE(discount))
+            & MEMBER_VARIABLE(exact)
+            ;
+    }
+
+    bool operator==(const TestNumberFormat& op) const
+    {
+        return price == op.price && reading == op.reading && discount == op.discount && exact == op.exact;
+    }
+};
+
+struct TestEscapedMemberNames
+{
+    std::optional<int> first;
+    int quote = 0;
+    int control = 0;
+
+    template <typename Archive>
+    constexpr auto persist(Archive& ar)
+    {
+        return ar
+            & MEMBER_VARIABLE(first)
+            & NAMED_MEMBER_VARIABLE("\"quote\" \\ back", quote)
+            & NAMED_MEMBER_VARIABLE("tab\tline\n\x01", control)
+            ;
+    }
+
+    bool operator==(const TestEscapedMemberNames& op) const
+    {
+        return first == op.first && quote == op.quote && control == op.control;
+    }
+};
+
+struct TestTimeEncoding
+{
+    persistence::timestamp created;
+    std::optional<persistence::timestamp> updated;
+    persistence::timestamp expires;
+    persistence::timestamp logged;
+
+    template <typename Archive>
+    constexpr auto persist(Archive& ar)
+    {
+        return ar
+            & persistence::time_encoding<persistence::TimeEncoding::epoch_milliseconds>(MEMBER_VARIABLE(created))
+            & persistence::time_encoding<persistence::TimeEncoding::epoch_seconds>(MEMBER_VARIABLE(updated))
+            & persistence::time_encoding<persistence::TimeEncoding::epoch_nanoseconds>(MEMBER_VARIABLE(expires))
+            & MEMBER_VARIABLE(logged)
+            ;
+    }
+
+    bool operator==(const TestTimeEncoding& op) const
+    {
+        return created == op.created && updated == op.updated && expires == op.expires && logged == op.logged;
+    }
+};
+
+struct TestTimeEncodingSolo
+{
+    persistence::timestamp time;
+
+    template <typename Archive>
+    constexpr auto persist(Archive& ar)
+    {
+        return ar
+            & persistence::time_encoding<persistence::TimeEncoding::epoch_microseconds>(MEMBER_VARIABLE(time))
+            ;
+    }
+
+    bool operator==(const TestTimeEncodingSolo& op) const
+    {
+        return time == op.time;
+    }
+};
+
+template<persistence::TimeEncoding Encoding>
+struct TestAuditRecord
+{
+    long long id = 0;
+    persistence::timestamp created;
+    persistence::timestamp modified;
+
+    template <typename Archive>
+    constexpr auto persist(Archive& ar)
+    {
+        return ar
+            & MEMBER_VARIABLE(id)
+            & persistence::time_encoding<Encoding>(MEMBER_VARIABLE(created))
+            & persistence::time_encoding<Encoding>(MEMBER_VARIABLE(modified))
+            ;
+    }
+
+    bool operator==(const TestAuditRecord& op) const
+    {
+        return id == op.id && created == op.created && modified == op.modified;
+    }
+};
+
 struct TestBackReferenceArray
 {
     std::vector<std::shared_ptr<TestValue>> values;
@@ -239,6 +353,81 @@ struct TestBackReferenceObject
     }
 };
 
+struct TestBackReferenceTree
+{
+    std::vector<TestBackReferenceTree> children;
+    std::shared_ptr<TestValue> value;
+
+    template <typename Archive>
+    constexpr auto persist(Archive& ar)
+    {
+        return ar
+            & MEMBER_VARIABLE(children)
+            & MEMBER_VARIABLE(value)
+            ;
+    }
+};
+
+struct TestBackReferenceVariant
+{
+    std::vector<std::variant<std::map<std::string, int>, TestBackReferenceObject>> items;
+    std::shared_ptr<TestValue> last;
+
+    template <typename Archive>
+    constexpr auto persist(Archive& ar)
+    {
+        return ar
+            & MEMBER_VARIABLE(items)
+            & MEMBER_VARIABLE(last)
+            ;
+    }
+};
+
+struct TestSharedNumberAlternative
+{
+    std::shared_ptr<TestValue> shared;
+    int number = 0;
+
+    template <typename Archive>
+    constexpr auto persist(Archive& ar)
+    {
+        return ar
+            & MEMBER_VARIABLE(shared)
+            & MEMBER_VARIABLE(number)
+            ;
+    }
+};
+
+struct TestSharedStringAlternative
+{
+    std::shared_ptr<TestValue> shared;
+    std::string number;
+
+    template <typename Archive>
+    constexpr auto persist(Archive& ar)
+    {
+        return ar
+            & MEMBER_VARIABLE(shared)
+            & MEMBER_VARIABLE(number)
+            ;
+    }
+};
+
+struct TestBackReferenceAlternatives
+{
+    std::variant<TestSharedNumberAlternative, TestSharedStringAlternative> item;
+    std::shared_ptr<TestValue> last;
+
+    template <typename Archive>
+    constexpr auto persist(Archive& ar)
+    {
+        return ar
+            & MEMBER_VARIABLE(item)
+            & MEMBER_VARIABLE(last)
+            ;
+    }
+};
+
 /** Documentation example. */
 struct UserDefinedType
 {
@@ -0,0 +1,26 @@
+#pragma once
+#include <string>
+
+/** Expands a macro for each of the 300 identifiers `a00` to `a99`, `b00` to `b99` and `c00` to `c99`. */
+#define TEST_FOR_EACH_10(F, p) F(p##0) F(p##1) F(p##2) F(p##3) F(p##4) F(p##5) F(p##6) F(p##7) F(p##8) F(p##9)
+#define TEST_FOR_EACH_100(F, p) \
+    TEST_FOR_EACH_10(F, p##0) TEST_FOR_EACH_10(F, p##1) TEST_FOR_EACH_10(F, p##2) TEST_FOR_EACH_10(F, p##3) TEST_FOR_EACH_10(F, p##4) \
+    TEST_FOR_EACH_10(F, p##5) TEST_FOR_EACH_10(F, p##6) TEST_FOR_EACH_10(F, p##7) TEST_FOR_EACH_10(F, p##8) TEST_FOR_EACH_10(F, p##9)
+#define TEST_FOR_EACH_300(F) TEST_FOR_EACH_100(F, a) TEST_FOR_EACH_100(F, b) TEST_FOR_EACH_100(F, c)
+
+#define TEST_NUMEROUS_VALUE(e) e,
+
+/** An enumeration with many values, each of which is named after its identifier. */
+enum class Numerous
+{
+    TEST_FOR_EACH_300(TEST_NUMEROUS_VALUE)
+};
+
+/** The name of the value with the given zero-based index. */
+inline std::string numerous_name(std::size_t index)
+{
+    std::string name(1, static_cast<char>('a' + index / 100));
+    name += static_cast<char>('0' + index / 10 % 10);
+    name += static_cast<char>('0' + index % 10);
+    return name;
+}
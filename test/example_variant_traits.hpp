@@ -0,0 +1,93 @@
+#pragma once
+#include "persistence/object.hpp"
+#include "persistence/variant.hpp"
+#include <string>
+
+struct TestCircle
+{
+    TestCircle() = default;
+    TestCircle(double radius) : radius(radius) {}
+
+    double radius = 0.0;
+
+    template <typename Archive>
+    constexpr auto persist(Archive& ar)
+    {
+        return ar
+            & MEMBER_VARIABLE(radius)
+            ;
+    }
+
+    bool operator==(const TestCircle& op) const
+    {
+        return radius == op.radius;
+    }
+};
+
+struct TestRectangle
+{
+    TestRectangle() = default;
+    TestRectangle(double width, double height) : width(width), height(height) {}
+
+    double width = 0.0;
+    double height = 0.0;
+
+    template <typename Archive>
+    constexpr auto persist(Archive& ar)
+    {
+        return ar
+            & MEMBER_VARIABLE(width)
+            & MEMBER_VARIABLE(height)
+            ;
+    }
+
+    bool operator==(const TestRectangle& op) const
+    {
+        return width == op.width && height == op.height;
+    }
+};
+
+struct TestLabel
+{
+    TestLabel() = default;
+    TestLabel(const std::string& text) : text(text) {}
+
+    std::string text;
+
+    template <typename Archive>
+    constexpr auto persist(Archive& ar)
+    {
+        return ar
+            & MEMBER_VARIABLE(text)
+            ;
+    }
+
+    bool operator==(const TestLabel& op) const
+    {
+        return text == op.text;
+    }
+};
+
+namespace persistence
+{
+    template<>
+    struct variant_traits<TestCircle>
+    {
+        constexpr static std::string_view discriminator = "type";
+        constexpr static std::string_view tag = "circle";
+    };
+
+    template<>
+    struct variant_traits<TestRectangle>
+    {
+        constexpr static std::string_view discriminator = "type";
+        constexpr static std::string_view tag = "rectangle";
+    };
+
+    template<>
+    struct variant_traits<TestLabel>
+    {
+        constexpr static std::string_view discriminator = "type";
+        constexpr static std::string_view tag = "label";
+    };
+}
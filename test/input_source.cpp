@@ -0,0 +1,222 @@
+#include <gtest/gtest.h>
+#include "persistence/parse_all.hpp"
+#include "persistence/parse.hpp"
+#include "persistence/input_source.hpp"
+#include "persistence/base64.hpp"
+#include "persistence/object.hpp"
+#include <cstdio>
+#include <map>
+#include <sstream>
+
+using namespace persistence;
+
+namespace test
+{
+    /** Records the bytes received, and fails when a size limit is exceeded. */
+    struct RecordingByteSink : ByteSink
+    {
+        byte_vector bytes;
+        std::size_t chunk_count = 0;
+        std::size_t limit = std::string::npos;
+
+        bool write(const std::byte* data, std::size_t size) override
+        {
+            if (bytes.size() + size > limit) {
+                return false;
+            }
+            bytes.insert(bytes.end(), data, data + size);
+            ++chunk_count;
+            return true;
+        }
+    };
+
+    struct Attachment
+    {
+        std::string name;
+        byte_vector content;
+
+        template <typename Archive>
+        constexpr auto persist(Archive& ar)
+        {
+            return ar
+                & MEMBER_VARIABLE(name)
+                & MEMBER_VARIABLE(content)
+                ;
+        }
+    };
+
+    struct Upload
+    {
+        std::string name;
+        RecordingByteSink content;
+
+        template <typename Archive>
+        constexpr auto persist(Archive& ar)
+        {
+            return ar
+                & MEMBER_VARIABLE(name)
+                & MEMBER_VARIABLE(content)
+                ;
+        }
+    };
+
+    byte_vector make_bytes(std::size_t size)
+    {
+        byte_vector bytes;
+        for (std::size_t k = 0; k < size; ++k) {
+            bytes.push_back(std::byte((k * 7 + k / 256) % 256));
+        }
+        return bytes;
+    }
+
+    std::string make_base64(const byte_vector& bytes)
+    {
+        std::string encoded;
+        base64_encode(bytes, encoded);
+        return encoded;
+    }
+}
+
+TEST(Input, Sources)
+{
+    const std::string json = "{\"name\": \"text\", \"content\": \"" + test::make_base64(test::make_bytes(1000)) + "\"}";
+
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    std::fwrite(json.data(), 1, json.size(), file);
+    std::rewind(file);
+    {
+        FileSource source(file, 64);
+        auto attachment = parse<test::Attachment>(source);
+        EXPECT_EQ(attachment.name, "text");
+        EXPECT_EQ(attachment.content, test::make_bytes(1000));
+        EXPECT_EQ(source.Tell(), json.size());
+    }
+
+#if defined(PERSISTENCE_FILE_DESCRIPTOR)
+    std::rewind(file);
+    {
+        FileDescriptorSource source(fileno(file), 64);
+        auto attachment = parse<test::Attachment>(source);
+        EXPECT_EQ(attachment.content, test::make_bytes(1000));
+    }
+
+    FileDescriptorSource invalid_source(-1);
+    test::Attachment attachment;
+    EXPECT_FALSE(parse(invalid_source, attachment));
+    EXPECT_FALSE(invalid_source.good());
+    EXPECT_THROW(parse<test::Attachment>(invalid_source), JsonParseError);
+#endif
+    std::fclose(file);
+
+    // syntax errors are reported at the offset in the input
+    std::istringstream stream("[1, 2,, 3]");
+    InputStreamSource source(stream, 2);
+    try {
+        parse<std::vector<int>>(source);
+        FAIL();
+    } catch (JsonParseError& e) {
+        EXPECT_EQ(e.offset, 6);
+    }
+}
+
+TEST(Input, Base64Capture)
+{
+    // strings straddle buffer boundaries at every position
+    for (std::size_t capacity : { 1, 2, 3, 4, 5, 7, 64, 4096 }) {
+        for (std::size_t size : { 0, 1, 2, 3, 4, 5, 100, 10000 }) {
+            const byte_vector bytes = test::make_bytes(size);
+            const std::string encoded = test::make_base64(bytes);
+
+            std::istringstream stream("{ \"content\" :\"" + encoded + "\", \"name\":\"" + encoded + "\"}");
+            InputStreamSource source(stream, capacity);
+            test::Attachment attachment;
+            ASSERT_TRUE(parse(source, attachment)) << "capacity: " << capacity << ", size: " << size;
+            EXPECT_EQ(attachment.content, bytes);
+            EXPECT_EQ(attachment.name, encoded);
+
+            std::istringstream array_stream("[\"" + encoded + "\" , \"\",\"" + encoded + "\"]");
+            InputStreamSource array_source(array_stream, capacity);
+            std::vector<byte_vector> items;
+            ASSERT_TRUE(parse(array_source, items));
+            EXPECT_EQ(items, std::vector<byte_vector>({ bytes, byte_vector(), bytes }));
+        }
+    }
+
+    // escape sequences are left to the reader
+    std::istringstream escaped_stream("[\"Zm9v\\/w==\", \"\\/\\/\\/\\/\"]");
+    InputStreamSource escaped_source(escaped_stream, 4);
+    std::vector<byte_vector> items;
+    EXPECT_TRUE(parse(escaped_source, items));
+    EXPECT_EQ(items, std::vector<byte_vector>({ make_byte_vector('f', 'o', 'o', 0xFF), make_byte_vector(0xFF, 0xFF, 0xFF) }));
+
+    // string values other than sequences of bytes are not captured
+    std::istringstream map_stream("{\"a\": \"Zm9v\", \"b\": \"\", \"c\": \"YmFy\"}");
+    InputStreamSource map_source(map_stream, 3);
+    auto map = parse<std::map<std::string, byte_vector>>(map_source);
+    EXPECT_EQ(map["a"], make_byte_vector('f', 'o', 'o'));
+    EXPECT_TRUE(map["b"].empty());
+    EXPECT_EQ(map["c"], make_byte_vector('b', 'a', 'r'));
+
+    for (const char* invalid : { "\"Zm9v=\"", "\"Zm9vY\"", "\"Zm=vYmFy\"", "\"Zm9v\\nYmFy\"", "\"Zm9v", "{\"a\":1}", "null" }) {
+        std::istringstream invalid_stream(invalid);
+        InputStreamSource invalid_source(invalid_stream, 2);
+        byte_vector bytes;
+        EXPECT_FALSE(parse(invalid_source, bytes)) << invalid;
+    }
+}
+
+TEST(Input, ByteSink)
+{
+    const byte_vector bytes = test::make_bytes(100000);
+    const std::string json = "{\"name\":\"blob\",\"content\":\"" + test::make_base64(bytes) + "\"}";
+
+    // bytes arrive in chunks as the string is read
+    std::istringstream stream(json);
+    InputStreamSource source(stream, 1024);
+    test::Upload upload;
+    EXPECT_TRUE(parse(source, upload));
+    EXPECT_EQ(upload.name, "blob");
+    EXPECT_EQ(upload.content.bytes, bytes);
+    EXPECT_GT(upload.content.chunk_count, 10);
+
+    // the same without an input source
+    test::Upload string_upload;
+    EXPECT_TRUE(parse(json, string_upload));
+    EXPECT_EQ(string_upload.content.bytes, bytes);
+
+    // sink fails part way, e.g. disk full
+    std::istringstream full_stream(json);
+    InputStreamSource full_source(full_stream, 1024);
+    test::Upload full_upload;
+    full_upload.content.limit = 50000;
+    EXPECT_FALSE(parse(full_source, full_upload));
+    EXPECT_LE(full_upload.content.bytes.size(), 50000);
+
+    test::Upload full_string_upload;
+    full_string_upload.content.limit = 50000;
+    EXPECT_FALSE(parse(json, full_string_upload));
+    EXPECT_THROW(parse<test::Upload>(std::string("{\"name\":\"blob\",\"content\":\"Zm9v=\"}")), JsonParseError);
+}
+
+TEST(Input, Utf8Validation)
+{
+    constexpr unsigned validate = rapidjson::kParseValidateEncodingFlag;
+
+    // strings straddle the boundaries of the buffer, and are validated once read in full
+    std::istringstream stream("{\"na\xC3\xAFve\": \"caf\xC3\xA9 cr\xC3\xA8me br\xC3\xBBl\xC3\xA9\xF0\x9F\x8D\xAE\"}");
+    InputStreamSource source(stream, 3);
+    auto map = parse<std::map<std::string, std::string>, validate>(source);
+    EXPECT_EQ(map["na\xC3\xAFve"], "caf\xC3\xA9 cr\xC3\xA8me br\xC3\xBBl\xC3\xA9\xF0\x9F\x8D\xAE");
+
+    for (const char* invalid : { "[\"caf\xE9\"]", "[\"ok\", \"\xF4\x90\x80\x80\"]", "[\"truncated \xE2\x82\"]" }) {
+        std::istringstream invalid_stream(invalid);
+        InputStreamSource invalid_source(invalid_stream, 3);
+        try {
+            parse<std::vector<std::string>, validate>(invalid_source);
+            FAIL() << invalid;
+        } catch (JsonParseError& e) {
+            EXPECT_NE(std::string(e.what()).find(rapidjson::GetParseError_En(rapidjson::kParseErrorStringInvalidEncoding)), std::string::npos);
+        }
+    }
+}
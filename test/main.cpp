@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "persistence/persistence.hpp"
 #include "persistence/utility.hpp"
+#include "persistence/enum_utility.hpp"
+#include "persistence/utf8.hpp"
 #include "example_classes.hpp"
 #include "measure.hpp"
 #include "random.hpp"
@@ -62,6 +64,17 @@ TEST(Performance, Object)
     });
     EXPECT_GT(json.size(), 0u);
     std::cout << "JSON string has size of " << json.size() << " B" << std::endl;
+    auto size = measure("compute JSON size", [&] {
+        return json_size(items);
+    });
+    EXPECT_EQ(size, json.size());
+    auto exact_json = measure("write object to string allocated to computed size", [&] {
+        std::string str(json_size(items), '\0');
+        FixedBufferSink sink(str.data(), str.size());
+        write_to_sink(items, sink);
+        return str;
+    });
+    EXPECT_EQ(exact_json, json);
     measure("parse object from string", [&] {
         parse<std::vector<TestDataTransferObject>>(json);
     });
@@ -93,6 +106,662 @@ TEST(Performance, Object)
         deserialize<std::vector<TestDataTransferObject>>(json);
     });
 }
+
+TEST(Performance, Telemetry)
+{
+    // sensor readings with two decimal digits, stored in single precision
+    std::mt19937_64 engine;
+    std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+    std::vector<std::vector<float>> samples;
+    for (std::size_t k = 0; k < 500000; ++k) {
+        std::vector<float> channels;
+        for (std::size_t n = 0; n < 8; ++n) {
+            channels.push_back(std::round(distribution(engine) * 100.0f) / 100.0f);
+        }
+        samples.push_back(std::move(channels));
+    }
+
+    auto widened_json = measure("write float samples widened to double", [&] {
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        writer.StartArray();
+        for (auto&& channels : samples) {
+            writer.StartArray();
+            for (float value : channels) {
+                writer.Double(static_cast<double>(value));
+            }
+            writer.EndArray();
+        }
+        writer.EndArray();
+        return std::string(buffer.GetString(), buffer.GetSize());
+    });
+    std::cout << "JSON string has size of " << widened_json.size() << " B" << std::endl;
+    auto json = measure("write float samples", [&] {
+        return write_to_string(samples);
+    });
+    std::cout << "JSON string has size of " << json.size() << " B" << std::endl;
+    EXPECT_LT(json.size(), widened_json.size());
+    EXPECT_EQ(parse<std::vector<std::vector<float>>>(json), samples);
+
+    measure("serialize float samples to DOM", [&] {
+        serialize_to_document(samples);
+    });
+
+    std::vector<std::vector<double>> double_samples;
+    for (auto&& channels : samples) {
+        double_samples.emplace_back(channels.begin(), channels.end());
+    }
+    measure("write double samples", [&] {
+        return write_to_string(double_samples);
+    });
+}
+
+/** Writes items one by one through the generic path, which creates a context for each item. */
+template<typename T>
+std::string write_items_to_string(const std::vector<T>& items)
+{
+    MemorySink sink;
+    StringWriter writer(sink);
+    WriterReferenceContext global;
+    WriterContext local(global);
+    writer.StartArray();
+    std::size_t k = 0;
+    for (const auto& item : items) {
+        WriterContext item_context(local, Segment(k++));
+        serialize(item, writer, item_context);
+    }
+    writer.EndArray();
+    return std::string(sink.str());
+}
+
+TEST(Performance, NumberArray)
+{
+    std::mt19937_64 engine;
+    std::vector<int> ints;
+    std::vector<std::uint64_t> longs;
+    std::vector<double> doubles;
+    std::uniform_real_distribution<double> distribution(-1000.0, 1000.0);
+    for (std::size_t k = 0; k < 10000000; ++k) {
+        ints.push_back(random_integer<int>(engine));
+        longs.push_back(engine());
+    }
+    for (std::size_t k = 0; k < 2000000; ++k) {
+        doubles.push_back(distribution(engine));
+    }
+
+    auto int_reference = measure("write integers item by item", [&] {
+        return write_items_to_string(ints);
+    });
+    auto int_json = measure("write integers in bulk", [&] {
+        return write_to_string(ints);
+    });
+    EXPECT_EQ(int_json, int_reference);
+
+    auto long_reference = measure("write 64-bit integers item by item", [&] {
+        return write_items_to_string(longs);
+    });
+    auto long_json = measure("write 64-bit integers in bulk", [&] {
+        return write_to_string(longs);
+    });
+    EXPECT_EQ(long_json, long_reference);
+
+    auto double_reference = measure("write doubles item by item", [&] {
+        return write_items_to_string(doubles);
+    });
+    auto double_json = measure("write doubles in bulk", [&] {
+        return write_to_string(doubles);
+    });
+    EXPECT_EQ(double_json, double_reference);
+}
+
+TEST(Performance, NumberArrayParse)
+{
+    std::mt19937_64 engine;
+    std::vector<int> ints;
+    std::vector<std::uint64_t> longs;
+    std::vector<double> doubles;
+    std::uniform_real_distribution<double> distribution(-1000.0, 1000.0);
+    for (std::size_t k = 0; k < 1000000; ++k) {
+        ints.push_back(random_integer<int>(engine));
+        longs.push_back(engine());
+        doubles.push_back(distribution(engine));
+    }
+    auto int_json = write_to_string(ints);
+    auto long_json = write_to_string(longs);
+    auto double_json = write_to_string(doubles);
+
+    // comments in the input rule out scanning, which leaves every item to the reader
+    constexpr unsigned token_flags = rapidjson::kParseCommentsFlag;
+
+    auto int_reference = measure("parse integers item by item", [&] {
+        return parse<std::vector<int>, token_flags>(int_json);
+    });
+    auto int_result = measure("parse integers with number scanner", [&] {
+        return parse<std::vector<int>>(int_json);
+    });
+    EXPECT_EQ(int_reference, ints);
+    EXPECT_EQ(int_result, ints);
+
+    auto long_reference = measure("parse 64-bit integers item by item", [&] {
+        return parse<std::vector<std::uint64_t>, token_flags>(long_json);
+    });
+    auto long_result = measure("parse 64-bit integers with number scanner", [&] {
+        return parse<std::vector<std::uint64_t>>(long_json);
+    });
+    EXPECT_EQ(long_reference, longs);
+    EXPECT_EQ(long_result, longs);
+
+    auto double_reference = measure("parse doubles item by item", [&] {
+        return parse<std::vector<double>, token_flags | rapidjson::kParseFullPrecisionFlag>(double_json);
+    });
+    auto double_result = measure("parse doubles with number scanner", [&] {
+        return parse<std::vector<double>>(double_json);
+    });
+    EXPECT_EQ(double_reference, doubles);
+    EXPECT_EQ(double_result, doubles);
+}
+
+template<bool Rounded>
+struct TestQuote
+{
+    double bid = 0.0;
+    double ask = 0.0;
+    double change = 0.0;
+    float volume = 0.0f;
+
+    template <typename Archive>
+    constexpr auto persist(Archive& ar)
+    {
+        if constexpr (Rounded) {
+            return ar
+                & decimal_places<4>(MEMBER_VARIABLE(bid))
+                & decimal_places<4>(MEMBER_VARIABLE(ask))
+                & significant_digits<3>(MEMBER_VARIABLE(change))
+                & decimal_places<0>(MEMBER_VARIABLE(volume))
+                ;
+        } else {
+            return ar
+                & MEMBER_VARIABLE(bid)
+                & MEMBER_VARIABLE(ask)
+                & MEMBER_VARIABLE(change)
+                & MEMBER_VARIABLE(volume)
+                ;
+        }
+    }
+};
+
+TEST(Performance, NumberFormat)
+{
+    std::mt19937_64 engine;
+    std::uniform_real_distribution<double> price(10.0, 1000.0);
+    std::uniform_real_distribution<double> spread(0.0, 0.01);
+    std::vector<TestQuote<false>> quotes;
+    std::vector<TestQuote<true>> rounded_quotes;
+    for (std::size_t k = 0; k < 1000000; ++k) {
+        TestQuote<false> quote;
+        quote.bid = price(engine);
+        quote.ask = quote.bid * (1.0 + spread(engine));
+        quote.change = (quote.ask - quote.bid) / quote.bid;
+        quote.volume = static_cast<float>(price(engine) * 1000.0);
+        quotes.push_back(quote);
+        rounded_quotes.push_back({ quote.bid, quote.ask, quote.change, quote.volume });
+    }
+
+    auto json = measure("write quotes at full precision", [&] {
+        return write_to_string(quotes);
+    });
+    std::cout << "JSON string has size of " << json.size() << " B" << std::endl;
+    auto rounded_json = measure("write quotes with number format", [&] {
+        return write_to_string(rounded_quotes);
+    });
+    std::cout << "JSON string has size of " << rounded_json.size() << " B" << std::endl;
+    EXPECT_LT(rounded_json.size(), json.size());
+}
+
+struct TestTrade
+{
+    std::int64_t trade_id = 0;
+    int instrument_id = 0;
+    int account_id = 0;
+    unsigned quantity = 0;
+    bool is_buy = false;
+    bool is_settled = false;
+    std::string venue;
+    std::string currency;
+
+    template <typename Archive>
+    constexpr auto persist(Archive& ar)
+    {
+        return ar
+            & MEMBER_VARIABLE(trade_id)
+            & MEMBER_VARIABLE(instrument_id)
+            & MEMBER_VARIABLE(account_id)
+            & MEMBER_VARIABLE(quantity)
+            & MEMBER_VARIABLE(is_buy)
+            & MEMBER_VARIABLE(is_settled)
+            & MEMBER_VARIABLE(venue)
+            & MEMBER_VARIABLE(currency)
+            ;
+    }
+};
+
+TEST(Performance, Timestamps)
+{
+    std::mt19937_64 engine;
+    std::uniform_int_distribution<std::int64_t> distribution(0, 4102444800);  // 1970 to 2100
+    std::vector<timestamp> timestamps;
+    for (std::size_t k = 0; k < 2000000; ++k) {
+        timestamps.push_back(timestamp(std::chrono::seconds(distribution(engine))));
+    }
+
+    auto json = measure("write timestamps", [&] {
+        return write_to_string(timestamps);
+    });
+    auto parsed = measure("parse timestamps", [&] {
+        return parse<std::vector<timestamp>>(json);
+    });
+    EXPECT_EQ(parsed, timestamps);
+
+    auto doc = measure("serialize timestamps to DOM", [&] {
+        return serialize_to_document(timestamps);
+    });
+    auto deserialized = measure("deserialize timestamps from DOM", [&] {
+        return deserialize<std::vector<timestamp>>(doc);
+    });
+    EXPECT_EQ(deserialized, timestamps);
+}
+
+template<TimeEncoding Encoding>
+void measure_time_encoding(const char* label, const std::vector<TestAuditRecord<TimeEncoding::iso8601>>& source)
+{
+    std::vector<TestAuditRecord<Encoding>> records;
+    for (auto&& item : source) {
+        records.push_back({ item.id, item.created, item.modified });
+    }
+
+    auto json = measure((std::string("write records with ") + label).c_str(), [&] {
+        return write_to_string(records);
+    });
+    std::cout << "JSON string has size of " << json.size() << " B" << std::endl;
+    auto parsed = measure((std::string("parse records with ") + label).c_str(), [&] {
+        return parse<std::vector<TestAuditRecord<Encoding>>>(json);
+    });
+    EXPECT_EQ(parsed, records);
+}
+
+TEST(Performance, TimeEncoding)
+{
+    std::mt19937_64 engine;
+    std::uniform_int_distribution<std::int64_t> distribution(0, 4102444800000);  // 1970 to 2100
+    std::vector<TestAuditRecord<TimeEncoding::iso8601>> records;
+    for (std::size_t k = 0; k < 1000000; ++k) {
+        timestamp created = timestamp(std::chrono::milliseconds(distribution(engine)));
+        records.push_back({ static_cast<long long>(k), created, created + std::chrono::milliseconds(engine() % 86400000) });
+    }
+
+    measure_time_encoding<TimeEncoding::iso8601>("ISO 8601 strings", records);
+    measure_time_encoding<TimeEncoding::epoch_milliseconds>("epoch milliseconds", records);
+}
+
+TEST(Performance, ObjectKeys)
+{
+    std::mt19937_64 engine;
+    std::vector<TestTrade> trades;
+    for (std::size_t k = 0; k < 1000000; ++k) {
+        TestTrade trade;
+        trade.trade_id = static_cast<std::int64_t>(k);
+        trade.instrument_id = static_cast<int>(engine() % 10000);
+        trade.account_id = static_cast<int>(engine() % 1000);
+        trade.quantity = static_cast<unsigned>(engine() % 100000);
+        trade.is_buy = engine() % 2 == 0;
+        trade.is_settled = engine() % 2 == 0;
+        trade.venue = "XNAS";
+        trade.currency = "USD";
+        trades.push_back(trade);
+    }
+
+    auto reference = measure("write objects with escaped keys", [&] {
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        writer.StartArray();
+        for (auto&& trade : trades) {
+            writer.StartObject();
+            writer.Key("trade_id");
+            writer.Int64(trade.trade_id);
+            writer.Key("instrument_id");
+            writer.Int(trade.instrument_id);
+            writer.Key("account_id");
+            writer.Int(trade.account_id);
+            writer.Key("quantity");
+            writer.Uint(trade.quantity);
+            writer.Key("is_buy");
+            writer.Bool(trade.is_buy);
+            writer.Key("is_settled");
+            writer.Bool(trade.is_settled);
+            writer.Key("venue");
+            writer.String(trade.venue.data(), static_cast<rapidjson::SizeType>(trade.venue.size()));
+            writer.Key("currency");
+            writer.String(trade.currency.data(), static_cast<rapidjson::SizeType>(trade.currency.size()));
+            writer.EndObject();
+        }
+        writer.EndArray();
+        return std::string(buffer.GetString(), buffer.GetSize());
+    });
+    auto json = measure("write objects with pre-escaped keys", [&] {
+        return write_to_string(trades);
+    });
+    EXPECT_EQ(json, reference);
+}
+
+TEST(Performance, StringReuse)
+{
+    std::vector<TestTrade> trades;
+    for (std::size_t k = 0; k < 100; ++k) {
+        TestTrade trade;
+        trade.trade_id = static_cast<std::int64_t>(k);
+        trade.venue = "XNAS";
+        trade.currency = "USD";
+        trades.push_back(trade);
+    }
+
+    // build a response repeatedly, as a server would for each request
+    const std::size_t count = 20000;
+    std::size_t total = 0;
+    measure("write responses to new buffer and copy", [&] {
+        for (std::size_t k = 0; k < count; ++k) {
+            MemorySink sink;
+            write_to_sink(trades, sink);
+            std::string str(sink.str());
+            total += str.size();
+        }
+    });
+    std::string response;
+    measure("write responses in place reusing string capacity", [&] {
+        for (std::size_t k = 0; k < count; ++k) {
+            write_to_string(trades, response);
+            total -= response.size();
+        }
+    });
+    EXPECT_EQ(total, 0);
+}
+
+TEST(Performance, Bytes)
+{
+    // binary attachments of 1 MB each
+    std::vector<byte_vector> attachments;
+    for (std::size_t n = 0; n < 200; ++n) {
+        byte_vector attachment;
+        for (std::size_t k = 0; k < 1000000; ++k) {
+            attachment.push_back(std::byte((k * 31 + n) % 256));
+        }
+        attachments.push_back(std::move(attachment));
+    }
+
+    auto json = measure("write binary attachments", [&] {
+        return write_to_string(attachments);
+    });
+    std::cout << "JSON string has size of " << json.size() << " B" << std::endl;
+    measure("serialize binary attachments to DOM", [&] {
+        serialize_to_document(attachments);
+    });
+    measure("parse binary attachments from string", [&] {
+        parse<std::vector<byte_vector>>(json);
+    });
+
+    std::FILE* file = std::tmpfile();
+    std::fwrite(json.data(), 1, json.size(), file);
+    measure("parse binary attachments from file", [&] {
+        std::rewind(file);
+        FileSource source(file);
+        parse<std::vector<byte_vector>>(source);
+    });
+    std::fclose(file);
+}
+
+TEST(Performance, References)
+{
+    TestBackReferenceArray obj;
+    const std::size_t count = 1000000;
+    obj.values.reserve(2 * count);
+    for (std::size_t k = 0; k < count; ++k) {
+        obj.values.push_back(std::make_shared<TestValue>("test string"));
+    }
+    for (std::size_t k = 0; k < count; ++k) {
+        obj.values.push_back(obj.values[k]);
+    }
+
+    auto json = measure("write shared objects to string", [&] {
+        return write_to_string(obj);
+    });
+    EXPECT_GT(json.size(), 0u);
+    measure("serialize shared objects to DOM", [&] {
+        serialize_to_document(obj);
+    });
+
+    auto doc = string_to_document(json);
+    EXPECT_FALSE(doc.HasParseError());
+    auto result = measure("deserialize shared objects from DOM", [&] {
+        return deserialize<TestBackReferenceArray>(doc);
+    });
+    ASSERT_EQ(result.values.size(), 2 * count);
+    EXPECT_EQ(result.values[0], result.values[count]);
+
+    auto parsed = measure("parse shared objects from string", [&] {
+        return parse<TestBackReferenceArray>(json);
+    });
+    ASSERT_EQ(parsed.values.size(), 2 * count);
+    EXPECT_EQ(parsed.values[0], parsed.values[count]);
+}
+
+TEST(Performance, IntegerKeyMap)
+{
+    std::mt19937_64 engine;
+    std::map<std::int64_t, int> positions;
+    for (std::size_t k = 0; k < 1000000; ++k) {
+        positions[static_cast<std::int64_t>(engine() % 10000000000)] = static_cast<int>(engine() % 100000);
+    }
+
+    // keys converted to and from strings through an intermediate map
+    auto reference = measure("write map with keys converted to strings", [&] {
+        std::map<std::string, int> converted;
+        for (auto&& [key, value] : positions) {
+            converted.emplace(std::to_string(key), value);
+        }
+        return write_to_string(converted);
+    });
+    auto json = measure("write map with integer keys", [&] {
+        return write_to_string(positions);
+    });
+
+    auto converted = measure("parse map with keys converted from strings", [&] {
+        auto parsed = parse<std::map<std::string, int>>(reference);
+        std::map<std::int64_t, int> result;
+        for (auto&& [key, value] : parsed) {
+            result.emplace(std::stoll(key), value);
+        }
+        return result;
+    });
+    EXPECT_EQ(converted, positions);
+    auto parsed = measure("parse map with integer keys", [&] {
+        return parse<std::map<std::int64_t, int>>(json);
+    });
+    EXPECT_EQ(parsed, positions);
+
+    auto doc = measure("serialize map with integer keys to DOM", [&] {
+        return serialize_to_document(positions);
+    });
+    auto deserialized = measure("deserialize map with integer keys from DOM", [&] {
+        return deserialize<std::map<std::int64_t, int>>(doc);
+    });
+    EXPECT_EQ(deserialized, positions);
+}
+
+TEST(Performance, FlatMap)
+{
+    std::mt19937_64 engine;
+    std::map<std::string, int> settings;
+    for (std::size_t k = 0; k < 1000; ++k) {
+        settings["setting." + std::to_string(engine() % 1000000)] = static_cast<int>(k);
+    }
+    std::vector<std::string> documents;
+    for (std::size_t k = 0; k < 1000; ++k) {
+        documents.push_back(write_to_string(settings));
+    }
+    std::vector<std::string> lookups;
+    for (std::size_t k = 0; k < 1000; ++k) {
+        auto it = settings.begin();
+        std::advance(it, engine() % settings.size());
+        lookups.push_back(it->first);
+    }
+
+    auto maps = measure("parse objects into map", [&] {
+        std::vector<std::map<std::string, int>> result;
+        for (auto&& json : documents) {
+            result.push_back(parse<std::map<std::string, int>>(json));
+        }
+        return result;
+    });
+    auto flat_maps = measure("parse objects into flat map", [&] {
+        std::vector<string_flat_map<int>> result;
+        for (auto&& json : documents) {
+            result.push_back(parse<string_flat_map<int>>(json));
+        }
+        return result;
+    });
+
+    // a single configuration map that is read repeatedly
+    auto reference = measure("look up keys in map", [&] {
+        std::int64_t sum = 0;
+        for (std::size_t k = 0; k < 2000; ++k) {
+            for (auto&& key : lookups) {
+                sum += maps.front().find(key)->second;
+            }
+        }
+        return sum;
+    });
+    auto sum = measure("look up keys in flat map", [&] {
+        std::int64_t sum = 0;
+        for (std::size_t k = 0; k < 2000; ++k) {
+            for (auto&& key : lookups) {
+                sum += flat_maps.front().find(key)->second;
+            }
+        }
+        return sum;
+    });
+    EXPECT_EQ(sum, reference);
+}
+
+enum class TestErrorCode : int {};
+
+TEST(Performance, EnumNames)
+{
+    std::vector<std::string> names;
+    std::array<std::pair<TestErrorCode, std::string_view>, 200> items;
+    for (std::size_t k = 0; k < items.size(); ++k) {
+        names.push_back("ERROR_CODE_" + std::to_string(1000 + 3 * k));
+    }
+    for (std::size_t k = 0; k < items.size(); ++k) {
+        items[k] = make_enum(static_cast<TestErrorCode>(1000 + 3 * k), names[k]);
+    }
+    const auto converter = make_enum_converter(items);
+
+    std::mt19937_64 engine;
+    std::vector<std::size_t> indices;
+    for (std::size_t k = 0; k < 2000000; ++k) {
+        indices.push_back(engine() % items.size());
+    }
+
+    auto reference = measure("map names to values with linear search", [&] {
+        std::int64_t sum = 0;
+        for (std::size_t index : indices) {
+            for (auto&& item : items) {
+                if (item.second == names[index]) {
+                    sum += static_cast<int>(item.first);
+                    break;
+                }
+            }
+        }
+        return sum;
+    });
+    auto sum = measure("map names to values with perfect hash", [&] {
+        std::int64_t sum = 0;
+        for (std::size_t index : indices) {
+            TestErrorCode value;
+            if (converter.from_string(names[index], value)) {
+                sum += static_cast<int>(value);
+            }
+        }
+        return sum;
+    });
+    EXPECT_EQ(sum, reference);
+
+    auto reference_length = measure("map values to names with linear search", [&] {
+        std::size_t length = 0;
+        for (std::size_t index : indices) {
+            const auto value = static_cast<TestErrorCode>(1000 + 3 * index);
+            for (auto&& item : items) {
+                if (item.first == value) {
+                    length += item.second.size();
+                    break;
+                }
+            }
+        }
+        return length;
+    });
+    auto length = measure("map values to names with binary search", [&] {
+        std::size_t length = 0;
+        for (std::size_t index : indices) {
+            length += converter.to_string(static_cast<TestErrorCode>(1000 + 3 * index)).size();
+        }
+        return length;
+    });
+    EXPECT_EQ(length, reference_length);
+}
+
+TEST(Performance, Utf8Validation)
+{
+    // text in several scripts, with one- to four-byte characters
+    const char* words[] = { "telemetry", "árvíztűrő", "tükörfúrógép", "Ελληνικά", "日本語", "\xF0\x9F\x98\x80" };
+    std::mt19937_64 engine;
+    std::vector<std::string> strings;
+    for (std::size_t k = 0; k < 1000000; ++k) {
+        std::string str;
+        for (std::size_t i = 0; i < 12; ++i) {
+            str += words[engine() % 6];
+            str += ' ';
+        }
+        strings.push_back(str);
+    }
+    const std::string json = write_to_string(strings);
+
+    measure("copy input", [&] {
+        std::string copy(json.size(), '\0');
+        std::memcpy(copy.data(), json.data(), json.size());
+        return copy;
+    });
+    EXPECT_TRUE(measure("validate input as UTF-8", [&] {
+        return is_valid_utf8(json);
+    }));
+
+    auto reference = measure("parse without validation", [&] {
+        return parse<std::vector<std::string>>(json);
+    });
+    auto checked = measure("parse with RapidJSON validation", [&] {
+        std::vector<std::string> result;
+        rapidjson::Document doc;
+        doc.Parse<rapidjson::kParseValidateEncodingFlag>(json.data());
+        for (auto it = doc.Begin(); it != doc.End(); ++it) {
+            result.emplace_back(it->GetString(), it->GetStringLength());
+        }
+        return result;
+    });
+    auto validated = measure("parse with vectorized validation", [&] {
+        return parse<std::vector<std::string>, rapidjson::kParseValidateEncodingFlag>(json);
+    });
+    EXPECT_EQ(checked, reference);
+    EXPECT_EQ(validated, reference);
+}
+
 #endif
 
 TEST(Documentation, Example)
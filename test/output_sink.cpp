@@ -0,0 +1,251 @@
+#include <gtest/gtest.h>
+#include "persistence/write_all.hpp"
+#include "persistence/write.hpp"
+#include "persistence/output_sink.hpp"
+#include <cstdio>
+#include <sstream>
+
+using namespace persistence;
+
+namespace test
+{
+    /** A memory sink that can be made to fail to grow, as if it had run out of memory. */
+    struct LimitedMemorySink : MemorySink
+    {
+        LimitedMemorySink() : MemorySink(16) {}
+
+        bool out_of_memory = false;
+
+    protected:
+        bool grow(std::size_t count) override
+        {
+            return !out_of_memory && MemorySink::grow(count);
+        }
+    };
+
+    std::vector<std::string> make_strings(std::size_t count)
+    {
+        std::vector<std::string> strings;
+        for (std::size_t k = 0; k < count; ++k) {
+            strings.push_back("item " + std::to_string(k));
+        }
+        return strings;
+    }
+
+    /** Records the output passed on to the destination, and fails when a size limit is exceeded. */
+    class RecordingSink : public BufferedSink
+    {
+    public:
+        RecordingSink(std::size_t watermark, std::size_t limit = std::string::npos)
+            : BufferedSink(watermark)
+            , limit(limit)
+        {}
+
+        std::string output;
+        std::size_t largest_write = 0;
+
+    protected:
+        bool write(const char* data, std::size_t size) override
+        {
+            if (output.size() + size > limit) {
+                return false;
+            }
+            output.append(data, size);
+            largest_write = std::max(largest_write, size);
+            return true;
+        }
+
+    private:
+        std::size_t limit;
+    };
+
+    std::string read_file(std::FILE* file)
+    {
+        std::string str;
+        std::rewind(file);
+        char buffer[4096];
+        std::size_t count;
+        while ((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+            str.append(buffer, count);
+        }
+        return str;
+    }
+}
+
+TEST(Output, StringSink)
+{
+    std::string str = "prefix:";
+    {
+        StringSink sink(str);
+        EXPECT_TRUE(write_to_sink(std::vector<int>{ 1, 2, 3 }, sink));
+        EXPECT_EQ(str, "prefix:[1,2,3]");
+        EXPECT_TRUE(write_to_sink(std::string("next"), sink));
+    }
+    EXPECT_EQ(str, "prefix:[1,2,3]\"next\"");
+
+    // many small root values, each of which is flushed, grow the string in proportion to the output
+    std::string values;
+    {
+        StringSink sink(values);
+        for (int k = 0; k < 10000; ++k) {
+            ASSERT_TRUE(write_to_sink(k % 10, sink));
+        }
+    }
+    EXPECT_EQ(values.size(), 10000u);
+    EXPECT_EQ(values.substr(0, 12), "012345678901");
+    EXPECT_LE(values.capacity(), 4 * values.size());
+
+    // output that needs the string to grow several times
+    auto strings = test::make_strings(10000);
+    std::string json;
+    EXPECT_TRUE(write_to_string(strings, json));
+    EXPECT_EQ(json, write_to_string(strings));
+    EXPECT_EQ(json.substr(0, 18), "[\"item 0\",\"item 1\"");
+    EXPECT_EQ(json.back(), ']');
+
+    // writing replaces previous contents, and failure leaves the string empty
+    EXPECT_TRUE(write_to_string(std::vector<int>{ 4 }, json));
+    EXPECT_EQ(json, "[4]");
+    EXPECT_FALSE(write_to_string(std::vector<double>{ 1.0, std::numeric_limits<double>::quiet_NaN() }, json));
+    EXPECT_TRUE(json.empty());
+}
+
+TEST(Output, FixedBufferSink)
+{
+    char buffer[16];
+
+    FixedBufferSink sink(buffer, sizeof(buffer));
+    EXPECT_TRUE(write_to_sink(std::vector<int>{ 1, 2, 3 }, sink));
+    EXPECT_FALSE(sink.overflow());
+    EXPECT_EQ(std::string(sink.data(), sink.size()), "[1,2,3]");
+
+    FixedBufferSink small_sink(buffer, sizeof(buffer));
+    EXPECT_FALSE(write_to_sink(test::make_strings(100), small_sink));
+    EXPECT_TRUE(small_sink.overflow());
+    EXPECT_EQ(small_sink.size(), 0);
+}
+
+TEST(Output, MemorySink)
+{
+    MemorySink sink(16);
+    auto strings = test::make_strings(1000);
+    EXPECT_TRUE(write_to_sink(strings, sink));
+    EXPECT_EQ(sink.str(), write_to_string(strings));
+
+    // reuse allocated memory
+    const char* data = sink.data();
+    sink.clear();
+    EXPECT_EQ(sink.size(), 0);
+    EXPECT_TRUE(write_to_sink(std::vector<int>{ 1, 2, 3 }, sink));
+    EXPECT_EQ(sink.str(), "[1,2,3]");
+    EXPECT_EQ(sink.data(), data);
+
+    // a sink that has run out of memory is usable again once cleared
+    test::LimitedMemorySink limited_sink;
+    limited_sink.out_of_memory = true;
+    EXPECT_FALSE(write_to_sink(strings, limited_sink));
+    EXPECT_FALSE(limited_sink.good());
+    limited_sink.out_of_memory = false;
+    limited_sink.clear();
+    EXPECT_TRUE(limited_sink.good());
+    EXPECT_TRUE(write_to_sink(std::vector<int>{ 4, 5 }, limited_sink));
+    EXPECT_EQ(limited_sink.str(), "[4,5]");
+}
+
+TEST(Output, FileSink)
+{
+    auto strings = test::make_strings(10000);
+
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    {
+        FileSink sink(file, 64);
+        EXPECT_TRUE(write_to_sink(strings, sink));
+    }
+    EXPECT_EQ(test::read_file(file), write_to_string(strings));
+    std::fclose(file);
+
+#if defined(PERSISTENCE_FILE_DESCRIPTOR)
+    file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    {
+        FileDescriptorSink sink(fileno(file), 64);
+        EXPECT_TRUE(write_to_sink(strings, sink));
+    }
+    EXPECT_EQ(test::read_file(file), write_to_string(strings));
+    std::fclose(file);
+
+    FileDescriptorSink invalid_sink(-1, 64);
+    EXPECT_FALSE(write_to_sink(strings, invalid_sink));
+    EXPECT_FALSE(invalid_sink.good());
+#endif
+}
+
+TEST(Output, Watermark)
+{
+    std::vector<int> numbers;
+    for (int k = 0; k < 100000; ++k) {
+        numbers.push_back(k * 7919);
+    }
+    auto strings = test::make_strings(10000);
+
+    test::RecordingSink number_sink(1024);
+    EXPECT_TRUE(write_to_stream(numbers, number_sink));
+    EXPECT_EQ(number_sink.output, write_to_string(numbers));
+    EXPECT_LE(number_sink.largest_write, 1024);
+
+    test::RecordingSink string_sink(64);
+    EXPECT_TRUE(write_to_stream(strings, string_sink));
+    EXPECT_EQ(string_sink.output, write_to_string(strings));
+    EXPECT_LE(string_sink.largest_write, 64);
+
+    // a single value longer than the watermark
+    std::vector<std::string> long_strings = { std::string(1000, 'a'), "b", std::string(100, 'c') };
+    test::RecordingSink long_sink(16);
+    EXPECT_TRUE(write_to_stream(long_strings, long_sink));
+    EXPECT_EQ(long_sink.output, write_to_string(long_strings));
+
+    std::ostringstream stream;
+    write_to_stream(numbers, stream, 256);
+    EXPECT_EQ(stream.str(), write_to_string(numbers));
+}
+
+TEST(Output, StreamErrors)
+{
+    auto strings = test::make_strings(10000);
+
+    // destination fails part way, e.g. disk full
+    test::RecordingSink full_sink(256, 4096);
+    EXPECT_FALSE(write_to_stream(strings, full_sink));
+    EXPECT_FALSE(full_sink.good());
+    EXPECT_LE(full_sink.output.size(), 4096);
+
+    // destination fails when the last characters are passed on
+    const std::string json = write_to_string(strings);
+    test::RecordingSink last_sink(1 << 20, json.size() - 1);
+    EXPECT_FALSE(write_to_stream(strings, last_sink));
+
+    // value cannot be represented in JSON
+    test::RecordingSink nan_sink(256);
+    EXPECT_FALSE(write_to_stream(std::vector<double>{ 1.0, std::numeric_limits<double>::quiet_NaN() }, nan_sink));
+
+    std::ostringstream bad_stream;
+    bad_stream.setstate(std::ios::badbit);
+    EXPECT_THROW(write_to_stream(strings, bad_stream), JsonSerializationError);
+}
+
+TEST(Output, JsonSize)
+{
+    EXPECT_EQ(json_size(std::vector<int>{}), 2);
+    EXPECT_EQ(json_size(std::string("tab\tquote\"")), 14);
+
+    // output larger than the scratch buffer of the counting sink
+    auto strings = test::make_strings(10000);
+    EXPECT_EQ(json_size(strings), write_to_string(strings).size());
+    std::vector<std::string> long_strings = { std::string(5000, 'a'), std::string(3000, '\n') };
+    EXPECT_EQ(json_size(long_strings), write_to_string(long_strings).size());
+
+    std::size_t size = 0;
+    EXPECT_FALSE(json_size(std::vector<double>{ std::numeric_limits<double>::infinity() }, size));
+    EXPECT_THROW(json_size(std::vector<double>{ std::numeric_limits<double>::infinity() }), JsonSerializationError);
+}
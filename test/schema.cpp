@@ -18,6 +18,7 @@ TEST(Schema, Schema)
     EXPECT_EQ(schema_to_string<unsigned long long>(), "{\"type\":\"integer\",\"minimum\":" + std::to_string(std::numeric_limits<unsigned long long>::min()) + ",\"maximum\":" + std::to_string(std::numeric_limits<unsigned long long>::max()) + "}");
     EXPECT_EQ(schema_to_string<float>(), "{\"type\":\"number\"}");
     EXPECT_EQ(schema_to_string<double>(), "{\"type\":\"number\"}");
+    EXPECT_EQ(schema_to_string<persistence::decimal>(), "{\"type\":\"number\"}");
     EXPECT_EQ(schema_to_string<std::string>(), "{\"type\":\"string\"}");
     EXPECT_EQ(schema_to_string<timestamp>(), "{\"type\":\"string\",\"format\":\"date-time\"}");
 #if __cplusplus >= 202002L
@@ -40,6 +41,8 @@ TEST(Schema, Schema)
     EXPECT_EQ(schema_to_string<map_type>(), "{\"type\":\"object\",\"additionalProperties\":{\"type\":\"number\"}}");
     using unordered_map_type = std::unordered_map<std::string, double>;
     EXPECT_EQ(schema_to_string<unordered_map_type>(), "{\"type\":\"object\",\"additionalProperties\":{\"type\":\"number\"}}");
+    using integer_key_map_type = std::map<int, double>;
+    EXPECT_EQ(schema_to_string<integer_key_map_type>(), "{\"type\":\"object\",\"additionalProperties\":{\"type\":\"number\"}}");
 
     EXPECT_EQ(
         schema_to_string<TestValue>(),
@@ -49,6 +52,10 @@ TEST(Schema, Schema)
         schema_to_string<TestOptionalObjectMember>(),
         "{\"type\":\"object\",\"properties\":{\"optional_value\":" + schema_to_string<int>() + "},\"required\":[],\"additionalProperties\":false}"
     );
+    EXPECT_EQ(
+        schema_to_string<TestTimeEncodingSolo>(),
+        "{\"type\":\"object\",\"properties\":{\"time\":" + schema_to_string<long long>() + "},\"required\":[\"time\"],\"additionalProperties\":false}"
+    );
     EXPECT_EQ(
         schema_to_string<TestDerived>(),
         "{\"type\":\"object\",\"properties\":{\"value\":{\"type\":\"string\"},\"member\":{\"type\":\"string\"}},\"required\":[\"value\",\"member\"],\"additionalProperties\":false}"
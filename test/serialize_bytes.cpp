@@ -1,7 +1,9 @@
 #include <gtest/gtest.h>
 #include "persistence/write_bytes.hpp"
+#include "persistence/write_vector.hpp"
 #include "persistence/write.hpp"
 #include "persistence/serialize_bytes.hpp"
+#include "persistence/serialize_vector.hpp"
 #include "persistence/serialize.hpp"
 #include "test_serialize.hpp"
 
@@ -18,4 +20,17 @@ TEST(Serialization, Bytes)
     EXPECT_TRUE(test_serialize(make_byte_vector( 'f', 'o', 'o', 'b' ), "\"Zm9vYg==\""));
     EXPECT_TRUE(test_serialize(make_byte_vector( 'f', 'o', 'o', 'b', 'a' ), "\"Zm9vYmE=\""));
     EXPECT_TRUE(test_serialize(make_byte_vector( 'f', 'o', 'o', 'b', 'a', 'r' ), "\"Zm9vYmFy\""));
+
+    // bytes as items of a container
+    std::vector<persistence::byte_vector> items = { make_byte_vector( 'f', 'o' ), make_byte_vector(), make_byte_vector( 'b' ) };
+    EXPECT_TRUE(test_serialize(items, "[\"Zm8=\",\"\",\"Yg==\"]"));
+
+    // encoded in several chunks
+    persistence::byte_vector large;
+    for (std::size_t k = 0; k < 200000; ++k) {
+        large.push_back(std::byte(k * 7 % 256));
+    }
+    std::string encoded;
+    EXPECT_TRUE(persistence::base64_encode(large, encoded));
+    EXPECT_TRUE(test_serialize(large, "\"" + encoded + "\""));
 }
@@ -4,6 +4,7 @@
 #include "persistence/write_vector.hpp"
 #include "persistence/write_fundamental.hpp"
 #include "persistence/write_object.hpp"
+#include "persistence/write_pointer.hpp"
 #include "persistence/write_string.hpp"
 #include "persistence/write.hpp"
 #include "persistence/serialize_map.hpp"
@@ -11,6 +12,7 @@
 #include "persistence/serialize_vector.hpp"
 #include "persistence/serialize_fundamental.hpp"
 #include "persistence/serialize_object.hpp"
+#include "persistence/serialize_pointer.hpp"
 #include "persistence/serialize_string.hpp"
 #include "persistence/serialize.hpp"
 #include "example_classes.hpp"
@@ -38,6 +40,42 @@ TEST(Serialization, Vector)
 
     std::vector<std::string> val = { "one", "two" };
     EXPECT_TRUE(test_serialize(val, "[\"one\",\"two\"]"));
+
+    EXPECT_TRUE(test_serialize(std::vector<unsigned char>{0, 255}, "[0,255]"));
+    EXPECT_TRUE(test_serialize(std::vector<long long>{std::numeric_limits<long long>::min(), -1, 0, std::numeric_limits<long long>::max()}, "[-9223372036854775808,-1,0,9223372036854775807]"));
+    EXPECT_TRUE(test_serialize(std::vector<unsigned long long>{std::numeric_limits<unsigned long long>::max()}, "[18446744073709551615]"));
+    EXPECT_TRUE(test_serialize(std::vector<double>{0.1, -2.0, 1e300}, "[0.1,-2.0,1e300]"));
+
+    static_assert(persistence::is_bulk_number_v<char>);
+    static_assert(persistence::is_bulk_number_v<unsigned char>);
+    static_assert(!persistence::is_bulk_number_v<bool>);
+    static_assert(!persistence::is_bulk_number_v<wchar_t>);
+    static_assert(!persistence::is_bulk_number_v<char16_t>);
+    static_assert(!persistence::is_bulk_number_v<char32_t>);
+    static_assert(!persistence::is_bulk_number_v<long double>);
+
+    // item counts at and across the chunk boundary (1024 items) of the bulk number writer
+    for (int count : { 1023, 1024, 1025, 2500 }) {
+        std::vector<int> int_items;
+        std::vector<double> double_items;
+        std::string int_json = "[";
+        std::string double_json = "[";
+        for (int k = 0; k < count; ++k) {
+            int_items.push_back(k * 1001 - 500000);
+            double_items.push_back(k + 0.25);
+            if (k > 0) {
+                int_json += ",";
+                double_json += ",";
+            }
+            int_json += std::to_string(k * 1001 - 500000);
+            double_json += std::to_string(k) + ".25";
+        }
+        EXPECT_TRUE(test_serialize(int_items, int_json + "]"));
+        EXPECT_TRUE(test_serialize(double_items, double_json + "]"));
+    }
+
+    std::string str;
+    EXPECT_FALSE(persistence::write_to_string(std::vector<double>{1.0, std::numeric_limits<double>::quiet_NaN()}, str));
 }
 
 TEST(Serialization, Set)
@@ -105,3 +143,57 @@ TEST(Serialization, UnorderedMap)
     obj_map.insert(std::make_pair("key1", TestValue("a")));
     EXPECT_TRUE(test_serialize(obj_map, "{\"key1\":{\"value\":\"a\"}}"));
 }
+
+TEST(Serialization, IntegerKeyMap)
+{
+    EXPECT_TRUE(test_serialize(std::map<int, int>(), "{}"));
+
+    std::map<int, std::string> int_map = {
+        { -2147483647 - 1, "min" }, { -1, "a" }, { 0, "b" }, { 23, "c" }, { 2147483647, "max" }
+    };
+    EXPECT_TRUE(test_serialize(int_map, "{\"-2147483648\":\"min\",\"-1\":\"a\",\"0\":\"b\",\"23\":\"c\",\"2147483647\":\"max\"}"));
+
+    std::map<std::uint64_t, std::vector<int>> vec_map = {
+        { 1, {1, 2} }, { 18446744073709551615u, {4, 8} }
+    };
+    EXPECT_TRUE(test_serialize(vec_map, "{\"1\":[1,2],\"18446744073709551615\":[4,8]}"));
+
+    std::unordered_map<short, TestValue> obj_map;
+    obj_map.insert(std::make_pair(short(-5), TestValue("a")));
+    EXPECT_TRUE(test_serialize(obj_map, "{\"-5\":{\"value\":\"a\"}}"));
+
+    // back-references to a value under an integer key outlive the formatted key
+    auto value = std::make_shared<TestValue>("x");
+    std::map<int, std::shared_ptr<TestValue>> ptr_map = {
+        { 1, value }, { 22, value }
+    };
+    EXPECT_TRUE(test_serialize(ptr_map, "{\"1\":{\"value\":\"x\"},\"22\":{\"$ref\":\"/1\"}}"));
+}
+
+TEST(Serialization, FlatMap)
+{
+    EXPECT_TRUE(test_serialize(persistence::string_flat_map<int>(), "{}"));
+
+    // items are kept sorted by key
+    persistence::string_flat_map<int> int_map = {
+        { "key3", 3 }, { "key1", 1 }, { "key2", 2 }
+    };
+    EXPECT_TRUE(test_serialize(int_map, "{\"key1\":1,\"key2\":2,\"key3\":3}"));
+
+    persistence::flat_map<int, std::string> integer_key_map = {
+        { 23, "c" }, { -1, "a" }, { 0, "b" }
+    };
+    EXPECT_TRUE(test_serialize(integer_key_map, "{\"-1\":\"a\",\"0\":\"b\",\"23\":\"c\"}"));
+
+    auto value = std::make_shared<TestValue>("x");
+    persistence::flat_map<int, std::shared_ptr<TestValue>> ptr_map = {
+        { 22, value }, { 1, value }
+    };
+    EXPECT_TRUE(test_serialize(ptr_map, "{\"1\":{\"value\":\"x\"},\"22\":{\"$ref\":\"/1\"}}"));
+
+    // items keep the order of insertion
+    persistence::string_dict<int> dict = {
+        { "key3", 3 }, { "key1", 1 }
+    };
+    EXPECT_TRUE(test_serialize(dict, "{\"key3\":3,\"key1\":1}"));
+}
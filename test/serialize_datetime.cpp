@@ -1,12 +1,15 @@
 #include <gtest/gtest.h>
 #include "persistence/write_datetime.hpp"
 #include "persistence/serialize_datetime.hpp"
+#include "persistence/write_object.hpp"
+#include "persistence/serialize_object.hpp"
 #if __cplusplus >= 202002L
 #include "persistence/write_date.hpp"
 #include "persistence/serialize_date.hpp"
 #endif
 #include "persistence/write.hpp"
 #include "persistence/serialize.hpp"
+#include "example_classes.hpp"
 #include "test_serialize.hpp"
 
 using namespace test;
@@ -17,6 +20,13 @@ TEST(Serialization, DateTimeTypes)
 
     EXPECT_TRUE(test_serialize(make_datetime(1982, 10, 23, 1, 20, 40), "\"1982-10-23T01:20:40Z\""));
     EXPECT_TRUE(test_serialize(make_datetime(2022, 2, 1, 23, 2, 1), "\"2022-02-01T23:02:01Z\""));
+    EXPECT_TRUE(test_serialize(make_datetime(1900, 3, 1, 12, 0, 0), "\"1900-03-01T12:00:00Z\""));
+    EXPECT_TRUE(test_serialize(make_datetime(2199, 12, 31, 23, 59, 59), "\"2199-12-31T23:59:59Z\""));
+
+    // fraction of a second in milliseconds, microseconds or nanoseconds
+    EXPECT_TRUE(test_serialize(make_datetime(2022, 2, 1, 23, 2, 1, 250000000), "\"2022-02-01T23:02:01.250Z\""));
+    EXPECT_TRUE(test_serialize(make_datetime(2022, 2, 1, 23, 2, 1, 250000), "\"2022-02-01T23:02:01.000250Z\""));
+    EXPECT_TRUE(test_serialize(make_datetime(2022, 2, 1, 23, 2, 1, 123456789), "\"2022-02-01T23:02:01.123456789Z\""));
 
 #if __cplusplus >= 202002L
     using namespace std::chrono;
@@ -25,3 +35,22 @@ TEST(Serialization, DateTimeTypes)
     EXPECT_TRUE(test_serialize(year_month_day(2022y, February, 1d), "\"2022-02-01\""));
 #endif
 }
+
+TEST(Serialization, TimeEncoding)
+{
+    using persistence::make_datetime;
+
+    TestTimeEncoding obj;
+    obj.created = make_datetime(2022, 2, 1, 23, 2, 1, 250000000);
+    obj.expires = make_datetime(1969, 12, 31, 23, 59, 59, 999999999);
+    obj.logged = make_datetime(2022, 2, 1, 23, 2, 1);
+    EXPECT_TRUE(test_serialize(obj, "{\"created\":1643756521250,\"expires\":-1,\"logged\":\"2022-02-01T23:02:01Z\"}"));
+
+    // whole units round towards the past
+    obj.updated = make_datetime(1969, 12, 31, 23, 59, 59, 500000000);
+    EXPECT_TRUE(test_serialize(obj, "{\"created\":1643756521250,\"updated\":-1,\"expires\":-1,\"logged\":\"2022-02-01T23:02:01Z\"}"));
+
+    TestTimeEncodingSolo solo;
+    solo.time = make_datetime(1970, 1, 1, 0, 0, 1, 2000);
+    EXPECT_TRUE(test_serialize(solo, "{\"time\":1000002}"));
+}
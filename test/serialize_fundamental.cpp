@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
+#include "persistence/write_decimal.hpp"
 #include "persistence/write_fundamental.hpp"
 #include "persistence/write.hpp"
+#include "persistence/serialize_decimal.hpp"
 #include "persistence/serialize_fundamental.hpp"
 #include "persistence/serialize.hpp"
 #include "test_serialize.hpp"
@@ -74,4 +76,42 @@ TEST(Serialization, NumericTypes)
 
     EXPECT_TRUE(test_serialize_float_type<float>());
     EXPECT_TRUE(test_serialize_float_type<double>());
+
+    // shortest representation in the precision of the type
+    EXPECT_TRUE(test_serialize(0.1f, "0.1"));
+    EXPECT_TRUE(test_serialize(-0.3f, "-0.3"));
+    EXPECT_TRUE(test_serialize(1e-7f, "1e-7"));
+    EXPECT_TRUE(test_serialize(std::numeric_limits<float>::max(), "3.4028235e38"));
+    EXPECT_TRUE(test_serialize(0.1, "0.1"));
+    EXPECT_TRUE(test_serialize(1e-7, "1e-7"));
+    EXPECT_TRUE(test_serialize(1e21, "1e21"));
+    EXPECT_TRUE(test_serialize(std::numeric_limits<double>::max(), "1.7976931348623157e308"));
+}
+
+TEST(Serialization, Decimal)
+{
+    using persistence::decimal;
+    using persistence::write_to_string;
+
+    EXPECT_TRUE(test_serialize(decimal(0), "0"));
+    EXPECT_TRUE(test_serialize(decimal(-42), "-42"));
+    EXPECT_TRUE(test_serialize(decimal(1999, 2), "19.99"));
+    EXPECT_TRUE(test_serialize(decimal(-5, 3), "-0.005"));
+    EXPECT_TRUE(test_serialize(decimal(std::numeric_limits<std::int64_t>::max()), "9223372036854775807"));
+    EXPECT_TRUE(test_serialize(decimal(std::numeric_limits<std::int64_t>::min()), "-9223372036854775808"));
+
+    // trailing zeros are kept when writing, but not in the JSON DOM
+    EXPECT_EQ(write_to_string(decimal(1990, 2)), "19.90");
+    EXPECT_EQ(write_to_string(decimal(0, 2)), "0.00");
+    EXPECT_EQ(write_to_string(decimal(100, 2)), "1.00");
+    EXPECT_EQ(write_to_string(decimal(1234567890123456789, 18)), "1.234567890123456789");
+    EXPECT_EQ(write_to_string(decimal(1, 7)), "0.0000001");
+    EXPECT_EQ(write_to_string(decimal(1, 8)), "1e-8");
+    EXPECT_EQ(write_to_string(decimal(-25, 12)), "-25e-12");
+    EXPECT_EQ(write_to_string(decimal(15, -3)), "15e3");
+
+    // the JSON DOM keeps up to 15 significant digits exactly, writing keeps all digits
+    EXPECT_TRUE(test_serialize(decimal(123456789012345, 3), "123456789012.345"));
+    EXPECT_EQ(write_to_string(decimal(12345678901234567, 3)), "12345678901234.567");
+    EXPECT_EQ(persistence::document_to_string(persistence::serialize_to_document(decimal(12345678901234567, 3))), "12345678901234.566");
 }
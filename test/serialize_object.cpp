@@ -79,6 +79,40 @@ TEST(Serialization, Optional)
     EXPECT_TRUE(test_serialize(opt2, "{\"optional_value\":42}"));
 }
 
+TEST(Serialization, EscapedMemberNames)
+{
+    TestEscapedMemberNames obj;
+    obj.quote = 1;
+    obj.control = 2;
+    EXPECT_TRUE(test_serialize(obj, "{\"\\\"quote\\\" \\\\ back\":1,\"tab\\tline\\n\\u0001\":2}"));
+
+    obj.first = 0;
+    EXPECT_TRUE(test_serialize(obj, "{\"first\":0,\"\\\"quote\\\" \\\\ back\":1,\"tab\\tline\\n\\u0001\":2}"));
+}
+
+TEST(Serialization, NumberFormat)
+{
+    TestNumberFormat obj;
+    obj.price = 19.989999999;
+    obj.reading = 1234.5678f;
+    obj.exact = 0.125;
+    EXPECT_TRUE(test_serialize(obj, "{\"price\":19.99,\"reading\":1235.0,\"exact\":0.125}"));
+
+    obj.price = 2.675;
+    obj.reading = 0.000123456f;
+    obj.discount = 0.04;
+    EXPECT_TRUE(test_serialize(obj, "{\"price\":2.68,\"reading\":0.0001235,\"discount\":0.0,\"exact\":0.125}"));
+
+    obj.price = -0.001;
+    obj.reading = 99999.0f;
+    obj.discount = 0.05;
+    EXPECT_TRUE(test_serialize(obj, "{\"price\":0.0,\"reading\":100000.0,\"discount\":0.1,\"exact\":0.125}"));
+
+    obj.price = 1e300;
+    obj.reading = 1.5e30f;
+    EXPECT_TRUE(test_serialize(obj, "{\"price\":1e300,\"reading\":1.5e30,\"discount\":0.1,\"exact\":0.125}"));
+}
+
 TEST(Serialization, BackReferenceArray)
 {
     auto val = std::make_shared<TestValue>("one");
@@ -20,6 +20,7 @@ TEST(Serialization, Array)
 {
     EXPECT_TRUE(test_serialize(std::array<int, 0>(), "[]"));
     EXPECT_TRUE(test_serialize(std::array<int, 3>{1, 2, 3}, "[1,2,3]"));
+    EXPECT_TRUE(test_serialize(std::array<float, 3>{0.1f, -1.5f, 3.0f}, "[0.1,-1.5,3.0]"));
 
     std::array<TestValue, 3> obj = { TestValue("a"), TestValue("b"), TestValue("c") };
     EXPECT_TRUE(test_serialize(obj, "[{\"value\":\"a\"},{\"value\":\"b\"},{\"value\":\"c\"}]"));
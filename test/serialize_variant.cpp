@@ -10,6 +10,7 @@
 #include "persistence/serialize_string.hpp"
 #include "persistence/serialize.hpp"
 #include "example_classes.hpp"
+#include "example_variant_traits.hpp"
 #include "test_serialize.hpp"
 
 using namespace test;
@@ -27,4 +28,9 @@ TEST(Serialization, Variant)
     using complex_variant_type = std::variant<TestValue, TestNonCopyable>;
     EXPECT_TRUE(test_serialize(complex_variant_type(TestValue("string")), "{\"value\":\"string\"}"));
     EXPECT_TRUE(test_serialize(complex_variant_type(TestNonCopyable("string")), "{\"member\":{\"value\":\"string\"}}"));
+
+    using tagged_variant_type = std::variant<TestCircle, TestRectangle, TestLabel>;
+    EXPECT_TRUE(test_serialize(tagged_variant_type(TestCircle(1.5)), "{\"type\":\"circle\",\"radius\":1.5}"));
+    EXPECT_TRUE(test_serialize(tagged_variant_type(TestRectangle(2.0, 0.5)), "{\"type\":\"rectangle\",\"width\":2.0,\"height\":0.5}"));
+    EXPECT_TRUE(test_serialize(tagged_variant_type(TestLabel("text")), "{\"type\":\"label\",\"text\":\"text\"}"));
 }
@@ -3,6 +3,7 @@
 #include "persistence/parse.hpp"
 #include "persistence/deserialize.hpp"
 #include "persistence/utility.hpp"
+#include <sstream>
 
 namespace test
 {
@@ -66,6 +67,24 @@ namespace test
             return testing::AssertionFailure() << "parse from JSON failed";
         }
 
+        // a tiny buffer makes tokens straddle buffer boundaries
+        std::istringstream stream(str);
+        InputStreamSource source(stream, 3);
+        T source_obj;
+        result = parse(source, source_obj);
+        if (result) {
+            if constexpr (is_pointer_like_v<T>) {
+                EXPECT_EQ(*source_obj, *ref_obj);
+                result = (*source_obj == *ref_obj);
+            } else {
+                EXPECT_EQ(source_obj, ref_obj);
+                result = (source_obj == ref_obj);
+            }
+        }
+        if (!result) {
+            return testing::AssertionFailure() << "parse from input source failed";
+        }
+
         return testing::AssertionSuccess();
     }
 
@@ -98,6 +117,12 @@ namespace test
         }
         EXPECT_THROW(parse<T>(str), JsonParseError);
 
+        std::istringstream stream(str);
+        InputStreamSource source(stream, 3);
+        if (parse<T>(source, obj)) {
+            return testing::AssertionFailure() << "parsing from input source succeeded unexpectedly";
+        }
+
         return testing::AssertionSuccess();
     }
 
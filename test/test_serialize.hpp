@@ -41,6 +41,22 @@ namespace test
             return testing::AssertionFailure() << "writing to JSON failed";
         }
 
+        std::vector<char> buffer(ref_json.size());
+        FixedBufferSink exact_sink(buffer.data(), buffer.size());
+        result = write_to_sink(obj, exact_sink);
+        if (result) {
+            EXPECT_EQ(std::string(exact_sink.data(), exact_sink.size()), ref_json);
+            result = (std::string(exact_sink.data(), exact_sink.size()) == ref_json);
+        }
+        if (!result) {
+            return testing::AssertionFailure() << "writing to fixed-size buffer failed";
+        }
+        EXPECT_EQ(json_size(obj), ref_json.size());
+
+        FixedBufferSink short_sink(buffer.data(), buffer.size() - 1);
+        EXPECT_FALSE(write_to_sink(obj, short_sink));
+        EXPECT_TRUE(short_sink.overflow());
+
         return testing::AssertionSuccess();
     }
 